@@ -61,7 +61,7 @@ int main(){
     Shader ourShader("src/shaders/10shader.vs", "src/shaders/10shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
 
     //vertex데이터 작성
@@ -126,9 +126,9 @@ int main(){
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     //vertex 위치 attribute
@@ -144,7 +144,7 @@ int main(){
     unsigned int texture1, texture2;
     //texture1
     glGenTextures(1, &texture1);
-    glBindTexture(GL_TEXTURE_2D, texture1);
+    GLState::BindTexture(GL_TEXTURE_2D, texture1);
     //wrapping, filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -165,7 +165,7 @@ int main(){
     stbi_image_free(data);
     //texture2
     glGenTextures(1, &texture2);
-    glBindTexture(GL_TEXTURE_2D, texture2);
+    GLState::BindTexture(GL_TEXTURE_2D, texture2);
     //wrapping, filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -207,10 +207,10 @@ int main(){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         //texture 바인딩
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture1);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, texture2);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, texture1);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, texture2);
 
         //Shader 활성화
         ourShader.use();
@@ -228,7 +228,7 @@ int main(){
         ourShader.setMat4("projection", projection);
 
         //오브젝트 변환 랜더링
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
         for(unsigned int i = 0; i < 10; i++)
         {
             glm::mat4 model = glm::mat4(1.0f);
@@ -246,8 +246,8 @@ int main(){
     }
 
     //데이터 삭제
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    GLState::DeleteVertexArrays(1, &VAO);
+    GLState::DeleteBuffers(1, &VBO);
     
     glfwTerminate();
     return 0;
@@ -67,7 +67,7 @@ int main(){
     Shader ourShader("src/shaders/11shader.vs", "src/shaders/11shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
 
     //vertex데이터 작성
@@ -129,9 +129,9 @@ int main(){
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     //vertex 위치 attribute
@@ -147,7 +147,7 @@ int main(){
     unsigned int texture1, texture2, texture3;
     //texture1
     glGenTextures(1, &texture1);
-    glBindTexture(GL_TEXTURE_2D, texture1);
+    GLState::BindTexture(GL_TEXTURE_2D, texture1);
     //wrapping, filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -169,7 +169,7 @@ int main(){
 
     //texture2
     glGenTextures(1, &texture2); 
-    glBindTexture(GL_TEXTURE_2D, texture2);
+    GLState::BindTexture(GL_TEXTURE_2D, texture2);
     //wrapping, filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -188,7 +188,7 @@ int main(){
     stbi_image_free(data);
     //texture3
     glGenTextures(1, &texture3);
-    glBindTexture(GL_TEXTURE_2D, texture3);
+    GLState::BindTexture(GL_TEXTURE_2D, texture3);
     //wrapping, filtering
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -232,12 +232,12 @@ int main(){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         //texture 바인딩
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture1);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, texture2);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, texture3);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, texture1);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, texture2);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, texture3);
 
         //Shader 활성화
         ourShader.use();
@@ -284,7 +284,7 @@ int main(){
         ourShader.setMat4("view", view);
         ourShader.setMat4("projection", projection);
         //큐브 랜더링
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
 
         //바닥
@@ -301,8 +301,8 @@ int main(){
     }
 
     //데이터 삭제
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    GLState::DeleteVertexArrays(1, &VAO);
+    GLState::DeleteBuffers(1, &VBO);
     
     glfwTerminate();
     return 0;
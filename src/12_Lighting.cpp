@@ -12,6 +12,7 @@
 
 #include "shader.h"
 #include "camera.h"
+#include "texture_cache.h"
 
 using namespace std;
 
@@ -20,7 +21,7 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void processInput(GLFWwindow *window);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
-unsigned int loadTexture(char const * path);
+unsigned int loadTexture(char const * path, bool async = false);
 
 //셋팅
 const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
@@ -69,7 +70,7 @@ int main(){
     Shader lampShader("src/shaders/12light_shader.vs", "src/shaders/12light_shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
     //vertex데이터 작성
     float vertices[] = {
@@ -142,10 +143,10 @@ int main(){
     glGenVertexArrays(1, &cubeVAO);
     glGenBuffers(1, &VBO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
 
     //오브젝트 vertex 위치 attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
@@ -160,17 +161,17 @@ int main(){
     //광원 오브젝트 VAO
     unsigned int lightVAO;
     glGenVertexArrays(1, &lightVAO);
-    glBindVertexArray(lightVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindVertexArray(lightVAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
 
     //광원 vertex위치 attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     
     //텍스처
-    unsigned int diffuseMap = loadTexture("textures/container2.png");
-    unsigned int specularMap = loadTexture("textures/container2_specular.png");
-    unsigned int emissionMap = loadTexture("textures/matrix.jpg");
+    unsigned int diffuseMap = loadTexture("textures/container2.png", true);
+    unsigned int specularMap = loadTexture("textures/container2_specular.png", true);
+    unsigned int emissionMap = loadTexture("textures/matrix.jpg", true);
     
     lightingShader.use();
     lightingShader.setInt("material.diffuse", 0);
@@ -185,6 +186,9 @@ int main(){
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        //비동기 텍스처 업로드
+        SharedTextureLoader().Update();
+
         //키 입력
         processInput(window);
         //spotlight 켜고 끄기
@@ -279,15 +283,15 @@ int main(){
         glm::mat4 model = glm::mat4(1.0f);
 
         //텍스처
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, diffuseMap);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, specularMap);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, emissionMap);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, diffuseMap);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, specularMap);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, emissionMap);
 
         //오브젝트 여러개 랜더링(위치 vertex값들을 사용)
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         for (unsigned int i = 0; i < 10; i++)
         {
             model = glm::mat4(1.0f);
@@ -308,7 +312,7 @@ int main(){
         //Projection
         lampShader.setMat4("projection", projection);
         //광원 랜더링
-        glBindVertexArray(lightVAO); 
+        GLState::BindVertexArray(lightVAO); 
         for(unsigned int i = 0 ; i < 4 ; i ++)
         {
             model = glm::mat4(1.0f);
@@ -323,9 +327,9 @@ int main(){
     }
 
     //데이터 삭제
-    glDeleteVertexArrays(1, &cubeVAO);
-    glDeleteVertexArrays(1, &lightVAO);
-    glDeleteBuffers(1, &VBO);
+    GLState::DeleteVertexArrays(1, &cubeVAO);
+    GLState::DeleteVertexArrays(1, &lightVAO);
+    GLState::DeleteBuffers(1, &VBO);
     
     glfwTerminate();
     return 0;
@@ -379,40 +383,8 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
-unsigned int loadTexture(char const * path)
+//텍스쳐 불러오기 (TextureCache 공유), async면 placeholder ID를 바로 반환하고 디코딩은 worker thread에서
+unsigned int loadTexture(char const * path, bool async)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path, async ? TEXTURE_ASYNC : 0).ID;
 }
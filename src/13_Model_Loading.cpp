@@ -62,18 +62,25 @@ int main(){
         return -1;
     }
     //Shader 작성
-    Shader ourShader("src/shaders/13shader.vs", "src/shaders/13shader.fs");
+    Shader ourShader("src/shaders/13shader_compact.vs", "src/shaders/13shader.fs");
 
     stbi_set_flip_vertically_on_load(true);
 
     //Model 불러오기
-    Model ourModel("resources/object/backpack/backpack.obj");
+    Model ourModel("resources/object/backpack/backpack.obj", false, MODEL_COMPRESS_TEXTURES | MODEL_COMPRESS_VERTICES | MODEL_BUILD_MESHLETS);
+    //meshlet culling 통계 (1초마다 출력)
+    MeshletCullStats cullStats;
+    unsigned int cullFrames = 0;
+    float cullReportTime = 0.0f;
+    //draw 제출 CPU 시간 (material 바인딩 포함)
+    double drawMs = 0.0;
+    TextureCache::PrintStats();
 
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
     //렌더링 루프
     while(!glfwWindowShouldClose(window))
@@ -83,6 +90,9 @@ int main(){
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
+        //비동기 텍스처 업로드 (프레임당 2ms)
+        SharedTextureLoader().Update(2.0);
+
         //키 입력
         processInput(window);
 
@@ -106,9 +116,23 @@ int main(){
         model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.0f));
         model = glm::scale(model, glm::vec3(1.0f, 1.0f, 1.0f));
 
-        //모델 렌더링
+        //모델 렌더링 (보이는 meshlet만)
         ourShader.setMat4("model", model);
-        ourModel.Draw(ourShader);
+        double drawStart = glfwGetTime();
+        ourModel.DrawCulled(ourShader, model, Frustum(projection * view), camera.Position, cullStats);
+        drawMs += (glfwGetTime() - drawStart) * 1000.0;
+        cullFrames++;
+        if (currentFrame - cullReportTime >= 1.0f)
+        {
+            cullStats.Print("backpack", cullFrames);
+            unsigned int draws = cullFrames * (unsigned int)ourModel.meshes.size();
+            cout << "MODEL::DRAW:: backpack " << draws / (currentFrame - cullReportTime) << " mesh draws/s, submit "
+                 << drawMs * 1000.0 / max(draws, 1u) << " us/draw" << endl;
+            drawMs = 0.0;
+            cullStats.Reset();
+            cullFrames = 0;
+            cullReportTime = currentFrame;
+        }
 
 
         glfwSwapBuffers(window);
@@ -13,6 +13,7 @@
 
 #include "shader.h"
 #include "camera.h"
+#include "texture_cache.h"
 
 using namespace std;
 
@@ -69,7 +70,7 @@ int main(){
     Shader ourShader("src/shaders/14_3shader.vs", "src/shaders/14_3shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
     //vertex데이터 작성
     float vertices[] = {
@@ -142,10 +143,10 @@ int main(){
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
 
     //오브젝트 vertex 위치 attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
@@ -196,18 +197,18 @@ int main(){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         //texture 바인딩
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, planeTexture);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, cubeTexture);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, grassTexture);
-        glActiveTexture(GL_TEXTURE3);
-        glBindTexture(GL_TEXTURE_2D, windowTexture);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, planeTexture);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, cubeTexture);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, grassTexture);
+        GLState::ActiveTexture(GL_TEXTURE3);
+        GLState::BindTexture(GL_TEXTURE_2D, windowTexture);
 
         //블랜딩 활성화
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::Enable(GL_BLEND);
+        GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         //shader 활성화
         ourShader.use();
@@ -223,7 +224,7 @@ int main(){
         ourShader.setMat4("projection", projection);
         //큐브 그리기
         ourShader.setInt("textureType", 1);
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
         for (unsigned int i = 0; i < 2; i++)
         {
             model = glm::mat4(1.0f);
@@ -260,8 +261,8 @@ int main(){
     }
 
     //데이터 삭제
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    GLState::DeleteVertexArrays(1, &VAO);
+    GLState::DeleteBuffers(1, &VBO);
 
     glfwTerminate();
     return 0;
@@ -315,40 +316,8 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path).ID;
 }
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <cfloat>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -64,11 +65,11 @@ int main(){
         return -1;
     }
     //Shader 작성
-    Shader shader("src/shaders/14_8shader.vs", "src/shaders/14_8shader.fs");
-    Shader rockShader("src/shaders/14_8rock_Shader.vs", "src/shaders/14_8rock_Shader.fs");
+    Shader shader("src/shaders/14_8shader_compact.vs", "src/shaders/14_8shader.fs");
+    Shader rockShader("src/shaders/14_8rock_Shader_compact.vs", "src/shaders/14_8rock_Shader.fs");
     
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
     /*
     //사각형의 위치 배열 생성
@@ -88,9 +89,9 @@ int main(){
     //인스턴스 VBO
     unsigned int instanceVBO;
     glGenBuffers(1, &instanceVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2) * 100, &translations[0], GL_STATIC_DRAW);
-    glBindBuffer(GL_ARRAY_BUFFER, 0); 
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0); 
 
     
     //vertex데이터 작성
@@ -108,8 +109,8 @@ int main(){
     unsigned int VBO, VAO;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindVertexArray(VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
     //오브젝트 vertex 위치 attribute
     glEnableVertexAttribArray(0);
@@ -119,14 +120,16 @@ int main(){
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
     //인스턴스 위치 attrib
     glEnableVertexAttribArray(2);
-    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);	
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);	
     glVertexAttribDivisor(2, 1);  
     */
     
-    Model planet("resources/object/planet/planet.obj");
-    Model rock("resources/object/rock/rock.obj");
+    //압축 vertex 사용 (20 byte/vertex, 16bit index), rock은 LOD 생성
+    Model planet("resources/object/planet/planet.obj", false, MODEL_COMPRESS_VERTICES);
+    Model rock("resources/object/rock/rock.obj", false, MODEL_COMPRESS_VERTICES | MODEL_GENERATE_LODS);
+    TextureCache::PrintStats();
 
     //model
     unsigned int amount = 100000;
@@ -160,32 +163,46 @@ int main(){
         modelMatrices[i] = model;
     }
 
+    //LOD 선택용 instance 중심과 scale
+    vector<glm::vec3> rockCenters(amount);
+    vector<float> rockScales(amount);
+    for (unsigned int i = 0; i < amount; i++)
+    {
+        rockCenters[i] = glm::vec3(modelMatrices[i] * glm::vec4(rock.boundsCenter, 1.0f));
+        rockScales[i] = glm::length(glm::vec3(modelMatrices[i][0]));
+    }
+
+    //instance buffer는 LOD별로 정렬해서 채움 (LOD마다 연속 구간)
     unsigned int buffer;
     glGenBuffers(1, &buffer);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer);
-    glBufferData(GL_ARRAY_BUFFER, amount * sizeof(glm::mat4), &modelMatrices[0], GL_STATIC_DRAW);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, amount * sizeof(glm::mat4), &modelMatrices[0], GL_DYNAMIC_DRAW);
     
     for(unsigned int i = 0; i < rock.meshes.size(); i++)
     {
         unsigned int VAO = rock.meshes[i].VAO;
-        glBindVertexArray(VAO);
-        // set attribute pointers for matrix (4 times vec4)
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)0);
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4)));
-        glEnableVertexAttribArray(5);
-        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(2 * sizeof(glm::vec4)));
-        glEnableVertexAttribArray(6);
-        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(3 * sizeof(glm::vec4)));
-
-        glVertexAttribDivisor(3, 1);
-        glVertexAttribDivisor(4, 1);
-        glVertexAttribDivisor(5, 1);
-        glVertexAttribDivisor(6, 1);
-
-        glBindVertexArray(0);
+        GLState::BindVertexArray(VAO);
+        // set attribute pointers for matrix (4 times vec4), offset은 그릴 때 LOD 구간마다 다시 지정
+        for (unsigned int k = 0; k < 4; k++)
+        {
+            glEnableVertexAttribArray(3 + k);
+            glVertexAttribPointer(3 + k, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(k * sizeof(glm::vec4)));
+            glVertexAttribDivisor(3 + k, 1);
+        }
+        GLState::BindVertexArray(0);
     }  
+
+    //LOD bucket
+    unsigned int lodCount = rock.LodCount() ? rock.LodCount() : 1;
+    vector<unsigned int> lodFirst(lodCount + 1, 0);
+    vector<unsigned int> instanceLods(amount);
+    vector<glm::mat4> bucketed(amount);
+    glm::vec3 bucketPosition(FLT_MAX);
+    float bucketZoom = 0.0f;
+    //삼각형 수 보고
+    double triangleReportTime = glfwGetTime();
+    unsigned long long trianglesSubmitted = 0;
+    unsigned int framesCounted = 0;
  
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -209,15 +226,34 @@ int main(){
         /*
         //오브젝트 렌더링
         shader.use();
-        glBindVertexArray(VAO);
+        GLState::BindVertexArray(VAO);
         glDrawArraysInstanced(GL_TRIANGLES, 0, 6, 100);
-        glBindVertexArray(0);
         */
 
+        //카메라가 움직였을 때만 rock LOD 다시 나누기 (counting sort)
+        if (camera.Position != bucketPosition || camera.Zoom != bucketZoom)
+        {
+            bucketPosition = camera.Position;
+            bucketZoom = camera.Zoom;
+            vector<unsigned int> counts(lodCount, 0);
+            for (unsigned int i = 0; i < amount; i++)
+            {
+                instanceLods[i] = min(rock.SelectLod(camera, rockCenters[i], rockScales[i], (float)SCR_HEIGHT), lodCount - 1);
+                counts[instanceLods[i]]++;
+            }
+            for (unsigned int lod = 0; lod < lodCount; lod++)
+                lodFirst[lod + 1] = lodFirst[lod] + counts[lod];
+            vector<unsigned int> fill(lodFirst.begin(), lodFirst.end() - 1);
+            for (unsigned int i = 0; i < amount; i++)
+                bucketed[fill[instanceLods[i]]++] = modelMatrices[i];
+            GLState::BindBuffer(GL_ARRAY_BUFFER, buffer);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, amount * sizeof(glm::mat4), bucketed.data());
+        }
+
         //model 렌더링
         shader.use();
-        //projection, view
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 1.0f, 100.0f);
+        //projection, view (LOD 선택과 같은 FOV)
+        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 1.0f, 100.0f);
         glm::mat4 view = camera.GetViewMatrix();;
         shader.setMat4("projection", projection);
         shader.setMat4("view", view);
@@ -227,19 +263,50 @@ int main(){
         model = glm::scale(model, glm::vec3(4.0f, 4.0f, 4.0f));
         shader.setMat4("model", model);
         planet.Draw(shader);
+        unsigned long long triangles = planet.Triangles(0);
         // draw rock
         rockShader.use();
         //projection, view
         rockShader.setMat4("projection", projection);
         rockShader.setMat4("view", view);
         rockShader.setInt("texture_diffuse1", 0);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, rock.textures_loaded[0].id); // note: we also made the textures_loaded vector public (instead of private) from the model class.
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, rock.textures_loaded[0].id); // note: we also made the textures_loaded vector public (instead of private) from the model class.
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffer);
         for (unsigned int i = 0; i < rock.meshes.size(); i++)
         {
-            glBindVertexArray(rock.meshes[i].VAO);
-            glDrawElementsInstanced(GL_TRIANGLES, static_cast<unsigned int>(rock.meshes[i].indices.size()), GL_UNSIGNED_INT, 0, amount);
-            glBindVertexArray(0);
+            Mesh &mesh = rock.meshes[i];
+            rockShader.setVec3("positionOffset", mesh.PositionOffset);
+            rockShader.setVec3("positionScale", mesh.PositionScale);
+            GLState::BindVertexArray(mesh.VAO);
+            //LOD 구간마다 instance 행렬 시작 위치를 옮기고 그 LOD의 index로 그림
+            for (unsigned int lod = 0; lod < lodCount; lod++)
+            {
+                unsigned int instances = lodFirst[lod + 1] - lodFirst[lod];
+                if (instances == 0)
+                    continue;
+                for (unsigned int k = 0; k < 4; k++)
+                    glVertexAttribPointer(3 + k, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                        (void*)(lodFirst[lod] * sizeof(glm::mat4) + k * sizeof(glm::vec4)));
+                const MeshLod &range = mesh.Lods[min(lod, (unsigned int)mesh.Lods.size() - 1)];
+                glDrawElementsInstanced(GL_TRIANGLES, range.indexCount, mesh.IndexType, mesh.IndexOffset(range.firstIndex), instances);
+                triangles += (unsigned long long)range.indexCount / 3 * instances;
+            }
+            GLState::BindVertexArray(0);
+        }
+
+        //1초마다 프레임당 삼각형 수 출력
+        trianglesSubmitted += triangles;
+        framesCounted++;
+        if (currentFrame - triangleReportTime >= 1.0)
+        {
+            cout << "LOD:: " << trianglesSubmitted / framesCounted << " triangles/frame, rocks per LOD";
+            for (unsigned int lod = 0; lod < lodCount; lod++)
+                cout << (lod ? " / " : " ") << lodFirst[lod + 1] - lodFirst[lod];
+            cout << endl;
+            triangleReportTime = currentFrame;
+            trianglesSubmitted = 0;
+            framesCounted = 0;
         }
         glfwSwapBuffers(window);
         glfwPollEvents();
@@ -248,9 +315,9 @@ int main(){
 
     //데이터 삭제
     /*
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &instanceVBO);
+    GLState::DeleteVertexArrays(1, &VAO);
+    GLState::DeleteBuffers(1, &VBO);
+    GLState::DeleteBuffers(1, &instanceVBO);
     */
 
     glfwTerminate();
@@ -306,49 +373,17 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path).ID;
 }
 //cubeMap 텍스처 불러오기
 unsigned int loadCubemap(vector<std::string> faces)
 {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++)
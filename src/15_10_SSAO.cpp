@@ -10,6 +10,7 @@
 #include "shader.h"
 #include "camera.h"
 #include "model.h"
+#include "frame_uniforms.h"
 
 using namespace std;
 
@@ -28,6 +29,7 @@ float lerp(float a, float b, float f)
 
 //셋팅
 const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
+const unsigned int SSAO_KERNEL_SIZE = 64, SSAO_NOISE_SIZE = 4;
 float power = 1.0f;
 
 //마우스 이동 관련
@@ -68,28 +70,39 @@ int main(){
         return -1;
     }
     //Shader 작성-----------------------------------------------------
-    Shader shaderGeometryPass("src/shaders/15_10shader_GeoPass.vs", "src/shaders/15_10shader_GeoPass.fs");
-    Shader shaderLightingPass("src/shaders/15_10shader_LightingPass.vs", "src/shaders/15_10shader_LightingPass.fs");
-    Shader shaderSSAO("src/shaders/15_10shader_SSAO.vs", "src/shaders/15_10shader_SSAO.fs");
-    Shader shaderSSAOBlur("src/shaders/15_10shader_SSAO.vs","src/shaders/15_10shader_SSAOblur.fs");
+    //compile/link는 요청만 하고 처음 use할 때 결과 확인 (그동안 모델을 읽음)
+    Shader shaderGeometryPass = Shader::Async("src/shaders/15_10shader_GeoPass.vs", "src/shaders/15_10shader_GeoPass.fs");
+    Shader shaderLightingPass = Shader::Async("src/shaders/15_10shader_LightingPass.vs", "src/shaders/15_10shader_LightingPass.fs", nullptr,
+                                              ShaderDefines().Set("NR_LIGHTS", (int)FRAME_MAX_LIGHTS));
+    //kernel 크기와 noise 배율은 상수로 compile (loop 횟수가 고정돼서 펼쳐짐)
+    ShaderDefines ssaoDefines;
+    ssaoDefines.Set("KERNEL_SIZE", (int)SSAO_KERNEL_SIZE);
+    ssaoDefines.Set("NOISE_SCALE", "vec2(" + std::to_string(SCR_WIDTH) + ".0/" + std::to_string(SSAO_NOISE_SIZE) + ".0, " +
+                                   std::to_string(SCR_HEIGHT) + ".0/" + std::to_string(SSAO_NOISE_SIZE) + ".0)");
+    Shader shaderSSAO = Shader::Async("src/shaders/15_10shader_SSAO.vs", "src/shaders/15_10shader_SSAO.fs", nullptr, ssaoDefines);
+    Shader shaderSSAOBlur = Shader::Async("src/shaders/15_10shader_SSAO.vs","src/shaders/15_10shader_SSAOblur.fs");
 
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
     //감마보정 사용
-    //glEnable(GL_FRAMEBUFFER_SRGB);
+    //GLState::Enable(GL_FRAMEBUFFER_SRGB);
 
     //모델 불러오기
-    Model backpack("resources/object/backpack/backpack.obj");
+    Model backpack("resources/object/backpack/backpack.obj", false, MODEL_MULTI_DRAW);
+    //frustum culling 통계 (1초마다 출력)
+    FrustumCullStats cullStats;
+    unsigned int cullFrames = 0;
+    float cullReportTime = 0.0f;
     
     // G-buffer
     unsigned int gBuffer;
     glGenFramebuffers(1, &gBuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, gBuffer);
     unsigned int gPosition, gNormal, gAlbedoSpec;
     // position color buffer
     glGenTextures(1, &gPosition);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
+    GLState::BindTexture(GL_TEXTURE_2D, gPosition);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -98,14 +111,14 @@ int main(){
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
     // normal color buffer
     glGenTextures(1, &gNormal);
-    glBindTexture(GL_TEXTURE_2D, gNormal);
+    GLState::BindTexture(GL_TEXTURE_2D, gNormal);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, gNormal, 0);
     // color + specular color buffer
     glGenTextures(1, &gAlbedoSpec);
-    glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+    GLState::BindTexture(GL_TEXTURE_2D, gAlbedoSpec);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -122,16 +135,16 @@ int main(){
     // finally check if framebuffer is complete
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "Framebuffer not complete!" << std::endl;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // SSAO 프레임버퍼
     unsigned int ssaoFBO, ssaoBlurFBO;
     glGenFramebuffers(1, &ssaoFBO);  glGenFramebuffers(1, &ssaoBlurFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
     unsigned int ssaoColorBuffer, ssaoColorBufferBlur;
     // SSAO color buffer
     glGenTextures(1, &ssaoColorBuffer);
-    glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+    GLState::BindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, SCR_WIDTH, SCR_HEIGHT, 0, GL_RED, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -139,27 +152,27 @@ int main(){
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "SSAO Framebuffer not complete!" << std::endl;
     // blur
-    glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
     glGenTextures(1, &ssaoColorBufferBlur);
-    glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+    GLState::BindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, SCR_WIDTH, SCR_HEIGHT, 0, GL_RED, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssaoColorBufferBlur, 0);
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "SSAO Blur Framebuffer not complete!" << std::endl;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
     
     // 샘플 커널 생성
     std::uniform_real_distribution<GLfloat> randomFloats(0.0, 1.0); // generates random floats between 0.0 and 1.0
     std::default_random_engine generator;
     std::vector<glm::vec3> ssaoKernel;
-    for (unsigned int i = 0; i < 64; ++i)
+    for (unsigned int i = 0; i < SSAO_KERNEL_SIZE; ++i)
     {
         glm::vec3 sample(randomFloats(generator) * 2.0 - 1.0, randomFloats(generator) * 2.0 - 1.0, randomFloats(generator));
         sample = glm::normalize(sample);
         sample *= randomFloats(generator);
-        float scale = float(i) / 64.0f;
+        float scale = float(i) / (float)SSAO_KERNEL_SIZE;
 
         // scale samples s.t. they're more aligned to center of kernel
         scale = lerp(0.1f, 1.0f, scale * scale);
@@ -169,14 +182,14 @@ int main(){
 
      // noise texture
     std::vector<glm::vec3> ssaoNoise;
-    for (unsigned int i = 0; i < 16; i++)
+    for (unsigned int i = 0; i < SSAO_NOISE_SIZE * SSAO_NOISE_SIZE; i++)
     {
         glm::vec3 noise(randomFloats(generator) * 2.0 - 1.0, randomFloats(generator) * 2.0 - 1.0, 0.0f); // rotate around z-axis (in tangent space)
         ssaoNoise.push_back(noise);
     }
     unsigned int noiseTexture; glGenTextures(1, &noiseTexture);
-    glBindTexture(GL_TEXTURE_2D, noiseTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 4, 4, 0, GL_RGB, GL_FLOAT, &ssaoNoise[0]);
+    GLState::BindTexture(GL_TEXTURE_2D, noiseTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, SSAO_NOISE_SIZE, SSAO_NOISE_SIZE, 0, GL_RGB, GL_FLOAT, &ssaoNoise[0]);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -197,9 +210,19 @@ int main(){
     shaderSSAO.setInt("gPosition", 0);
     shaderSSAO.setInt("gNormal", 1);
     shaderSSAO.setInt("texNoise", 2);
+    //kernel은 매 프레임 올리므로 handle을 미리 받아둠
+    std::vector<UniformHandle> sampleUniforms(SSAO_KERNEL_SIZE);
+    //카메라와 광원은 모든 shader가 같이 쓰는 uniform buffer로 (프레임당 한 번 업로드)
+    FrameUniforms frameUniforms;
+    for (unsigned int i = 0; i < SSAO_KERNEL_SIZE; ++i)
+        sampleUniforms[i] = shaderSSAO.getUniform("samples[" + std::to_string(i) + "]");
     shaderSSAOBlur.use();
     shaderSSAOBlur.setInt("ssaoInput", 0);
     
+    //모델을 읽는 동안 드라이버가 compile한 program들 (첫 프레임에서 어차피 모두 씀)
+    shaderGeometryPass.wait();
+    SharedShaderCacheStats().Print();
+    
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
@@ -221,14 +244,19 @@ int main(){
         
         // 1. geometry pass: render scene's geometry/color data into gbuffer
         // -----------------------------------------------------------------
-        glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, gBuffer);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 50.0f);
             glm::mat4 view = camera.GetViewMatrix();
             glm::mat4 model = glm::mat4(1.0f);
+            // 광원은 view space로 (lighting pass가 view space에서 계산)
+            const float linear    = 0.09f;
+            const float quadratic = 0.032f;
+            frameUniforms.SetCamera(projection, view, camera.Position);
+            frameUniforms.ClearLights();
+            frameUniforms.AddLight(glm::vec3(view * glm::vec4(lightPos, 1.0)), lightColor, linear, quadratic);
+            frameUniforms.Upload();
             shaderGeometryPass.use();
-            shaderGeometryPass.setMat4("projection", projection);
-            shaderGeometryPass.setMat4("view", view);
             // room cube
             model = glm::mat4(1.0f);
             model = glm::translate(model, glm::vec3(0.0, 7.0f, 0.0f));
@@ -243,62 +271,64 @@ int main(){
             model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0, 0.0, 0.0));
             model = glm::scale(model, glm::vec3(1.0f));
             shaderGeometryPass.setMat4("model", model);
-            backpack.Draw(shaderGeometryPass);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            backpack.Draw(shaderGeometryPass, model, camera.GetFrustum((float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 50.0f), cullStats);
+            cullFrames++;
+            if (currentFrame - cullReportTime >= 1.0f)
+            {
+                cullStats.Print("geometry", cullFrames);
+                cullStats.Reset();
+                SharedUniformStats().Print("all passes", cullFrames);
+                SharedUniformStats().Reset();
+                frameUniforms.Stats().Print("camera + light");
+                frameUniforms.Stats().Reset();
+                cullFrames = 0;
+                cullReportTime = currentFrame;
+            }
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
         // 2. generate SSAO texture
         // ------------------------
-        glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
             glClear(GL_COLOR_BUFFER_BIT);
             shaderSSAO.use();
             // Send kernel + rotation 
-            for (unsigned int i = 0; i < 64; ++i)
-                shaderSSAO.setVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
-            shaderSSAO.setMat4("projection", projection);
+            for (unsigned int i = 0; i < SSAO_KERNEL_SIZE; ++i)
+                shaderSSAO.setVec3(sampleUniforms[i], ssaoKernel[i]);
             shaderSSAO.setFloat("power", power); // 강도조절 z, x
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, gPosition);
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, gNormal);
-            glActiveTexture(GL_TEXTURE2);
-            glBindTexture(GL_TEXTURE_2D, noiseTexture);
+            GLState::ActiveTexture(GL_TEXTURE0);
+            GLState::BindTexture(GL_TEXTURE_2D, gPosition);
+            GLState::ActiveTexture(GL_TEXTURE1);
+            GLState::BindTexture(GL_TEXTURE_2D, gNormal);
+            GLState::ActiveTexture(GL_TEXTURE2);
+            GLState::BindTexture(GL_TEXTURE_2D, noiseTexture);
             renderQuad();
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
         // 3. blur SSAO texture to remove noise
         // ------------------------------------
-        glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
             glClear(GL_COLOR_BUFFER_BIT);
             shaderSSAOBlur.use();
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+            GLState::ActiveTexture(GL_TEXTURE0);
+            GLState::BindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
             renderQuad();
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
 
         // 4. lighting pass: traditional deferred Blinn-Phong lighting with added screen-space ambient occlusion
         // -----------------------------------------------------------------------------------------------------
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         shaderLightingPass.use();
-        // send light relevant uniforms
-        glm::vec3 lightPosView = glm::vec3(camera.GetViewMatrix() * glm::vec4(lightPos, 1.0));
-        shaderLightingPass.setVec3("light.Position", lightPosView);
-        shaderLightingPass.setVec3("light.Color", lightColor);
-        // Update attenuation parameters
-        const float linear    = 0.09f;
-        const float quadratic = 0.032f;
-        shaderLightingPass.setFloat("light.Linear", linear);
-        shaderLightingPass.setFloat("light.Quadratic", quadratic);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, gPosition);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, gNormal);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
-        glActiveTexture(GL_TEXTURE3); // add extra SSAO texture to lighting pass
-        glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, gPosition);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, gNormal);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+        GLState::ActiveTexture(GL_TEXTURE3); // add extra SSAO texture to lighting pass
+        GLState::BindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
         renderQuad();
 
         cout << "SSAO Power : " << power << endl;
@@ -373,51 +403,10 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path, bool gammaCorrection)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum internalFormat;
-        GLenum dataFormat;
-        if (nrComponents == 1)
-        {
-            internalFormat = dataFormat = GL_RED;
-        }
-        else if (nrComponents == 3)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB : GL_RGB;
-            dataFormat = GL_RGB;
-        }
-        else if (nrComponents == 4)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB_ALPHA : GL_RGBA;
-            dataFormat = GL_RGBA;
-        }
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path, gammaCorrection ? TEXTURE_SRGB : 0).ID;
 }
 
 //쿼드(사각형) 렌더링
@@ -437,17 +426,16 @@ void renderQuad()
         // setup plane VAO
         glGenVertexArrays(1, &quadVAO);
         glGenBuffers(1, &quadVBO);
-        glBindVertexArray(quadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        GLState::BindVertexArray(quadVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     }
-    glBindVertexArray(quadVAO);
+    GLState::BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
 //큐브 렌더링
 unsigned int cubeVAO = 0;
@@ -504,21 +492,20 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
@@ -21,7 +21,8 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 unsigned int loadTexture(char const * path);
 unsigned int loadCubemap(vector<std::string> faces);
-void renderScene(const Shader &shader);
+void setupScene();
+void renderScene(const Shader &shader, const vector<unsigned char> &visible);
 void renderCube();
 void renderQuad();
 
@@ -41,6 +42,10 @@ float lastFrame = 0.0f;
 //VAO
 unsigned int planeVAO = 0;
 
+//frustum culling 대상, 0번은 바닥이고 나머지는 큐브
+vector<glm::mat4> sceneModels;
+BoundingSphereBatch sceneBounds;
+
 
 //------------------------------------------메인함수------------------------------------------
 int main(){
@@ -77,11 +82,11 @@ int main(){
     Shader lightShader("src/shaders/12light_shader.vs","src/shaders/12light_shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
     //Multi Sampling 사용
-    glEnable(GL_MULTISAMPLE);
+    GLState::Enable(GL_MULTISAMPLE);
     //감마보정 사용
-    glEnable(GL_FRAMEBUFFER_SRGB);
+    GLState::Enable(GL_FRAMEBUFFER_SRGB);
 
 
     //vertex데이터 작성
@@ -146,8 +151,8 @@ int main(){
     unsigned int planeVBO;
     glGenVertexArrays(1, &planeVAO);
     glGenBuffers(1, &planeVBO);
-    glBindVertexArray(planeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, planeVBO);
+    GLState::BindVertexArray(planeVAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, planeVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), &planeVertices, GL_STATIC_DRAW);
     //vertex 위치 attribute
     glEnableVertexAttribArray(0);
@@ -158,14 +163,14 @@ int main(){
     //texcoords attribute
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
 
     //광원 VAO
     unsigned int lightVAO, lightVBO;
     glGenVertexArrays(1, &lightVAO);
     glGenBuffers(1, &lightVBO);
-    glBindVertexArray(lightVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lightVBO);
+    GLState::BindVertexArray(lightVAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, lightVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), &cubeVertices, GL_STATIC_DRAW);
     //광원 vertex위치 attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -186,7 +191,7 @@ int main(){
     //깊이 텍스처 생성
     unsigned int depthMap;
     glGenTextures(1, &depthMap);
-    glBindTexture(GL_TEXTURE_2D, depthMap);
+    GLState::BindTexture(GL_TEXTURE_2D, depthMap);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -195,15 +200,22 @@ int main(){
     float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
     //프레임버퍼에 깊이 텍스처 적용
-    glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthMap, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     //광원의 위치
     glm::vec3 lightPos(-2.0f, 4.0f, -1.0f);
 
+    //장면 오브젝트와 pass별 culling 통계 (1초마다 출력)
+    setupScene();
+    vector<unsigned char> visible;
+    FrustumCullStats shadowCullStats, sceneCullStats;
+    unsigned int cullFrames = 0;
+    float cullReportTime = 0.0f;
+
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
@@ -234,12 +246,14 @@ int main(){
         simpleDepthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
         //뷰 포트 그림자기준으로 변경
         glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-        glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
             glClear(GL_DEPTH_BUFFER_BIT);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, woodTexture);
-            renderScene(simpleDepthShader);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLState::ActiveTexture(GL_TEXTURE0);
+            GLState::BindTexture(GL_TEXTURE_2D, woodTexture);
+            //빛의 frustum(ortho) 밖의 오브젝트는 그림자도 없음
+            sceneBounds.Cull(Frustum(lightSpaceMatrix), visible, shadowCullStats);
+            renderScene(simpleDepthShader, visible);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         //뷰 포트 돌려놓기
         glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
@@ -255,11 +269,22 @@ int main(){
         shader.setVec3("viewPos", camera.Position);
         shader.setVec3("lightPos", lightPos);
         shader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, woodTexture);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, depthMap);
-        renderScene(shader);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, woodTexture);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, depthMap);
+        sceneBounds.Cull(camera.GetFrustum((float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f), visible, sceneCullStats);
+        renderScene(shader, visible);
+        cullFrames++;
+        if (currentFrame - cullReportTime >= 1.0f)
+        {
+            shadowCullStats.Print("shadow", cullFrames);
+            sceneCullStats.Print("scene", cullFrames);
+            shadowCullStats.Reset();
+            sceneCullStats.Reset();
+            cullFrames = 0;
+            cullReportTime = currentFrame;
+        }
 
         //광원 렌더링
         lightShader.use();
@@ -269,15 +294,15 @@ int main(){
         model = glm::translate(model, lightPos);
         model = glm::scale(model, glm::vec3(0.2f));
         lightShader.setMat4("model", model);
-        glBindVertexArray(lightVAO);
+        GLState::BindVertexArray(lightVAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
 
         //깊이맵 디버그용 쿼드 renderQuad();의 실행으로 확인가능
         debugDepthQuad.use();
         debugDepthQuad.setFloat("near_plane", near_plane);
         debugDepthQuad.setFloat("far_plane", far_plane);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, depthMap);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, depthMap);
         //renderQuad();
        
         glfwSwapBuffers(window);
@@ -340,49 +365,17 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path).ID;
 }
 //cubeMap 텍스처 불러오기
 unsigned int loadCubemap(vector<std::string> faces)
 {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++)
@@ -407,31 +400,48 @@ unsigned int loadCubemap(vector<std::string> faces)
 
     return textureID;
 } 
-//3D 장면을 렌더링
-void renderScene(const Shader &shader)
+//장면 오브젝트 model 행렬과 bounding sphere
+void setupScene()
 {
     // floor
     glm::mat4 model = glm::mat4(1.0f);
-    shader.setMat4("model", model);
-    glBindVertexArray(planeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    sceneModels.push_back(model);
+    sceneBounds.AddBox(model, glm::vec3(-25.0f, -0.5f, -25.0f), glm::vec3(25.0f, -0.5f, 25.0f));
     // cubes
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0));
     model = glm::scale(model, glm::vec3(0.5f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(2.0f, 0.0f, 1.0));
     model = glm::scale(model, glm::vec3(0.5f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(-1.0f, 0.0f, 2.0));
     model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
     model = glm::scale(model, glm::vec3(0.25));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
+    for (unsigned int i = 1; i < sceneModels.size(); i++)
+        sceneBounds.AddBox(sceneModels[i], glm::vec3(-1.0f), glm::vec3(1.0f));
+}
+//3D 장면을 렌더링 (visible[i]가 0인 오브젝트는 건너뜀)
+void renderScene(const Shader &shader, const vector<unsigned char> &visible)
+{
+    // floor
+    if (visible[0])
+    {
+        shader.setMat4("model", sceneModels[0]);
+        GLState::BindVertexArray(planeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+    // cubes
+    for (unsigned int i = 1; i < sceneModels.size(); i++)
+    {
+        if (!visible[i])
+            continue;
+        shader.setMat4("model", sceneModels[i]);
+        renderCube();
+    }
 }
 // 1x1 3D 큐브를 렌더링
 unsigned int cubeVAO = 0;
@@ -488,23 +498,22 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
 // 1x1 XY 쿼드를 렌더링
 unsigned int quadVAO = 0;
@@ -523,15 +532,14 @@ void renderQuad()
         // setup plane VAO
         glGenVertexArrays(1, &quadVAO);
         glGenBuffers(1, &quadVBO);
-        glBindVertexArray(quadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        GLState::BindVertexArray(quadVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     }
-    glBindVertexArray(quadVAO);
+    GLState::BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
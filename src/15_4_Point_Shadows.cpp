@@ -9,6 +9,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "shader.h"
+#include "shader_permutation.h"
 #include "camera.h"
 #include "model.h"
 
@@ -21,7 +22,8 @@ void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 unsigned int loadTexture(char const * path);
 unsigned int loadCubemap(vector<std::string> faces);
-void renderScene(const Shader &shader);
+void setupScene();
+void renderScene(const Shader &shader, const vector<unsigned char> &visible);
 void renderCube();
 
 //셋팅
@@ -39,6 +41,10 @@ bool firstMouse = true;
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
+//frustum culling 대상, 0번은 방(안쪽에서 그림)이고 나머지는 큐브
+vector<glm::mat4> sceneModels;
+BoundingSphereBatch sceneBounds;
+
 //------------------------------------------메인함수------------------------------------------
 int main(){
     glfwInit();
@@ -68,18 +74,26 @@ int main(){
         return -1;
     }
     //Shader 작성
-    Shader shader("src/shaders/15_4shader.vs", "src/shaders/15_4shader.fs");
+    //그림자 on/off는 uniform 분기 대신 variant로 (SPACE로 처음 바꿀 때 한 번만 compile)
+    ShaderPermutations<Shader> shaderVariants("15_4 scene", { "SHADOWS" }, [](const ShaderDefines &defines)
+    {
+        Shader variant("src/shaders/15_4shader.vs", "src/shaders/15_4shader.fs", nullptr, defines);
+        variant.use();
+        variant.setInt("diffuseTexture", 0);
+        variant.setInt("depthMap", 1);
+        return variant;
+    });
     Shader simpleDepthShader("src/shaders/15_4depth_Shader.vs", "src/shaders/15_4depth_Shader.fs",  "src/shaders/15_4depth_Shader.gs");
     Shader lightShader("src/shaders/12light_shader.vs","src/shaders/12light_shader.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
     //Multi Sampling 사용
-    glEnable(GL_MULTISAMPLE);
+    GLState::Enable(GL_MULTISAMPLE);
     //감마보정 사용
-    glEnable(GL_FRAMEBUFFER_SRGB);
+    GLState::Enable(GL_FRAMEBUFFER_SRGB);
     //컬링 사용
-    glEnable(GL_CULL_FACE);
+    GLState::Enable(GL_CULL_FACE);
 
 
     //vertex데이터 작성
@@ -133,8 +147,8 @@ int main(){
     unsigned int lightVAO, lightVBO;
     glGenVertexArrays(1, &lightVAO);
     glGenBuffers(1, &lightVBO);
-    glBindVertexArray(lightVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lightVBO);
+    GLState::BindVertexArray(lightVAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, lightVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), &cubeVertices, GL_STATIC_DRAW);
     //광원 vertex위치 attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -142,9 +156,6 @@ int main(){
 
     //텍스처 불러오기
     unsigned int woodTexture = loadTexture("textures/wood2.jpg");
-    shader.use();
-    shader.setInt("diffuseTexture", 0);
-    shader.setInt("depthMap", 1);
 
     //깊이 맵 프레임버퍼 생성
     const unsigned int SHADOW_WIDTH = 1024, SHADOW_HEIGHT = 1024;
@@ -153,7 +164,7 @@ int main(){
     //깊이 텍스처 생성
     unsigned int depthCubemap;
     glGenTextures(1, &depthCubemap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, depthCubemap);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, depthCubemap);
     for (unsigned int i = 0; i < 6; ++i)
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -162,15 +173,22 @@ int main(){
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     //프레임버퍼에 깊이 텍스처 적용
-    glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
     glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCubemap, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     //광원의 위치
     glm::vec3 lightPos(0.0f, 0.0f, 0.0f);
 
+    //장면 오브젝트와 pass별 culling 통계 (1초마다 출력)
+    setupScene();
+    vector<unsigned char> visible;
+    FrustumCullStats shadowCullStats, sceneCullStats;
+    unsigned int cullFrames = 0;
+    float cullReportTime = 0.0f;
+
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
@@ -206,20 +224,26 @@ int main(){
 
         //1. 깊이 큐브맵 scene 렌더링
         glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-        glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
             glClear(GL_DEPTH_BUFFER_BIT);
             simpleDepthShader.use();
             for (unsigned int i = 0; i < 6; ++i)
                 simpleDepthShader.setMat4("shadowMatrices[" + std::to_string(i) + "]", shadowTransforms[i]);
             simpleDepthShader.setFloat("far_plane", far_plane);
             simpleDepthShader.setVec3("lightPos", lightPos);
-            renderScene(simpleDepthShader);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            //큐브맵 6면을 한 번에 그리므로 6개 frustum 중 하나에라도 걸리면 그림
+            Frustum shadowFrusta[6];
+            for (unsigned int i = 0; i < 6; ++i)
+                shadowFrusta[i] = Frustum(shadowTransforms[i]);
+            sceneBounds.Cull(shadowFrusta, 6, visible, shadowCullStats);
+            renderScene(simpleDepthShader, visible);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         //2. 기본 scene 렌더링
         //뷰 포트 돌려놓기
         glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        Shader &shader = shaderVariants.Get(shadows ? 1 : 0);
         shader.use();
         glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
         glm::mat4 view = camera.GetViewMatrix();
@@ -228,26 +252,36 @@ int main(){
         // set lighting uniforms
         shader.setVec3("lightPos", lightPos);
         shader.setVec3("viewPos", camera.Position);
-        shader.setInt("shadows", shadows); // enable/disable shadows by pressing 'SPACE'
         shader.setFloat("far_plane", far_plane);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, woodTexture);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, depthCubemap);
-        renderScene(shader);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, woodTexture);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_CUBE_MAP, depthCubemap);
+        sceneBounds.Cull(camera.GetFrustum((float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f), visible, sceneCullStats);
+        renderScene(shader, visible);
+        cullFrames++;
+        if (currentFrame - cullReportTime >= 1.0f)
+        {
+            shadowCullStats.Print("shadow", cullFrames);
+            sceneCullStats.Print("scene", cullFrames);
+            shadowCullStats.Reset();
+            sceneCullStats.Reset();
+            cullFrames = 0;
+            cullReportTime = currentFrame;
+        }
 
         //광원 렌더링
         lightShader.use();
-        glDisable(GL_CULL_FACE);
+        GLState::Disable(GL_CULL_FACE);
         lightShader.setMat4("projection", projection);
         lightShader.setMat4("view", view);
         glm::mat4 model = glm::mat4(1.0f);
         model = glm::translate(model, lightPos);
         model = glm::scale(model, glm::vec3(0.2f));
         lightShader.setMat4("model", model);
-        glBindVertexArray(lightVAO);
+        GLState::BindVertexArray(lightVAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glEnable(GL_CULL_FACE);
+        GLState::Enable(GL_CULL_FACE);
 
 
         glfwSwapBuffers(window);
@@ -319,49 +353,17 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path).ID;
 }
 //cubeMap 텍스처 불러오기
 unsigned int loadCubemap(vector<std::string> faces)
 {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
     int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++)
@@ -387,45 +389,59 @@ unsigned int loadCubemap(vector<std::string> faces)
     return textureID;
 } 
 
-//3D 장면을 렌더링
-void renderScene(const Shader &shader)
+//장면 오브젝트 model 행렬과 bounding sphere
+void setupScene()
 {
     // room cube
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::scale(model, glm::vec3(5.0f));
-    shader.setMat4("model", model);
-    glDisable(GL_CULL_FACE); // note that we disable culling here since we render 'inside' the cube instead of the usual 'outside' which throws off the normal culling methods.
-    shader.setInt("reverse_normals", 1); // A small little hack to invert normals when drawing cube from the inside so lighting still works.
-    renderCube();
-    shader.setInt("reverse_normals", 0); // and of course disable it
-    glEnable(GL_CULL_FACE);
+    sceneModels.push_back(model);
     // cubes
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(4.0f, -3.5f, 0.0));
     model = glm::scale(model, glm::vec3(0.5f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(2.0f, 3.0f, 1.0));
     model = glm::scale(model, glm::vec3(0.75f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(-3.0f, -1.0f, 0.0));
     model = glm::scale(model, glm::vec3(0.5f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(-1.5f, 1.0f, 1.5));
     model = glm::scale(model, glm::vec3(0.5f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
     model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(-1.5f, 2.0f, -3.0));
     model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
     model = glm::scale(model, glm::vec3(0.75f));
-    shader.setMat4("model", model);
-    renderCube();
+    sceneModels.push_back(model);
+    for (unsigned int i = 0; i < sceneModels.size(); i++)
+        sceneBounds.AddBox(sceneModels[i], glm::vec3(-1.0f), glm::vec3(1.0f));
+}
+//3D 장면을 렌더링 (visible[i]가 0인 오브젝트는 건너뜀)
+void renderScene(const Shader &shader, const vector<unsigned char> &visible)
+{
+    // room cube
+    if (visible[0])
+    {
+        shader.setMat4("model", sceneModels[0]);
+        GLState::Disable(GL_CULL_FACE); // note that we disable culling here since we render 'inside' the cube instead of the usual 'outside' which throws off the normal culling methods.
+        shader.setInt("reverse_normals", 1); // A small little hack to invert normals when drawing cube from the inside so lighting still works.
+        renderCube();
+        shader.setInt("reverse_normals", 0); // and of course disable it
+        GLState::Enable(GL_CULL_FACE);
+    }
+    // cubes
+    for (unsigned int i = 1; i < sceneModels.size(); i++)
+    {
+        if (!visible[i])
+            continue;
+        shader.setMat4("model", sceneModels[i]);
+        renderCube();
+    }
 }
 // 1x1 3D 큐브를 렌더링
 unsigned int cubeVAO = 0;
@@ -482,21 +498,20 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
@@ -9,8 +9,10 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "shader.h"
+#include "shader_permutation.h"
 #include "camera.h"
 #include "model.h"
+#include "light_manager.h"
 
 using namespace std;
 
@@ -25,6 +27,10 @@ void renderCube();
 
 //셋팅
 const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
+//gaussian blur (가운데 + 한쪽 4 tap)
+const unsigned int LIGHT_CAPACITY = 16; // 광원 buffer 크기 (shader가 읽는 개수는 LightManager::Count)
+const unsigned int BLUR_TAPS = 5;
+const float BLUR_WEIGHTS[BLUR_TAPS] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
 float exposure = 1.0f;
 bool bloom = true;
 bool bloomKeyPressed = false;
@@ -66,28 +72,56 @@ int main(){
         std::cout << "Failed to initialize GLAD" << std::endl;
         return -1;
     }
+    //광원 목록은 SSBO(없으면 UBO)로, 형식은 shader에 define으로 넣어줌
+    LightManager lights(LIGHT_CAPACITY);
     //Shader 작성-----------------------------------------------------
-    Shader shader("src/shaders/15_8shader.vs", "src/shaders/15_8shader.fs");
+    Shader shader("src/shaders/15_8shader.vs", "src/shaders/15_8shader.fs", nullptr, lights.Defines());
     Shader shaderLight("src/shaders/15_8shader.vs", "src/shaders/15_8light_Shader.fs");
-    Shader shaderBlur("src/shaders/15_8blur_Shader.vs", "src/shaders/15_8blur_Shader.fs");
-    Shader shaderBloomFinal("src/shaders/15_8bloom_Shader.vs", "src/shaders/15_8bloom_Shader.fs");
+    //blur 방향과 bloom on/off는 uniform 분기 대신 variant로, tap 수와 weight는 상수로 compile
+    ShaderDefines blurDefines;
+    std::string blurWeights;
+    for (unsigned int i = 0; i < BLUR_TAPS; i++)
+    {
+        char weight[32];
+        snprintf(weight, sizeof(weight), "%s%.10f", i ? ", " : "", BLUR_WEIGHTS[i]);
+        blurWeights += weight;
+    }
+    blurDefines.Set("BLUR_TAPS", (int)BLUR_TAPS).Set("BLUR_WEIGHTS", blurWeights);
+    ShaderPermutations<Shader> blurVariants("15_8 blur", { "HORIZONTAL" }, [](const ShaderDefines &defines)
+    {
+        Shader variant("src/shaders/15_8blur_Shader.vs", "src/shaders/15_8blur_Shader.fs", nullptr, defines);
+        variant.use();
+        variant.setInt("image", 0);
+        return variant;
+    }, blurDefines);
+    ShaderPermutations<Shader> bloomVariants("15_8 bloom", { "BLOOM" }, [](const ShaderDefines &defines)
+    {
+        Shader variant("src/shaders/15_8bloom_Shader.vs", "src/shaders/15_8bloom_Shader.fs", nullptr, defines);
+        variant.use();
+        variant.setInt("scene", 0);
+        variant.setInt("bloomBlur", 1);
+        return variant;
+    });
+    //ping-pong은 두 방향을 매 프레임 다 쓰므로 미리 compile
+    blurVariants.Get(0);
+    blurVariants.Get(1);
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
     //감마보정 사용
-    //glEnable(GL_FRAMEBUFFER_SRGB);
+    //GLState::Enable(GL_FRAMEBUFFER_SRGB);
 
 
     //부동 소수점 프레임버퍼 생성---------------------------------------
     unsigned int hdrFBO;
     glGenFramebuffers(1, &hdrFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
     //[0] 일반렌더링 , [1] 일정 세기 이상의 색 렌더링
     unsigned int colorBuffers[2];
     glGenTextures(2, colorBuffers);
     for (unsigned int i = 0; i < 2; i++)
     {
-        glBindTexture(GL_TEXTURE_2D, colorBuffers[i]);
+        GLState::BindTexture(GL_TEXTURE_2D, colorBuffers[i]);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -108,7 +142,7 @@ int main(){
     //프레임버퍼 완성 확인
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "Framebuffer not complete!" << std::endl;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     //블러용 ping-pong 프레임버퍼----------------------------------------
     unsigned int pingpongFBO[2];
@@ -117,8 +151,8 @@ int main(){
     glGenTextures(2, pingpongColorbuffers);
     for (unsigned int i = 0; i < 2; i++)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
-        glBindTexture(GL_TEXTURE_2D, pingpongColorbuffers[i]);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[i]);
+        GLState::BindTexture(GL_TEXTURE_2D, pingpongColorbuffers[i]);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -144,6 +178,8 @@ int main(){
     lightColors.push_back(glm::vec3(10.0f,  0.0f,  0.0f));
     lightColors.push_back(glm::vec3(0.0f,   0.0f,  15.0f));
     lightColors.push_back(glm::vec3(0.0f,   5.0f,  0.0f));
+    for (unsigned int i = 0; i < lightPositions.size(); i++)
+        lights.Add(lightPositions[i], lightColors[i]);
 
     //텍스처 불러오기------------------------------------------------------
     unsigned int woodTexture = loadTexture("textures/wood2.jpg", true);
@@ -152,11 +188,6 @@ int main(){
     //쉐이더 설정------------------------------------------------------------
     shader.use();
     shader.setInt("diffuseTexture", 0);
-    shaderBlur.use();
-    shaderBlur.setInt("image", 0);
-    shaderBloomFinal.use();
-    shaderBloomFinal.setInt("scene", 0);
-    shaderBloomFinal.setInt("bloomBlur", 1);
 
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -178,7 +209,7 @@ int main(){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         // 1. 부동 소수점 프레임버퍼로 렌더링 / HDR로 렌더링
-        glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
         glm::mat4 view = camera.GetViewMatrix();
@@ -186,14 +217,10 @@ int main(){
         shader.use();
         shader.setMat4("projection", projection);
         shader.setMat4("view", view);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, woodTexture);
-        //광원 위치, 색 전달
-        for (unsigned int i = 0; i < lightPositions.size(); i++)
-        {
-            shader.setVec3("lights[" + std::to_string(i) + "].Position", lightPositions[i]);
-            shader.setVec3("lights[" + std::to_string(i) + "].Color", lightColors[i]);
-        }
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, woodTexture);
+        //광원 위치, 색 전달 (바뀐 광원만 올라감)
+        lights.Upload();
         shader.setVec3("viewPos", camera.Position);
         //바닥용으로 큰 큐브 생성
         model = glm::mat4(1.0f);
@@ -202,7 +229,7 @@ int main(){
         shader.setMat4("model", model);
         renderCube();
         //장면에 여러 큐브 생성
-        glBindTexture(GL_TEXTURE_2D, containerTexture);
+        GLState::BindTexture(GL_TEXTURE_2D, containerTexture);
         model = glm::mat4(1.0f);
         model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0));
         model = glm::scale(model, glm::vec3(0.5f));
@@ -254,33 +281,32 @@ int main(){
             shaderLight.setVec3("lightColor", lightColors[i]);
             renderCube();
         }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         //2. 블러 scene 만들기
         // --------------------------------------------------
         bool horizontal = true, first_iteration = true;
         unsigned int amount = 10;
-        shaderBlur.use();
         for (unsigned int i = 0; i < amount; i++)
         {
-            glBindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
-            shaderBlur.setInt("horizontal", horizontal);
-            glBindTexture(GL_TEXTURE_2D, first_iteration ? colorBuffers[1] : pingpongColorbuffers[!horizontal]);  // bind texture of other framebuffer (or scene if first iteration)
+            GLState::BindFramebuffer(GL_FRAMEBUFFER, pingpongFBO[horizontal]);
+            blurVariants.Get(horizontal ? 1 : 0).use();
+            GLState::BindTexture(GL_TEXTURE_2D, first_iteration ? colorBuffers[1] : pingpongColorbuffers[!horizontal]);  // bind texture of other framebuffer (or scene if first iteration)
             renderQuad();
             horizontal = !horizontal;
             if (first_iteration)
                 first_iteration = false;
         }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         //3. HDR scene, Blur Scene 합쳐서 렌더링
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        Shader &shaderBloomFinal = bloomVariants.Get(bloom ? 1 : 0);
         shaderBloomFinal.use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, colorBuffers[0]);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, pingpongColorbuffers[!horizontal]);
-        shaderBloomFinal.setInt("bloom", bloom);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, colorBuffers[0]);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, pingpongColorbuffers[!horizontal]);
         shaderBloomFinal.setFloat("exposure", exposure);
         renderQuad();
 
@@ -367,51 +393,10 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path, bool gammaCorrection)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum internalFormat;
-        GLenum dataFormat;
-        if (nrComponents == 1)
-        {
-            internalFormat = dataFormat = GL_RED;
-        }
-        else if (nrComponents == 3)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB : GL_RGB;
-            dataFormat = GL_RGB;
-        }
-        else if (nrComponents == 4)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB_ALPHA : GL_RGBA;
-            dataFormat = GL_RGBA;
-        }
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path, gammaCorrection ? TEXTURE_SRGB : 0).ID;
 }
 
 //쿼드(사각형) 렌더링
@@ -431,17 +416,16 @@ void renderQuad()
         // setup plane VAO
         glGenVertexArrays(1, &quadVAO);
         glGenBuffers(1, &quadVBO);
-        glBindVertexArray(quadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        GLState::BindVertexArray(quadVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     }
-    glBindVertexArray(quadVAO);
+    GLState::BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
 //큐브 렌더링
 unsigned int cubeVAO = 0;
@@ -498,21 +482,20 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
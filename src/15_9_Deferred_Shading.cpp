@@ -11,6 +11,8 @@
 #include "shader.h"
 #include "camera.h"
 #include "model.h"
+#include "frame_uniforms.h"
+#include "light_manager.h"
 
 using namespace std;
 
@@ -25,6 +27,14 @@ void renderCube();
 
 //셋팅
 const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
+const unsigned int LIGHT_CAPACITY = 4096; // 광원 buffer 크기, SSBO면 shader 쪽 제한 없음 (UBO면 더 작아질 수 있음)
+bool multiDraw = true; // M키로 mesh별 draw와 비교
+bool multiDrawKeyPressed = false;
+float triangleReportTime = 0.0f; // LOD 삼각형 수 출력 시각
+bool meshletCulling = false; // C키로 meshlet culling 전환 (켜면 LOD0)
+bool meshletKeyPressed = false;
+bool useRenderQueue = true; // R키로 정렬 queue와 바로 그리기 전환 (LOD draw일 때)
+bool renderQueueKeyPressed = false;
 
 //마우스 이동 관련
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
@@ -64,17 +74,26 @@ int main(){
         return -1;
     }
     //Shader 작성-----------------------------------------------------
-    Shader shaderGeometryPass("src/shaders/15_9shader_GeoPass.vs", "src/shaders/15_9shader_GeoPass.fs");
-    Shader shaderLightingPass("src/shaders/15_9shader_LightingPass.vs", "src/shaders/15_9shader_LightingPass.fs");
-    Shader shaderLightBox("src/shaders/15_9shader_LightBox.vs", "src/shaders/15_9shader_LightBox.fs");
+    //compile/link는 요청만 하고 처음 use할 때 결과 확인 (그동안 모델을 읽음)
+    Shader shaderGeometryPass = Shader::Async("src/shaders/15_9shader_GeoPass.vs", "src/shaders/15_9shader_GeoPass.fs");
+    //광원 목록은 SSBO(없으면 UBO)로, 형식은 shader에 define으로 넣어줌
+    LightManager lights(LIGHT_CAPACITY);
+    Shader shaderLightingPass = Shader::Async("src/shaders/15_9shader_LightingPass.vs", "src/shaders/15_9shader_LightingPass.fs", nullptr,
+                                              lights.Defines());
+    Shader shaderLightBox = Shader::Async("src/shaders/15_9shader_LightBox.vs", "src/shaders/15_9shader_LightBox.fs");
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
     //감마보정 사용
-    //glEnable(GL_FRAMEBUFFER_SRGB);
+    //GLState::Enable(GL_FRAMEBUFFER_SRGB);
 
     //모델 불러오기
-    Model backpack("resources/object/backpack/backpack.obj");
+    Model backpack("resources/object/backpack/backpack.obj", false, MODEL_MULTI_DRAW | MODEL_KEEP_MESH_BUFFERS | MODEL_GENERATE_LODS | MODEL_BUILD_MESHLETS);
+    MeshletCullStats cullStats;
+    unsigned int cullFrames = 0;
+    //geometry pass draw를 정렬해서 실행 (material별로 모아 텍스처 바인딩을 줄임)
+    RenderQueue renderQueue;
+    RenderQueueStats queueStats;
     //모델의 위치
     vector<glm::vec3> objectPositions;
     objectPositions.push_back(glm::vec3(-3.0,  -0.5, -3.0));
@@ -86,29 +105,42 @@ int main(){
     objectPositions.push_back(glm::vec3(-3.0,  -0.5,  3.0));
     objectPositions.push_back(glm::vec3( 0.0,  -0.5,  3.0));
     objectPositions.push_back(glm::vec3( 3.0,  -0.5,  3.0));
+    //오브젝트 model 행렬과 bounding sphere (frustum culling용)
+    vector<glm::mat4> objectModels;
+    BoundingSphereBatch objectBounds;
+    for (unsigned int i = 0; i < objectPositions.size(); i++)
+    {
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, objectPositions[i]);
+        model = glm::scale(model, glm::vec3(0.5f));
+        objectModels.push_back(model);
+        objectBounds.AddBox(model, backpack.boundsMin, backpack.boundsMax);
+    }
+    vector<unsigned char> visible;
+    FrustumCullStats objectCullStats, lightCullStats;
 
     // G-buffer
     unsigned int gBuffer;
     glGenFramebuffers(1, &gBuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, gBuffer);
     unsigned int gPosition, gNormal, gAlbedoSpec;
     // position color buffer
     glGenTextures(1, &gPosition);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
+    GLState::BindTexture(GL_TEXTURE_2D, gPosition);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
     // normal color buffer
     glGenTextures(1, &gNormal);
-    glBindTexture(GL_TEXTURE_2D, gNormal);
+    GLState::BindTexture(GL_TEXTURE_2D, gNormal);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_FLOAT, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, gNormal, 0);
     // color + specular color buffer
     glGenTextures(1, &gAlbedoSpec);
-    glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+    GLState::BindTexture(GL_TEXTURE_2D, gAlbedoSpec);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -125,10 +157,10 @@ int main(){
     // finally check if framebuffer is complete
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         std::cout << "Framebuffer not complete!" << std::endl;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // 광원 정보
-    const unsigned int NR_LIGHTS = 32;
+    const unsigned int NR_LIGHTS = 32; // LIGHT_CAPACITY까지 늘려도 shader는 다시 compile하지 않음
     std::vector<glm::vec3> lightPositions;
     std::vector<glm::vec3> lightColors;
     srand(13);
@@ -144,16 +176,35 @@ int main(){
         float gColor = static_cast<float>(((rand() % 100) / 200.0f) + 0.5); // between 0.5 and 1.0
         float bColor = static_cast<float>(((rand() % 100) / 200.0f) + 0.5); // between 0.5 and 1.0
         lightColors.push_back(glm::vec3(rColor, gColor, bColor));
+        // update attenuation parameters and calculate radius
+        const float constant = 1.0f;
+        const float linear = 0.7f;
+        const float quadratic = 1.8f;
+        // then calculate radius of light volume/sphere
+        const float maxBrightness = std::fmaxf(std::fmaxf(rColor, gColor), bColor);
+        float radius = (-linear + std::sqrt(linear * linear - 4 * quadratic * (constant - (256.0f / 5.0f) * maxBrightness))) / (2.0f * quadratic);
+        lights.Add(lightPositions.back(), lightColors.back(), linear, quadratic, radius);
     }
+    //광원 큐브 bounding sphere
+    BoundingSphereBatch lightBounds;
+    for (unsigned int i = 0; i < lightPositions.size(); i++)
+        lightBounds.AddBox(glm::scale(glm::translate(glm::mat4(1.0f), lightPositions[i]), glm::vec3(0.125f)), glm::vec3(-1.0f), glm::vec3(1.0f));
 
     //쉐이더
     shaderLightingPass.use();
     shaderLightingPass.setInt("gPosition", 0);
     shaderLightingPass.setInt("gNormal", 1);
     shaderLightingPass.setInt("gAlbedoSpec", 2);
+    //카메라는 모든 shader가 같이 쓰는 uniform buffer로 (프레임당 한 번 업로드), 광원은 위의 LightManager
+    FrameUniforms frameUniforms;
 
 
     
+    //모델을 읽는 동안 드라이버가 compile한 program들 (첫 프레임에서 어차피 모두 씀)
+    shaderGeometryPass.wait();
+    shaderLightBox.wait();
+    SharedShaderCacheStats().Print();
+    
     //폴리곤모드
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
@@ -174,69 +225,73 @@ int main(){
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
         // 1. geometry pass: render scene's geometry/color data into gbuffer
-        glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, gBuffer);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
             glm::mat4 view = camera.GetViewMatrix();
             glm::mat4 model = glm::mat4(1.0f);
+            frameUniforms.SetCamera(projection, view, camera.Position);
+            frameUniforms.Upload();
+            //광원은 바뀐 것만 올라감 (움직이지 않으면 업로드 없음)
+            lights.Upload();
             shaderGeometryPass.use();
-            shaderGeometryPass.setMat4("projection", projection);
-            shaderGeometryPass.setMat4("view", view);
+            backpack.multiDraw = multiDraw && backpack.arena.IsBuilt();
+            unsigned int triangles = 0;
+            Frustum frustum = camera.GetFrustum((float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+            objectBounds.Cull(frustum, visible, objectCullStats);
+            renderQueue.SetView(camera.Position, 100.0f);
             for (unsigned int i = 0; i < objectPositions.size(); i++)
             {
-                model = glm::mat4(1.0f);
-                model = glm::translate(model, objectPositions[i]);
-                model = glm::scale(model, glm::vec3(0.5f));
+                if (!visible[i])
+                    continue;
+                model = objectModels[i];
                 shaderGeometryPass.setMat4("model", model);
-                backpack.Draw(shaderGeometryPass);
+                if (meshletCulling)
+                {
+                    backpack.DrawCulled(shaderGeometryPass, model, frustum, camera.Position, cullStats);
+                    continue;
+                }
+                //화면에서 오차가 1 pixel 이하인 LOD
+                glm::vec3 center = glm::vec3(model * glm::vec4(backpack.boundsCenter, 1.0f));
+                unsigned int lod = backpack.SelectLod(camera, center, 0.5f, (float)SCR_HEIGHT);
+                if (useRenderQueue)
+                    backpack.Submit(renderQueue, shaderGeometryPass, model, lod);
+                else
+                    backpack.Draw(shaderGeometryPass, lod);
+                triangles += backpack.Triangles(lod);
             }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            renderQueue.Flush(queueStats);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // 2. lighting pass: calculate lighting by iterating over a screen filled quad pixel-by-pixel using the gbuffer's content.
         // -----------------------------------------------------------------------------------------------------------------------
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         shaderLightingPass.use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, gPosition);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, gNormal);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
-        // send light relevant uniforms
-        for (unsigned int i = 0; i < lightPositions.size(); i++)
-        {
-            shaderLightingPass.setVec3("lights[" + std::to_string(i) + "].Position", lightPositions[i]);
-            shaderLightingPass.setVec3("lights[" + std::to_string(i) + "].Color", lightColors[i]);
-            // update attenuation parameters and calculate radius
-            const float constant = 1.0f;
-            const float linear = 0.7f;
-            const float quadratic = 1.8f;
-            shaderLightingPass.setFloat("lights[" + std::to_string(i) + "].Linear", linear);
-            shaderLightingPass.setFloat("lights[" + std::to_string(i) + "].Quadratic", quadratic);
-            // then calculate radius of light volume/sphere
-            const float maxBrightness = std::fmaxf(std::fmaxf(lightColors[i].r, lightColors[i].g), lightColors[i].b);
-            float radius = (-linear + std::sqrt(linear * linear - 4 * quadratic * (constant - (256.0f / 5.0f) * maxBrightness))) / (2.0f * quadratic);
-            shaderLightingPass.setFloat("lights[" + std::to_string(i) + "].Radius", radius);
-        }
-        shaderLightingPass.setVec3("viewPos", camera.Position);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, gPosition);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, gNormal);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, gAlbedoSpec);
         // finally render quad
         renderQuad();
 
         // 2.5. copy content of geometry's depth buffer to default framebuffer's depth buffer
         // ----------------------------------------------------------------------------------
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // write to default framebuffer
+        GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer);
+        GLState::BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // write to default framebuffer
         // geometry의 깊이 버퍼 내용을 기본 프레임 버퍼로 복사
         glBlitFramebuffer(0, 0, SCR_WIDTH, SCR_HEIGHT, 0, 0, SCR_WIDTH, SCR_HEIGHT, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         // 3. render lights on top of scene
         // --------------------------------
         shaderLightBox.use();
-        shaderLightBox.setMat4("projection", projection);
-        shaderLightBox.setMat4("view", view);
+        lightBounds.Cull(frustum, visible, lightCullStats);
         for (unsigned int i = 0; i < lightPositions.size(); i++)
         {
+            if (!visible[i])
+                continue;
             model = glm::mat4(1.0f);
             model = glm::translate(model, lightPositions[i]);
             model = glm::scale(model, glm::vec3(0.125f));
@@ -244,7 +299,34 @@ int main(){
             shaderLightBox.setVec3("lightColor", lightColors[i]);
             renderCube();
         }
-        
+
+        //1초마다 pass별 culling, 삼각형 수 출력
+        cullFrames++;
+        if (currentFrame - triangleReportTime >= 1.0f)
+        {
+            objectCullStats.Print("geometry", cullFrames);
+            lightCullStats.Print("light boxes", cullFrames);
+            if (meshletCulling)
+                cullStats.Print("backpack", cullFrames);
+            else
+                std::cout << "LOD:: " << triangles << " triangles/frame" << std::endl;
+            if (queueStats.commands > 0)
+                queueStats.Print("geometry", cullFrames);
+            SharedUniformStats().Print("all passes", cullFrames);
+            SharedUniformStats().Reset();
+            frameUniforms.Stats().Print("camera");
+            frameUniforms.Stats().Reset();
+            lights.PrintStats("deferred");
+            lights.Stats().Reset();
+            GLState::Stats().Print("all passes", cullFrames);
+            GLState::Stats().Reset();
+            objectCullStats.Reset();
+            lightCullStats.Reset();
+            cullStats.Reset();
+            queueStats.Reset();
+            cullFrames = 0;
+            triangleReportTime = currentFrame;
+        }
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
@@ -278,6 +360,35 @@ void processInput(GLFWwindow *window)
         camera.ProcessKeyboard(UP, deltaTime);
     if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
         camera.ProcessKeyboard(DOWN, deltaTime);
+    //meshlet culling 전환 // c
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !meshletKeyPressed)
+    {
+        meshletCulling = !meshletCulling;
+        meshletKeyPressed = true;
+        std::cout << (meshletCulling ? "meshlet culling" : "LOD draw") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE)
+        meshletKeyPressed = false;
+    //multi draw 전환 // m
+    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !multiDrawKeyPressed)
+    {
+        multiDraw = !multiDraw;
+        multiDrawKeyPressed = true;
+        std::cout << (multiDraw ? "multi draw indirect" : "per-mesh draw") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE)
+    {
+        multiDrawKeyPressed = false;
+    }
+    //정렬 queue 전환 // r
+    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS && !renderQueueKeyPressed)
+    {
+        useRenderQueue = !useRenderQueue;
+        renderQueueKeyPressed = true;
+        std::cout << (useRenderQueue ? "render queue" : "immediate draw") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_RELEASE)
+        renderQueueKeyPressed = false;
     
 }
 //마우스 input 카메라이동
@@ -303,51 +414,10 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
+//텍스쳐 불러오기 (TextureCache 공유)
 unsigned int loadTexture(char const * path, bool gammaCorrection)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum internalFormat;
-        GLenum dataFormat;
-        if (nrComponents == 1)
-        {
-            internalFormat = dataFormat = GL_RED;
-        }
-        else if (nrComponents == 3)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB : GL_RGB;
-            dataFormat = GL_RGB;
-        }
-        else if (nrComponents == 4)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB_ALPHA : GL_RGBA;
-            dataFormat = GL_RGBA;
-        }
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path, gammaCorrection ? TEXTURE_SRGB : 0).ID;
 }
 
 //쿼드(사각형) 렌더링
@@ -367,17 +437,16 @@ void renderQuad()
         // setup plane VAO
         glGenVertexArrays(1, &quadVAO);
         glGenBuffers(1, &quadVBO);
-        glBindVertexArray(quadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        GLState::BindVertexArray(quadVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     }
-    glBindVertexArray(quadVAO);
+    GLState::BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
 //큐브 렌더링
 unsigned int cubeVAO = 0;
@@ -434,21 +503,20 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
@@ -10,6 +10,7 @@
 #include "shader.h"
 #include "camera.h"
 #include "model.h"
+#include "light_manager.h"
 
 using namespace std;
 
@@ -18,11 +19,12 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void processInput(GLFWwindow *window);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
-unsigned int loadTexture(char const * path);
+unsigned int loadTexture(char const * path, unsigned int flags = TEXTURE_COMPRESS);
 void renderSphere();
 
 //셋팅
 const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
+const unsigned int LIGHT_CAPACITY = 16; // 광원 buffer 크기 (shader가 읽는 개수는 LightManager::Count)
 
 //마우스 이동 관련
 Camera camera(glm::vec3(0.0f, 0.0f, 5.0f));
@@ -62,10 +64,12 @@ int main(){
     }
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
+    GLState::Enable(GL_DEPTH_TEST); 
 
+    //광원 목록은 SSBO(없으면 UBO)로, 형식은 shader에 define으로 넣어줌
+    LightManager lights(LIGHT_CAPACITY);
     //Shader 작성-----------------------------------------------------
-    Shader shader("src/shaders/16_1shader.vs", "src/shaders/16_1shader.fs");
+    Shader shader("src/shaders/16_1shader.vs", "src/shaders/16_1shader.fs", nullptr, lights.Defines());
 
     //shader 데이터 전달
     shader.use();
@@ -79,10 +83,11 @@ int main(){
     // load PBR material textures
     // --------------------------
     unsigned int albedo = loadTexture("textures/rusted_iron/albedo.png");
-    unsigned int normal = loadTexture("textures/rusted_iron/normal.png");
+    unsigned int normal = loadTexture("textures/rusted_iron/normal.png", TEXTURE_COMPRESS | TEXTURE_NORMAL_MAP);
     unsigned int metallic = loadTexture("textures/rusted_iron/metallic.png");
     unsigned int roughness = loadTexture("textures/rusted_iron/roughness.png");
     unsigned int ao = loadTexture("textures/rusted_iron/ao.png");
+    TextureCache::PrintStats();
 
     //광원 정보
     glm::vec3 lightPositions[] = {
@@ -91,6 +96,8 @@ int main(){
     glm::vec3 lightColors[] = {
         glm::vec3(150.0f, 150.0f, 150.0f),
     };
+    for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+        lights.Add(lightPositions[i], lightColors[i]);
     //생성할 구 설정
     int nrRows = 7;
     int nrColumns = 7;
@@ -122,17 +129,19 @@ int main(){
         glm::mat4 view = camera.GetViewMatrix();
         shader.setMat4("view", view);
         shader.setVec3("camPos", camera.Position);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, albedo);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, normal);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, metallic);
-        glActiveTexture(GL_TEXTURE3);
-        glBindTexture(GL_TEXTURE_2D, roughness);
-        glActiveTexture(GL_TEXTURE4);
-        glBindTexture(GL_TEXTURE_2D, ao);
+        //광원은 고정이라 처음 프레임에만 실제로 업로드됨 (바뀐 광원만 올림)
+        lights.Upload();
+
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_2D, albedo);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_2D, normal);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, metallic);
+        GLState::ActiveTexture(GL_TEXTURE3);
+        GLState::BindTexture(GL_TEXTURE_2D, roughness);
+        GLState::ActiveTexture(GL_TEXTURE4);
+        GLState::BindTexture(GL_TEXTURE_2D, ao);
 
         // render rows*column number of spheres with material properties defined by textures (they all have the same material properties)
         glm::mat4 model = glm::mat4(1.0f);
@@ -154,15 +163,10 @@ int main(){
         // render light source (simply re-render sphere at light positions)
         // this looks a bit off as we use the same shader, but it'll make their positions obvious and 
         // keeps the codeprint small.
-        for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+        for (unsigned int i = 0; i < lights.Count(); ++i)
         {
-            glm::vec3 newPos = lightPositions[i] + glm::vec3(sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
-            newPos = lightPositions[i];
-            shader.setVec3("lightPositions[" + std::to_string(i) + "]", newPos);
-            shader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
-
             model = glm::mat4(1.0f);
-            model = glm::translate(model, newPos);
+            model = glm::translate(model, lights.Position(i));
             model = glm::scale(model, glm::vec3(0.5f));
             shader.setMat4("model", model);
             renderSphere();
@@ -226,42 +230,10 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
     camera.ProcessMouseScroll(yoffset);
 }
-//텍스쳐 불러오기
-unsigned int loadTexture(char const * path)
+//텍스쳐 불러오기 (TextureCache 공유, 기본은 BCn 압축 + .dds 캐시)
+unsigned int loadTexture(char const * path, unsigned int flags)
 {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(path, &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
-
-    return textureID;
+    return TextureCache::Acquire(path, flags).ID;
 }
 //구 렌더링
 unsigned int sphereVAO = 0;
@@ -341,10 +313,10 @@ void renderSphere()
                 data.push_back(uv[i].y);
             }
         }
-        glBindVertexArray(sphereVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        GLState::BindVertexArray(sphereVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, vbo);
         glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), &data[0], GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
         unsigned int stride = (3 + 2 + 3) * sizeof(float);
         glEnableVertexAttribArray(0);
@@ -355,6 +327,6 @@ void renderSphere()
 		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));        
     }
 
-    glBindVertexArray(sphereVAO);
+    GLState::BindVertexArray(sphereVAO);
     glDrawElements(GL_TRIANGLE_STRIP, indexCount, GL_UNSIGNED_INT, 0);
 }
@@ -10,6 +10,7 @@
 #include "shader.h"
 #include "camera.h"
 #include "model.h"
+#include "light_manager.h"
 
 using namespace std;
 
@@ -25,6 +26,8 @@ void renderQuad();
 
 //셋팅
 const unsigned int SCR_HEIGHT = 720, SCR_WIDTH = 1280;
+const unsigned int IBL_PREFILTER_SAMPLES = 1024, IBL_BRDF_SAMPLES = 1024;
+const unsigned int LIGHT_CAPACITY = 16; // 광원 buffer 크기 (shader가 읽는 개수는 LightManager::Count)
 
 //마우스 이동 관련
 Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
@@ -65,29 +68,24 @@ int main(){
     }
 
     //Depth buffer 사용
-    glEnable(GL_DEPTH_TEST); 
-    glDepthFunc(GL_LEQUAL);
+    GLState::Enable(GL_DEPTH_TEST); 
+    GLState::DepthFunc(GL_LEQUAL);
     //큐브맵 샘플링에 낮은 mip levels의 경계선 없애주는거
-    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    GLState::Enable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
+    //광원 목록은 SSBO(없으면 UBO)로, 형식은 shader에 define으로 넣어줌
+    LightManager lights(LIGHT_CAPACITY);
     //Shader 작성-----------------------------------------------------
-    Shader pbrShader("src/shaders/16_2shader_PBR.vs", "src/shaders/16_2shader_PBR.fs");
-    Shader equirectangularToCubemapShader("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_Equirectangular.fs");
-    Shader irradianceShader("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_Irradiance.fs");
-    Shader prefilterShader("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_PreFilter.fs");
-    Shader brdfShader("src/shaders/16_2shader_BRDF.vs", "src/shaders/16_2shader_BRDF.fs");
-    Shader backgroundShader("src/shaders/16_2shader_Background.vs", "src/shaders/16_2shader_Background.fs");
-
-    //shader 데이터 전달
-    pbrShader.use();
-    pbrShader.setInt("irradianceMap", 0);
-    pbrShader.setInt("prefilterMap", 1);
-    pbrShader.setInt("brdfLUT", 2);
-    pbrShader.setVec3("albedo", 0.5f, 0.0f, 0.0f);
-    pbrShader.setFloat("ao", 1.0f);
-
-    backgroundShader.use();
-    backgroundShader.setInt("environmentMap", 0);
+    //compile/link는 요청만 하고 처음 use할 때 결과 확인 (그동안 HDR 환경맵을 읽음)
+    Shader pbrShader = Shader::Async("src/shaders/16_2shader_PBR.vs", "src/shaders/16_2shader_PBR.fs", nullptr, lights.Defines());
+    Shader equirectangularToCubemapShader = Shader::Async("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_Equirectangular.fs");
+    Shader irradianceShader = Shader::Async("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_Irradiance.fs");
+    //importance sampling 횟수는 상수로 compile (16_2ibl_sampling.glsl)
+    Shader prefilterShader = Shader::Async("src/shaders/16_2shader_cubemap.vs", "src/shaders/16_2shader_PreFilter.fs", nullptr,
+                                            ShaderDefines().Set("SAMPLE_COUNT", (int)IBL_PREFILTER_SAMPLES));
+    Shader brdfShader = Shader::Async("src/shaders/16_2shader_BRDF.vs", "src/shaders/16_2shader_BRDF.fs", nullptr,
+                                       ShaderDefines().Set("SAMPLE_COUNT", (int)IBL_BRDF_SAMPLES));
+    Shader backgroundShader = Shader::Async("src/shaders/16_2shader_Background.vs", "src/shaders/16_2shader_Background.fs");
 
 
     //광원 정보
@@ -103,6 +101,8 @@ int main(){
         glm::vec3(300.0f, 300.0f, 300.0f),
         glm::vec3(300.0f, 300.0f, 300.0f)
     };
+    for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+        lights.Add(lightPositions[i], lightColors[i]);
     //생성할 구 설정
     int nrRows = 7;
     int nrColumns = 7;
@@ -115,7 +115,7 @@ int main(){
     glGenFramebuffers(1, &captureFBO);
     glGenRenderbuffers(1, &captureRBO);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, captureRBO);
@@ -128,7 +128,7 @@ int main(){
     if (data)
     {
         glGenTextures(1, &hdrTexture);
-        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        GLState::BindTexture(GL_TEXTURE_2D, hdrTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, data); // note how we specify the texture's data value to be float
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -146,7 +146,7 @@ int main(){
         //프레임버퍼에 적용할 큐브맵
     unsigned int envCubemap;
     glGenTextures(1, &envCubemap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 512, 512, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -173,11 +173,11 @@ int main(){
     equirectangularToCubemapShader.use();
     equirectangularToCubemapShader.setInt("equirectangularMap", 0);
     equirectangularToCubemapShader.setMat4("projection", captureProjection);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, hdrTexture);
+    GLState::ActiveTexture(GL_TEXTURE0);
+    GLState::BindTexture(GL_TEXTURE_2D, hdrTexture);
 
     glViewport(0, 0, 512, 512);
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     for (unsigned int i = 0; i < 6; ++i)
     {
         equirectangularToCubemapShader.setMat4("view", captureViews[i]);
@@ -186,16 +186,16 @@ int main(){
 
         renderCube();
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
         //mipmap생성
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
         //irradiance 큐브맵
     unsigned int irradianceMap;
     glGenTextures(1, &irradianceMap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 32, 32, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -206,7 +206,7 @@ int main(){
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 32, 32);
 
@@ -214,11 +214,11 @@ int main(){
     irradianceShader.use();
     irradianceShader.setInt("environmentMap", 0);
     irradianceShader.setMat4("projection", captureProjection);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    GLState::ActiveTexture(GL_TEXTURE0);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
 
     glViewport(0, 0, 32, 32);
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     for (unsigned int i = 0; i < 6; ++i)
     {
         irradianceShader.setMat4("view", captureViews[i]);
@@ -227,12 +227,12 @@ int main(){
 
         renderCube();
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     //PBR Pre Filter cubemap----------------------------------------------------------------
     unsigned int prefilterMap;
     glGenTextures(1, &prefilterMap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
     for (unsigned int i = 0; i < 6; ++i)
     {
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, 128, 128, 0, GL_RGB, GL_FLOAT, nullptr);
@@ -248,10 +248,10 @@ int main(){
     prefilterShader.use();
     prefilterShader.setInt("environmentMap", 0);
     prefilterShader.setMat4("projection", captureProjection);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+    GLState::ActiveTexture(GL_TEXTURE0);
+    GLState::BindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     unsigned int maxMipLevels = 5;
     for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
     {
@@ -273,20 +273,20 @@ int main(){
             renderCube();
         }
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     // 2D LUT ------------------------------------------------------------------------------------------
     unsigned int brdfLUTTexture;
     glGenTextures(1, &brdfLUTTexture);
 
-    glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
+    GLState::BindTexture(GL_TEXTURE_2D, brdfLUTTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdfLUTTexture, 0);
@@ -296,14 +296,22 @@ int main(){
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     renderQuad();
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
 
     //렌더링 루프 이전에 모든 구성요소들 초기화
     glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
     pbrShader.use();
+    pbrShader.setInt("irradianceMap", 0);
+    pbrShader.setInt("prefilterMap", 1);
+    pbrShader.setInt("brdfLUT", 2);
+    pbrShader.setVec3("albedo", 0.5f, 0.0f, 0.0f);
+    pbrShader.setFloat("ao", 1.0f);
     pbrShader.setMat4("projection", projection);
     backgroundShader.use();
+    backgroundShader.setInt("environmentMap", 0);
     backgroundShader.setMat4("projection", projection);
+    //첫 실행(compile)과 두 번째 실행(binary 복원)의 시작 시간 비교 (모든 program을 한 번씩 쓴 뒤)
+    SharedShaderCacheStats().Print();
 
     //프레임버퍼에 초기 스크린크기 전달
     int scrWidth, scrHeight;
@@ -334,14 +342,16 @@ int main(){
         glm::mat4 view = camera.GetViewMatrix();
         pbrShader.setMat4("view", view);
         pbrShader.setVec3("camPos", camera.Position);
+        //광원은 고정이라 처음 프레임에만 실제로 업로드됨 (바뀐 광원만 올림)
+        lights.Upload();
 
         // bind pre-computed IBL data
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
+        GLState::ActiveTexture(GL_TEXTURE1);
+        GLState::BindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
+        GLState::ActiveTexture(GL_TEXTURE2);
+        GLState::BindTexture(GL_TEXTURE_2D, brdfLUTTexture);
 
         // render rows*column number of spheres with varying metallic/roughness values scaled by rows and columns respectively
         glm::mat4 model = glm::mat4(1.0f);
@@ -369,15 +379,10 @@ int main(){
         // render light source (simply re-render sphere at light positions)
         // this looks a bit off as we use the same shader, but it'll make their positions obvious and 
         // keeps the codeprint small.
-        for (unsigned int i = 0; i < sizeof(lightPositions) / sizeof(lightPositions[0]); ++i)
+        for (unsigned int i = 0; i < lights.Count(); ++i)
         {
-            glm::vec3 newPos = lightPositions[i] + glm::vec3(sin(glfwGetTime() * 5.0) * 5.0, 0.0, 0.0);
-            newPos = lightPositions[i];
-            pbrShader.setVec3("lightPositions[" + std::to_string(i) + "]", newPos);
-            pbrShader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
-
             model = glm::mat4(1.0f);
-            model = glm::translate(model, newPos);
+            model = glm::translate(model, lights.Position(i));
             model = glm::scale(model, glm::vec3(0.5f));
             pbrShader.setMat4("model", model);
             renderSphere();
@@ -386,10 +391,10 @@ int main(){
         // render skybox (render as last to prevent overdraw)
         backgroundShader.use();
         backgroundShader.setMat4("view", view);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-        //glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap); // display irradiance map
-        //glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap); // display prefilter map
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
+        //GLState::BindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap); // display irradiance map
+        //GLState::BindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap); // display prefilter map
         renderCube();
 
 
@@ -532,10 +537,10 @@ void renderSphere()
                 data.push_back(uv[i].y);
             }
         }
-        glBindVertexArray(sphereVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        GLState::BindVertexArray(sphereVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, vbo);
         glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), &data[0], GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
         unsigned int stride = (3 + 2 + 3) * sizeof(float);
         glEnableVertexAttribArray(0);
@@ -546,7 +551,7 @@ void renderSphere()
 		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));        
     }
 
-    glBindVertexArray(sphereVAO);
+    GLState::BindVertexArray(sphereVAO);
     glDrawElements(GL_TRIANGLE_STRIP, indexCount, GL_UNSIGNED_INT, 0);
 }
 //큐브 렌더링
@@ -604,23 +609,22 @@ void renderCube()
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
         // fill buffer
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, cubeVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         // link vertex attributes
-        glBindVertexArray(cubeVAO);
+        GLState::BindVertexArray(cubeVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // render Cube
-    glBindVertexArray(cubeVAO);
+    GLState::BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
 }
 //쿼드 렌더링
 unsigned int quadVAO = 0;
@@ -639,15 +643,14 @@ void renderQuad()
         // setup plane VAO
         glGenVertexArrays(1, &quadVAO);
         glGenBuffers(1, &quadVBO);
-        glBindVertexArray(quadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        GLState::BindVertexArray(quadVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     }
-    glBindVertexArray(quadVAO);
+    GLState::BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 }
@@ -55,9 +55,9 @@ int main()
     }
 
     //각성 Enable 설정
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::Enable(GL_CULL_FACE);
+    GLState::Enable(GL_BLEND);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     //Shader 작성-----------------------------------------------------
     Shader shader("src/shaders/18shader.vs", "src/shaders/18shader.fs");
@@ -106,7 +106,7 @@ int main()
             // generate texture
             unsigned int texture;
             glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
+            GLState::BindTexture(GL_TEXTURE_2D, texture);
             glTexImage2D(
                 GL_TEXTURE_2D,
                 0,
@@ -132,7 +132,7 @@ int main()
             };
             Characters.insert(std::pair<char, Character>(c, character));
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::BindTexture(GL_TEXTURE_2D, 0);
     }
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
@@ -141,13 +141,13 @@ int main()
     //쿼드 VAO, VBO -----------------------------------------------------
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    GLState::BindVertexArray(VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindVertexArray(0);
 
     //렌더링 루프
     while (!glfwWindowShouldClose(window))
@@ -187,8 +187,8 @@ void RenderText(Shader &shader, std::string text, float x, float y, float scale,
     // activate corresponding render state	
     shader.use();
     glUniform3f(glGetUniformLocation(shader.ID, "textColor"), color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    GLState::ActiveTexture(GL_TEXTURE0);
+    GLState::BindVertexArray(VAO);
 
     // iterate through all characters
     std::string::const_iterator c;
@@ -212,17 +212,17 @@ void RenderText(Shader &shader, std::string text, float x, float y, float scale,
             { xpos + w, ypos + h,   1.0f, 0.0f }           
         };
         // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+        GLState::BindTexture(GL_TEXTURE_2D, ch.TextureID);
         // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // be sure to use glBufferSubData and not glBufferData
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
         // render quad
         glDrawArrays(GL_TRIANGLES, 0, 6);
         // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::BindVertexArray(0);
+    GLState::BindTexture(GL_TEXTURE_2D, 0);
 }
@@ -137,6 +137,11 @@ private:
     PostProcessor *Effects;
     ISoundEngine *SoundEngine = createIrrKlangDevice();
     TextRenderer *Text;
+    //sprite draw 정렬 queue (layer 안에서 텍스처별로 모아서 그림)
+    RenderQueue SpriteQueue;
+    RenderQueueStats SpriteStats;
+    unsigned int SpriteFrames = 0;
+    float SpriteReportTime = 0.0f;
 
 public:
     // game state
@@ -161,6 +166,7 @@ public:
         delete Player;
         delete Ball;
         delete Particles;
+        Effects->PostProcessingShaders.Print();
         delete Effects;
         SoundEngine->drop();
     }
@@ -168,17 +174,9 @@ public:
     // initialize game state (load all shaders/textures/levels)
     void Init()
     {
-        // load shaders
+        // load shaders (only issued here; the driver compiles them while the textures below load)
         ResourceManager::LoadShader("src/shaders/19sprite.vs", "src/shaders/19sprite.fs", nullptr, "sprite");
         ResourceManager::LoadShader("src/shaders/19particle.vs", "src/shaders/19particle.fs", nullptr, "particle");
-        ResourceManager::LoadShader("src/shaders/19postprocessing.vs", "src/shaders/19postprocessing.fs", nullptr, "postprocessing");
-        // configure shaders
-        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->Width), 
-            static_cast<float>(this->Height), 0.0f, -1.0f, 1.0f);
-        ResourceManager::GetShader("sprite").Use().SetInteger("image", 0);
-        ResourceManager::GetShader("sprite").SetMatrix4("projection", projection);
-        ResourceManager::GetShader("particle").Use().SetInteger("sprite", 0);
-        ResourceManager::GetShader("particle").SetMatrix4("projection", projection); 
         // load textures
         ResourceManager::LoadTexture("textures/awesomeface.png", true, "face");
         ResourceManager::LoadTexture("textures/block.png", false, "block");
@@ -192,13 +190,22 @@ public:
         ResourceManager::LoadTexture("textures/powerups/powerup_passthrough.png", true, "powerup_passthrough");
         ResourceManager::LoadTexture("textures/powerups/powerup_speed.png", true, "powerup_speed");
         ResourceManager::LoadTexture("textures/powerups/powerup_sticky.png", true, "powerup_sticky");
+        TextureCache::PrintStats();
+        // configure shaders (first use, checks their compile/link status)
+        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->Width), 
+            static_cast<float>(this->Height), 0.0f, -1.0f, 1.0f);
+        ResourceManager::GetShader("sprite").Use().SetInteger("image", 0);
+        ResourceManager::GetShader("sprite").SetMatrix4("projection", projection);
+        ResourceManager::GetShader("particle").Use().SetInteger("sprite", 0);
+        ResourceManager::GetShader("particle").SetMatrix4("projection", projection); 
         // set render-specific controls
         Shader renderershader = ResourceManager::GetShader("sprite");
         Renderer = new SpriteRenderer(renderershader);
         Shader particleshader = ResourceManager::GetShader("particle");
         Particles = new ParticleGenerator(particleshader, ResourceManager::GetTexture("particle"), 500);
-        Shader effectshader = ResourceManager::GetShader("postprocessing");
-        Effects = new PostProcessor(effectshader, this->Width, this->Height);
+        Effects = new PostProcessor("src/shaders/19postprocessing.vs", "src/shaders/19postprocessing.fs", this->Width, this->Height);
+        // cold start compiles and writes shader_cache/, warm start loads the program binaries
+        SharedShaderCacheStats().Print();
         // load levels
         GameLevel one; one.Load("resources/gamelevel/1.txt", this->Width, this->Height / 2);
         GameLevel two; two.Load("resources/gamelevel/2.txt", this->Width, this->Height / 2);
@@ -564,21 +571,40 @@ public:
         {
             // begin rendering to postprocessing framebuffer
             Effects->BeginRender();
+                // sprite는 queue에 모았다가 layer 순서, layer 안에서는 텍스처 순서로 그림
+                Renderer->Queue = &SpriteQueue;
                 // draw background
+                Renderer->Layer = 0;
                 Texture2D background = ResourceManager::GetTexture("background");
                 Renderer->DrawSprite(background, glm::vec2(0.0f, 0.0f), glm::vec2(this->Width, this->Height), 0.0f);
                 // draw level
+                Renderer->Layer = 1;
                 this->Levels[this->Level].Draw(*Renderer);
                 // draw player
+                Renderer->Layer = 2;
                 Player->Draw(*Renderer);
                 // draw PowerUps
                 for (PowerUp &powerUp : this->PowerUps)
                     if (!powerUp.Destroyed)
                         powerUp.Draw(*Renderer);   
-                // draw particlse
+                SpriteQueue.Flush(SpriteStats);
+                // draw particlse (particle은 따로 그리므로 ball보다 먼저 flush)
                 Particles->Draw();
                 // draw ball
                 Ball->Draw(*Renderer);
+                SpriteQueue.Flush(SpriteStats);
+                Renderer->Queue = nullptr;
+                // 1초마다 sprite 상태 변경 횟수와 GL 상태 호출 수 출력
+                SpriteFrames++;
+                if (glfwGetTime() - SpriteReportTime >= 1.0)
+                {
+                    SpriteStats.Print("sprites", SpriteFrames);
+                    SpriteStats.Reset();
+                    GLState::Stats().Print("breakout", SpriteFrames);
+                    GLState::Stats().Reset();
+                    SpriteFrames = 0;
+                    SpriteReportTime = (float)glfwGetTime();
+                }
             // end rendering to postprocessing framebuffer
             Effects->EndRender();
             // render postprocessing quad
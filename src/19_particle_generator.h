@@ -8,6 +8,7 @@
 #include "19_shader.h"
 #include "19_texture.h"
 #include "19_game_object.h"
+#include "gl_state.h"
 
 
 // Represents a single particle and its state
@@ -57,7 +58,7 @@ public:
     void Draw()
     {
         // use additive blending to give it a 'glow' effect
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE);
         this->shader.Use();
         for (Particle particle : this->particles)
         {
@@ -66,13 +67,12 @@ public:
                 this->shader.SetVector2f("offset", particle.Position);
                 this->shader.SetVector4f("color", particle.Color);
                 this->texture.Bind();
-                glBindVertexArray(this->VAO);
+                GLState::BindVertexArray(this->VAO);
                 glDrawArrays(GL_TRIANGLES, 0, 6);
-                glBindVertexArray(0);
             }
         }
         // don't forget to reset to default blending mode
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
 
 private:
@@ -100,14 +100,14 @@ private:
         }; 
         glGenVertexArrays(1, &this->VAO);
         glGenBuffers(1, &VBO);
-        glBindVertexArray(this->VAO);
+        GLState::BindVertexArray(this->VAO);
         // fill mesh buffer
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(particle_quad), particle_quad, GL_STATIC_DRAW);
         // set mesh attributes
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-        glBindVertexArray(0);
+        GLState::BindVertexArray(0);
 
         // create this->amount default particle instances
         for (unsigned int i = 0; i < this->amount; ++i)
@@ -8,78 +8,64 @@
 #include "19_texture.h"
 #include "19_sprite_renderer.h"
 #include "19_shader.h"
+#include "19_resource_manager.h"
+#include "shader_permutation.h"
+#include "gl_state.h"
 
 
 // PostProcessor hosts all PostProcessing effects for the Breakout
 // Game. It renders the game on a textured quad after which one can
 // enable specific effects by enabling either the Confuse, Chaos or 
-// Shake boolean. 
+// Shake boolean. Every combination of effects is its own shader
+// variant (compiled on first use), so the shaders don't branch on them.
 // It is required to call BeginRender() before rendering the game
 // and EndRender() after rendering the game for the class to work.
+enum PostProcessEffect {
+    POSTPROCESS_CHAOS   = 1 << 0,
+    POSTPROCESS_CONFUSE = 1 << 1,
+    POSTPROCESS_SHAKE   = 1 << 2
+};
+
 class PostProcessor
 {
 public:
     // state
-    Shader PostProcessingShader;
+    ShaderPermutations<Shader> PostProcessingShaders;
     Texture2D Texture;
     unsigned int Width, Height;
     // options
     bool Confuse, Chaos, Shake;
     // constructor
-    PostProcessor(Shader shader, unsigned int width, unsigned int height)
-        : PostProcessingShader(shader), Texture(), Width(width), Height(height), Confuse(false), Chaos(false), Shake(false)
+    PostProcessor(const char *vShaderFile, const char *fShaderFile, unsigned int width, unsigned int height)
+        : PostProcessingShaders("postprocessing", { "CHAOS", "CONFUSE", "SHAKE" }, variantBuilder(vShaderFile, fShaderFile)),
+          Texture(), Width(width), Height(height), Confuse(false), Chaos(false), Shake(false)
     {
         // initialize renderbuffer/framebuffer object
         glGenFramebuffers(1, &this->MSFBO);
         glGenFramebuffers(1, &this->FBO);
         glGenRenderbuffers(1, &this->RBO);
         // initialize renderbuffer storage with a multisampled color buffer (don't need a depth/stencil buffer)
-        glBindFramebuffer(GL_FRAMEBUFFER, this->MSFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, this->MSFBO);
         glBindRenderbuffer(GL_RENDERBUFFER, this->RBO);
         glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGB, width, height); // allocate storage for render buffer object
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->RBO); // attach MS render buffer object to framebuffer
         if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
             std::cout << "ERROR::POSTPROCESSOR: Failed to initialize MSFBO" << std::endl;
         // also initialize the FBO/texture to blit multisampled color-buffer to; used for shader operations (for postprocessing effects)
-        glBindFramebuffer(GL_FRAMEBUFFER, this->FBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, this->FBO);
         this->Texture.Generate(width, height, NULL);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, this->Texture.ID, 0); // attach texture to framebuffer as its color attachment
         if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
             std::cout << "ERROR::POSTPROCESSOR: Failed to initialize FBO" << std::endl;
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        // initialize render data and uniforms
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
+        // initialize render data; the plain (no effect) variant is built up front, the others when first enabled
         this->initRenderData();
-        this->PostProcessingShader.SetInteger("scene", 0, true);
-        float offset = 1.0f / 300.0f;
-        float offsets[9][2] = {
-            { -offset,  offset  },  // top-left
-            {  0.0f,    offset  },  // top-center
-            {  offset,  offset  },  // top-right
-            { -offset,  0.0f    },  // center-left
-            {  0.0f,    0.0f    },  // center-center
-            {  offset,  0.0f    },  // center - right
-            { -offset, -offset  },  // bottom-left
-            {  0.0f,   -offset  },  // bottom-center
-            {  offset, -offset  }   // bottom-right    
-        };
-        glUniform2fv(glGetUniformLocation(this->PostProcessingShader.ID, "offsets"), 9, (float*)offsets);
-        int edge_kernel[9] = {
-            -1, -1, -1,
-            -1,  8, -1,
-            -1, -1, -1
-        };
-        glUniform1iv(glGetUniformLocation(this->PostProcessingShader.ID, "edge_kernel"), 9, edge_kernel);
-        float blur_kernel[9] = {
-            1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
-            2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
-            1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
-        };
-        glUniform1fv(glGetUniformLocation(this->PostProcessingShader.ID, "blur_kernel"), 9, blur_kernel);    
+        this->PostProcessingShaders.Get(0);
     }
     // prepares the postprocessor's framebuffer operations before rendering the game
     void BeginRender()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, this->MSFBO);
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, this->MSFBO);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
     }
@@ -87,26 +73,24 @@ public:
     void EndRender()
     {
         // now resolve multisampled color-buffer into intermediate FBO to store to texture
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->MSFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->FBO);
+        GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, this->MSFBO);
+        GLState::BindFramebuffer(GL_DRAW_FRAMEBUFFER, this->FBO);
         glBlitFramebuffer(0, 0, this->Width, this->Height, 0, 0, this->Width, this->Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0); // binds both READ and WRITE framebuffer to default framebuffer
+        GLState::BindFramebuffer(GL_FRAMEBUFFER, 0); // binds both READ and WRITE framebuffer to default framebuffer
     }
     // renders the PostProcessor texture quad (as a screen-encompassing large sprite)
     void Render(float time)
     {
-        // set uniforms/options
-        this->PostProcessingShader.Use();
-        this->PostProcessingShader.SetFloat("time", time);
-        this->PostProcessingShader.SetInteger("confuse", this->Confuse);
-        this->PostProcessingShader.SetInteger("chaos", this->Chaos);
-        this->PostProcessingShader.SetInteger("shake", this->Shake);
+        // pick the variant for the enabled effects (chaos takes precedence over confuse)
+        unsigned int effects = (this->Chaos ? POSTPROCESS_CHAOS : (this->Confuse ? POSTPROCESS_CONFUSE : 0)) | (this->Shake ? POSTPROCESS_SHAKE : 0);
+        Shader &shader = this->PostProcessingShaders.Get(effects);
+        shader.Use();
+        shader.SetFloat("time", time);
         // render textured quad
-        glActiveTexture(GL_TEXTURE0);
+        GLState::ActiveTexture(GL_TEXTURE0);
         this->Texture.Bind();	
-        glBindVertexArray(this->VAO);
+        GLState::BindVertexArray(this->VAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
     }
 
 private:
@@ -114,6 +98,41 @@ private:
     unsigned int MSFBO, FBO; // MSFBO = Multisampled FBO. FBO is regular, used for blitting MS color-buffer to texture
     unsigned int RBO; // RBO is used for multisampled color buffer
     unsigned int VAO;
+    // compiles one effect variant and sets its constant uniforms
+    static ShaderPermutations<Shader>::Builder variantBuilder(std::string vShaderFile, std::string fShaderFile)
+    {
+        return [vShaderFile, fShaderFile](const ShaderDefines &defines)
+        {
+            Shader shader = ResourceManager::LoadShader(vShaderFile.c_str(), fShaderFile.c_str(), nullptr, "postprocessing " + defines.Label(), defines);
+            shader.SetInteger("scene", 0, true);
+            float offset = 1.0f / 300.0f;
+            float offsets[9][2] = {
+                { -offset,  offset  },  // top-left
+                {  0.0f,    offset  },  // top-center
+                {  offset,  offset  },  // top-right
+                { -offset,  0.0f    },  // center-left
+                {  0.0f,    0.0f    },  // center-center
+                {  offset,  0.0f    },  // center - right
+                { -offset, -offset  },  // bottom-left
+                {  0.0f,   -offset  },  // bottom-center
+                {  offset, -offset  }   // bottom-right    
+            };
+            glUniform2fv(glGetUniformLocation(shader.ID, "offsets"), 9, (float*)offsets);
+            int edge_kernel[9] = {
+                -1, -1, -1,
+                -1,  8, -1,
+                -1, -1, -1
+            };
+            glUniform1iv(glGetUniformLocation(shader.ID, "edge_kernel"), 9, edge_kernel);
+            float blur_kernel[9] = {
+                1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
+                2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
+                1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
+            };
+            glUniform1fv(glGetUniformLocation(shader.ID, "blur_kernel"), 9, blur_kernel);
+            return shader;
+        };
+    }
     // initialize quad for rendering postprocessing texture
     void initRenderData()
     {
@@ -132,14 +151,14 @@ private:
         glGenVertexArrays(1, &this->VAO);
         glGenBuffers(1, &VBO);
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-        glBindVertexArray(this->VAO);
+        GLState::BindVertexArray(this->VAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
 };
 
@@ -11,9 +11,12 @@
 
 #include "19_texture.h"
 #include "19_shader.h"
+#include "shader_source.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include "texture_cache.h"
+#include "gl_state.h"
 
 // resource storage
 static std::map<std::string, Shader>    Shaders;
@@ -29,9 +32,12 @@ class ResourceManager
 public:
     
     // loads (and generates) a shader program from file loading vertex, fragment (and geometry) shader's source code. If gShaderFile is not nullptr, it also loads a geometry shader
-    static Shader LoadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name)
+    // defines are inserted right after #version (used to build specialized shader variants)
+    // the build is only issued here; its status is checked the first time the shader is used
+    // (load textures etc. in between so the driver compiles meanwhile)
+    static Shader LoadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name, const ShaderDefines &defines = ShaderDefines())
     {
-        Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
+        Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile, defines);
         return Shaders[name];
     }
     // retrieves a stored shader
@@ -56,60 +62,34 @@ public:
     {
         // (properly) delete all shaders	
         for (auto iter : Shaders)
-            glDeleteProgram(iter.second.ID);
-        // (properly) delete all textures
+            GLState::DeleteProgram(iter.second.ID);
+        // (properly) release all textures, the shared cache deletes them once unused
         for (auto iter : Textures)
-            glDeleteTextures(1, &iter.second.ID);
+            TextureCache::Release(iter.second.ID);
     }
 
 private:
     // private constructor, that is we do not want any actual resource manager objects. Its members and functions should be publicly available (static).
     ResourceManager() { }
     // loads and generates a shader from file
-    static Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr)
+    static Shader loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr, const ShaderDefines &defines = ShaderDefines())
     {
-        // 1. retrieve the vertex/fragment source code from filePath
-        std::string vertexCode;
-        std::string fragmentCode;
+        // 1. retrieve the vertex/fragment source code from filePath (expanding #include and injecting defines)
+        std::string vertexCode = ShaderSource::Load(vShaderFile, defines);
+        std::string fragmentCode = ShaderSource::Load(fShaderFile, defines);
         std::string geometryCode;
-        try
-        {
-            // open files
-            std::ifstream vertexShaderFile(vShaderFile);
-            std::ifstream fragmentShaderFile(fShaderFile);
-            std::stringstream vShaderStream, fShaderStream;
-            // read file's buffer contents into streams
-            vShaderStream << vertexShaderFile.rdbuf();
-            fShaderStream << fragmentShaderFile.rdbuf();
-            // close file handlers
-            vertexShaderFile.close();
-            fragmentShaderFile.close();
-            // convert stream into string
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-            // if geometry shader path is present, also load a geometry shader
-            if (gShaderFile != nullptr)
-            {
-                std::ifstream geometryShaderFile(gShaderFile);
-                std::stringstream gShaderStream;
-                gShaderStream << geometryShaderFile.rdbuf();
-                geometryShaderFile.close();
-                geometryCode = gShaderStream.str();
-            }
-        }
-        catch (std::exception e)
-        {
-            std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
-        }
+        // if geometry shader path is present, also load a geometry shader
+        if (gShaderFile != nullptr)
+            geometryCode = ShaderSource::Load(gShaderFile, defines);
         const char *vShaderCode = vertexCode.c_str();
         const char *fShaderCode = fragmentCode.c_str();
         const char *gShaderCode = geometryCode.c_str();
         // 2. now create shader object from source code
         Shader shader;
-        shader.Compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
+        shader.CompileAsync(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
         return shader;
     }
-    // loads a single texture from file
+    // loads a single texture from file (through the process-wide TextureCache)
     static Texture2D loadTextureFromFile(const char *file, bool alpha)
     {
         // create texture object
@@ -119,13 +99,12 @@ private:
             texture.Internal_Format = GL_RGBA;
             texture.Image_Format = GL_RGBA;
         }
-        // load image
-        int width, height, nrChannels;
-        unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
-        // now generate texture
-        texture.Generate(width, height, data);
-        // and finally free image data
-        stbi_image_free(data);
+        // the cache owns the GL texture, so drop the one generated by the constructor
+        TextureInfo info = TextureCache::Acquire(file, TEXTURE_NO_MIPMAP | (alpha ? TEXTURE_FORCE_RGBA : TEXTURE_FORCE_RGB));
+        GLState::DeleteTextures(1, &texture.ID);
+        texture.ID = info.ID;
+        texture.Width = info.Width;
+        texture.Height = info.Height;
         return texture;
     }
 };
@@ -3,11 +3,16 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "gl_state.h"
+#include "shader_build.h"
+#include "uniform_table.h"
+
 
 // General purpsoe shader object. Compiles from file, generates
 // compile/link-time error messages and hosts several utility 
@@ -22,106 +27,146 @@ public:
     // sets the current shader as active
     Shader  &Use()
     {
-        glUseProgram(this->ID);
+        this->finish();
+        GLState::UseProgram(this->ID);
         return *this;
     }
     // compiles the shader from given source code
     void    Compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr)
     {
-        unsigned int sVertex, sFragment, gShader;
-        // vertex Shader
-        sVertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(sVertex, 1, &vertexSource, NULL);
-        glCompileShader(sVertex);
-        checkCompileErrors(sVertex, "VERTEX");
-        // fragment Shader
-        sFragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(sFragment, 1, &fragmentSource, NULL);
-        glCompileShader(sFragment);
-        checkCompileErrors(sFragment, "FRAGMENT");
-        // if geometry shader source code is given, also compile geometry shader
-        if (geometrySource != nullptr)
-        {
-            gShader = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(gShader, 1, &geometrySource, NULL);
-            glCompileShader(gShader);
-            checkCompileErrors(gShader, "GEOMETRY");
-        }
-        // shader program
-        this->ID = glCreateProgram();
-        glAttachShader(this->ID, sVertex);
-        glAttachShader(this->ID, sFragment);
-        if (geometrySource != nullptr)
-            glAttachShader(this->ID, gShader);
-        glLinkProgram(this->ID);
-        checkCompileErrors(this->ID, "PROGRAM");
-        // delete the shaders as they're linked into our program now and no longer necessary
-        glDeleteShader(sVertex);
-        glDeleteShader(sFragment);
-        if (geometrySource != nullptr)
-            glDeleteShader(gShader);
+        this->CompileAsync(vertexSource, fragmentSource, geometrySource);
+        this->finish();
+    }
+    // issues the compile/link and returns immediately; status is checked when the shader is first used,
+    // so the driver can build it (in parallel with KHR_parallel_shader_compile) while other assets load
+    void    CompileAsync(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr)
+    {
+        // reuses the binary linked by an earlier run if sources and driver are unchanged (shader_cache.h)
+        const char *sources[3] = { vertexSource, fragmentSource, geometrySource };
+        this->build = ShaderBuild::Start(sources, std::string());
+        this->ID = this->build->program;
+    }
+    // true once linking is done, without waiting (always true without KHR_parallel_shader_compile)
+    bool    Ready() const
+    {
+        return !this->build || this->build->Ready();
     }
 
     // utility functions
+    // names are looked up in the table reflected at link time and unchanged values are not re-uploaded
     void    SetFloat    (const char *name, float value, bool useShader = false)
     {
-        if (useShader)
-            this->Use();
-        glUniform1f(glGetUniformLocation(this->ID, name), value);
+        this->SetFloat(this->GetUniform(name), value, useShader);
     }
     void    SetInteger  (const char *name, int value, bool useShader = false)
     {
-        if (useShader)
-            this->Use();
-        glUniform1i(glGetUniformLocation(this->ID, name), value);
+        this->SetInteger(this->GetUniform(name), value, useShader);
     }
     void    SetVector2f (const char *name, float x, float y, bool useShader = false)
     {
-        if (useShader)
-            this->Use();
-        glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+        this->SetVector2f(this->GetUniform(name), glm::vec2(x, y), useShader);
     }
     void    SetVector2f (const char *name, const glm::vec2 &value, bool useShader = false)
+    {
+        this->SetVector2f(this->GetUniform(name), value, useShader);
+    }
+    void    SetVector3f (const char *name, float x, float y, float z, bool useShader = false)
+    {
+        this->SetVector3f(this->GetUniform(name), glm::vec3(x, y, z), useShader);
+    }
+    void    SetVector3f (const char *name, const glm::vec3 &value, bool useShader = false)
+    {
+        this->SetVector3f(this->GetUniform(name), value, useShader);
+    }
+    void    SetVector4f (const char *name, float x, float y, float z, float w, bool useShader = false)
+    {
+        this->SetVector4f(this->GetUniform(name), glm::vec4(x, y, z, w), useShader);
+    }
+    void    SetVector4f (const char *name, const glm::vec4 &value, bool useShader = false)
+    {
+        this->SetVector4f(this->GetUniform(name), value, useShader);
+    }
+    void    SetMatrix4  (const char *name, const glm::mat4 &matrix, bool useShader = false)
+    {
+        this->SetMatrix4(this->GetUniform(name), matrix, useShader);
+    }
+
+    // pre-resolved handles for uniforms set every frame (skips the name hash too)
+    UniformHandle GetUniform(const char *name) const
+    {
+        UniformTable *table = this->table();
+        return table ? table->Find(name) : UniformHandle();
+    }
+    void    SetFloat    (UniformHandle uniform, float value, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+        if (this->changed(uniform, &value, sizeof(value)))
+            glUniform1f(this->table()->Location(uniform), value);
     }
-    void    SetVector3f (const char *name, float x, float y, float z, bool useShader = false)
+    void    SetInteger  (UniformHandle uniform, int value, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+        if (this->changed(uniform, &value, sizeof(value)))
+            glUniform1i(this->table()->Location(uniform), value);
     }
-    void    SetVector3f (const char *name, const glm::vec3 &value, bool useShader = false)
+    void    SetVector2f (UniformHandle uniform, const glm::vec2 &value, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+        if (this->changed(uniform, glm::value_ptr(value), sizeof(value)))
+            glUniform2f(this->table()->Location(uniform), value.x, value.y);
     }
-    void    SetVector4f (const char *name, float x, float y, float z, float w, bool useShader = false)
+    void    SetVector3f (UniformHandle uniform, const glm::vec3 &value, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+        if (this->changed(uniform, glm::value_ptr(value), sizeof(value)))
+            glUniform3f(this->table()->Location(uniform), value.x, value.y, value.z);
     }
-    void    SetVector4f (const char *name, const glm::vec4 &value, bool useShader = false)
+    void    SetVector4f (UniformHandle uniform, const glm::vec4 &value, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+        if (this->changed(uniform, glm::value_ptr(value), sizeof(value)))
+            glUniform4f(this->table()->Location(uniform), value.x, value.y, value.z, value.w);
     }
-    void    SetMatrix4  (const char *name, const glm::mat4 &matrix, bool useShader = false)
+    void    SetMatrix4  (UniformHandle uniform, const glm::mat4 &matrix, bool useShader = false)
     {
         if (useShader)
             this->Use();
-        glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+        if (this->changed(uniform, glm::value_ptr(matrix), sizeof(matrix)))
+            glUniformMatrix4fv(this->table()->Location(uniform), 1, false, glm::value_ptr(matrix));
     }
 
     
 private:
+    std::shared_ptr<ShaderBuild> build;   // shared by copies of this shader (holds the uniform table)
+
+    // checks the compile/link status once, on first use
+    void    finish() const
+    {
+        if (this->build && !this->build->Finished())
+            this->build->Finish([](unsigned int object, const char *type) { checkCompileErrors(object, type); });
+    }
+    UniformTable *table() const
+    {
+        this->finish();
+        return this->build ? this->build->uniforms.get() : nullptr;
+    }
+    // counts the set even before Compile() (no table yet)
+    bool    changed(UniformHandle uniform, const void *value, unsigned int bytes)
+    {
+        UniformTable *table = this->table();
+        if (table)
+            return table->Changed(uniform, value, bytes);
+        SharedUniformStats().sets++;
+        SharedUniformStats().inactive++;
+        return false;
+    }
     // checks if compilation or linking failed and if so, print the error logs
-    void    checkCompileErrors(unsigned int object, std::string type)
+    static void checkCompileErrors(unsigned int object, std::string type)
     {
         int success;
         char infoLog[1024];
@@ -7,21 +7,31 @@
 
 #include "19_texture.h"
 #include "19_shader.h"
+#include "render_queue.h"
+#include "gl_state.h"
 
 
 class SpriteRenderer
 {
 public:
+    // When set, DrawSprite submits into this queue instead of drawing immediately
+    RenderQueue *Queue;
+    // Sort pass for queued sprites: lower layers are drawn first
+    unsigned int Layer;
+
     // Constructor (inits shaders/shapes)
     SpriteRenderer(Shader &shader)
+        : Queue(nullptr), Layer(0)
     {
         this->shader = shader;
         this->initRenderData();
+        this->modelLocation = glGetUniformLocation(this->shader.ID, "model");
+        this->colorLocation = glGetUniformLocation(this->shader.ID, "spriteColor");
     }
     // Destructor
     ~SpriteRenderer()
     {
-        glDeleteVertexArrays(1, &this->quadVAO);
+        GLState::DeleteVertexArrays(1, &this->quadVAO);
     }
 
     // Renders a defined quad textured with given sprite
@@ -38,22 +48,47 @@ public:
         //스케일
         model = glm::scale(model, glm::vec3(size, 1.0f));
 
+        if (this->Queue)
+        {
+            // same layer sprites are grouped by texture, equal keys keep submission order
+            RenderCommand command = RenderQueue::Command();
+            command.key = RenderQueue::MakeKey(this->Layer, false, this->shader.ID, texture.ID, 0);
+            command.program = this->shader.ID;
+            command.vao = this->quadVAO;
+            command.texture = texture.ID;
+            command.count = 6;
+            command.modelLocation = this->modelLocation;
+            command.model = model;
+            command.color = glm::vec4(color, 1.0f);
+            command.uniforms = applySpriteColor;
+            command.object = this;
+            this->Queue->Submit(command);
+            return;
+        }
+
         this->shader.SetMatrix4("model", model);
 
         // render textured quad
         this->shader.SetVector3f("spriteColor", color);
 
-        glActiveTexture(GL_TEXTURE0);
+        GLState::ActiveTexture(GL_TEXTURE0);
         texture.Bind();
 
-        glBindVertexArray(this->quadVAO);
+        GLState::BindVertexArray(this->quadVAO);
         glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
     }
 private:
     // Render state
     Shader shader; 
     unsigned int quadVAO;
+    int modelLocation, colorLocation;
+    // sets the per-sprite color when a queued sprite is drawn
+    static void applySpriteColor(const RenderCommand &command)
+    {
+        const SpriteRenderer *renderer = (const SpriteRenderer*)command.object;
+        glUniform3fv(renderer->colorLocation, 1, &command.color[0]);
+        UniformTable::Forget(command.program, renderer->colorLocation);
+    }
     // Initializes and configures the quad's buffer and vertex attributes
     void initRenderData()
     {
@@ -73,14 +108,14 @@ private:
         glGenVertexArrays(1, &this->quadVAO);
         glGenBuffers(1, &VBO);
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-        glBindVertexArray(this->quadVAO);
+        GLState::BindVertexArray(this->quadVAO);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
 };
 
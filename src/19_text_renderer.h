@@ -12,6 +12,7 @@
 #include "19_texture.h"
 #include "19_shader.h"
 #include "19_resource_manager.h"
+#include "gl_state.h"
 
 
 /// Holds all state information relevant to a character as loaded using FreeType
@@ -43,13 +44,13 @@ public:
         // configure VAO/VBO for texture quads
         glGenVertexArrays(1, &this->VAO);
         glGenBuffers(1, &this->VBO);
-        glBindVertexArray(this->VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        GLState::BindVertexArray(this->VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+        GLState::BindVertexArray(0);
     }
     // pre-compiles a list of characters from the given font
     void Load(std::string font, unsigned int fontSize)
@@ -80,7 +81,7 @@ public:
             // generate texture
             unsigned int texture;
             glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
+            GLState::BindTexture(GL_TEXTURE_2D, texture);
             glTexImage2D(
                 GL_TEXTURE_2D,
                 0,
@@ -107,7 +108,7 @@ public:
             };
             Characters.insert(std::pair<char, Character>(c, character));
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::BindTexture(GL_TEXTURE_2D, 0);
         // destroy FreeType once we're finished
         FT_Done_Face(face);
         FT_Done_FreeType(ft);
@@ -118,8 +119,9 @@ public:
         // activate corresponding render state	
         this->TextShader.Use();
         this->TextShader.SetVector3f("textColor", color);
-        glActiveTexture(GL_TEXTURE0);
-        glBindVertexArray(this->VAO);
+        GLState::ActiveTexture(GL_TEXTURE0);
+        GLState::BindVertexArray(this->VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
 
         // iterate through all characters
         std::string::const_iterator c;
@@ -143,18 +145,15 @@ public:
                 { xpos + w, ypos,       1.0f, 0.0f }
             };
             // render glyph texture over quad
-            glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+            GLState::BindTexture(GL_TEXTURE_2D, ch.TextureID);
             // update content of VBO memory
-            glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
             glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // be sure to use glBufferSubData and not glBufferData
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
             // render quad
             glDrawArrays(GL_TRIANGLES, 0, 6);
             // now advance cursors for next glyph
             x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (1/64th times 2^6 = 64)
         }
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        // state is left bound, GLState skips it when the next call binds the same objects
     }
 
 private:
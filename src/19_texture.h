@@ -3,6 +3,8 @@
 
 #include <glad/glad.h>
 
+#include "gl_state.h"
+
 // Texture2D is able to store and configure a texture in OpenGL.
 // It also hosts utility functions for easy management.
 class Texture2D
@@ -32,7 +34,7 @@ public:
         this->Width = width;
         this->Height = height;
         // create Texture
-        glBindTexture(GL_TEXTURE_2D, this->ID);
+        GLState::BindTexture(GL_TEXTURE_2D, this->ID);
         glTexImage2D(GL_TEXTURE_2D, 0, this->Internal_Format, width, height, 0, this->Image_Format, GL_UNSIGNED_BYTE, data);
         // set Texture wrap and filter modes
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->Wrap_S);
@@ -40,12 +42,12 @@ public:
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->Filter_Min);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->Filter_Max);
         // unbind texture
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLState::BindTexture(GL_TEXTURE_2D, 0);
     }
     // binds the texture as the current active GL_TEXTURE_2D texture object
     void Bind() const
     {
-        glBindTexture(GL_TEXTURE_2D, this->ID);
+        GLState::BindTexture(GL_TEXTURE_2D, this->ID);
     }
 };
 
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <string>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "shader.h"
+#include "camera.h"
+#include "model.h"
+#include "animation.h"
+
+using namespace std;
+
+//함수 선언
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void processInput(GLFWwindow *window);
+void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+
+//셋팅
+const unsigned int SCR_HEIGHT = 600, SCR_WIDTH = 800;
+
+//마우스 이동 관련
+Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+float lastX = SCR_WIDTH/2, lastY = SCR_HEIGHT/2;
+bool firstMouse = true;
+
+//타이밍 관련
+float deltaTime = 0.0f;
+float lastFrame = 0.0f;
+
+//군중 크기 (CROWD_SIDE x CROWD_SIDE 캐릭터)
+const unsigned int CROWD_SIDE = 10;
+//C키: 다음 clip으로 crossfade
+bool isCkeyPressed = false;
+bool crossFadeRequested = false;
+
+int main(){
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Study_OpenGL", NULL, NULL);
+    if(window == NULL)
+    {
+        std::cout << "Fail to create GLFW window" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    //커서 설정
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    //마우스 입력 사용
+    glfwSetCursorPosCallback(window, mouse_callback);
+    glfwSetScrollCallback(window, scroll_callback); 
+
+    if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+    //Shader 작성
+    Shader ourShader("src/shaders/20shader.vs", "src/shaders/20shader.fs", nullptr, ShaderDefines().Set("MAX_BONES", (int)ANIMATION_MAX_BONES));
+
+    stbi_set_flip_vertically_on_load(true);
+
+    //Model 불러오기 (bone 4개짜리 촉수, 2초 loop clip 하나)
+    Model ourModel("resources/object/tentacle/tentacle.dae", false, MODEL_ANIMATED | MODEL_COMPRESS_TEXTURES);
+    TextureCache::PrintStats();
+    if (ourModel.animations.empty())
+    {
+        std::cout << "ERROR::ANIMATION:: model has no animation" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+
+    //캐릭터마다 시작 시간을 다르게
+    AnimationSystem crowd(ourModel.skeleton);
+    unsigned int currentClip = 0;
+    for (unsigned int i = 0; i < CROWD_SIDE * CROWD_SIDE; i++)
+        crowd.Add(&ourModel.animations[0], ourModel.animations[0].duration * i / (CROWD_SIDE * CROWD_SIDE));
+    float statsReportTime = 0.0f;
+
+    //Depth buffer 사용
+    GLState::Enable(GL_DEPTH_TEST); 
+
+    //렌더링 루프
+    while(!glfwWindowShouldClose(window))
+    {   
+        //카메라 속도 관련 DeltaTime
+        float currentFrame = glfwGetTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        //키 입력
+        processInput(window);
+        if (crossFadeRequested)
+        {
+            currentClip = (currentClip + 1) % ourModel.animations.size();
+            for (unsigned int i = 0; i < crowd.Size(); i++)
+                crowd[i].CrossFade(&ourModel.animations[currentClip], 0.5f, crowd[i].time);
+            crossFadeRequested = false;
+        }
+
+        //모든 캐릭터 pose 계산 (worker thread) 후 bone palette 업로드
+        crowd.Update(deltaTime);
+        crowd.Upload();
+
+        //배경색
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        
+        //--------------------------------------------------------------------------------------
+        //3D MODEL shader활성화
+        ourShader.use();
+        //view
+        glm::mat4 view = glm::mat4(1.0f);
+        view = camera.GetViewMatrix();
+        ourShader.setMat4("view", view);
+        //projection
+        glm::mat4 projection = glm::mat4(1.0f);
+        projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+        ourShader.setMat4("projection", projection);
+
+        //캐릭터마다 palette 범위만 바꿔서 그림
+        for (unsigned int i = 0; i < crowd.Size(); i++)
+        {
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, glm::vec3(((int)(i % CROWD_SIDE) - (int)CROWD_SIDE / 2) * 1.5f, -1.0f, -(float)(i / CROWD_SIDE) * 1.5f));
+            model = glm::scale(model, glm::vec3(0.5f, 0.5f, 0.5f));
+            ourShader.setMat4("model", model);
+            crowd.Bind(i);
+            ourModel.Draw(ourShader);
+        }
+        if (currentFrame - statsReportTime >= 1.0f)
+        {
+            crowd.Stats().Print("tentacle");
+            crowd.Stats().Reset();
+            statsReportTime = currentFrame;
+        }
+
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    
+    glfwTerminate();
+    return 0;
+}
+
+//화면 크기 바뀜 콜백
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+    glViewport(0, 0, width, height);
+}
+//프로세스 input
+void processInput(GLFWwindow *window)
+{
+    if(glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+    
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+        camera.ProcessKeyboard(FORWARD, deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+        camera.ProcessKeyboard(BACKWARD, deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+        camera.ProcessKeyboard(LEFT, deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+        camera.ProcessKeyboard(RIGHT, deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) 
+        camera.ProcessKeyboard(UP, deltaTime);
+    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
+        camera.ProcessKeyboard(DOWN, deltaTime);
+
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !isCkeyPressed)
+    {
+        crossFadeRequested = true;
+        isCkeyPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE)
+        isCkeyPressed = false;
+}
+//마우스 input 카메라이동
+void mouse_callback(GLFWwindow* window, double xpos, double ypos)
+{
+    if (firstMouse)
+    {
+        lastX = xpos;
+        lastY = ypos;
+        firstMouse = false;
+    }
+
+    float xoffset = xpos - lastX;
+    float yoffset = lastY - ypos;
+
+    lastX = xpos;
+    lastY = ypos;
+
+    camera.ProcessMouseMovement(xoffset, yoffset);
+}
+//마우스 스크롤 카메라 줌
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    camera.ProcessMouseScroll(yoffset);
+}
@@ -0,0 +1,598 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <assimp/scene.h>
+
+#include "gl_state.h"
+#include "thread_pool.h"
+#include "uniform_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// pose 보간 SIMD 폭 (SSE 4개 node씩, 그 외 1개씩)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANIMATION_SIMD_WIDTH 4
+#else
+#define ANIMATION_SIMD_WIDTH 1
+#endif
+
+// skinning shader의 uniform block과 맞춰야 함
+//   layout (std140) uniform Bones { mat4 bones[ANIMATION_MAX_BONES]; };
+const unsigned int ANIMATION_MAX_BONES = 100;
+const unsigned int ANIMATION_BONE_BINDING = UNIFORM_BLOCK_BONES; // Shader가 link할 때 Bones block을 여기에 연결
+const float ANIMATION_SAMPLE_RATE = 30.0f;       // import할 때 key를 이 rate로 다시 샘플링
+
+// assimp 행렬은 row-major, glm은 column-major
+inline glm::mat4 AnimationMatrix(const aiMatrix4x4 &m)
+{
+    return glm::mat4(m.a1, m.b1, m.c1, m.d1,
+                     m.a2, m.b2, m.c2, m.d2,
+                     m.a3, m.b3, m.c3, m.d3,
+                     m.a4, m.b4, m.c4, m.d4);
+}
+
+// aiNode tree를 parent가 항상 먼저 오도록 펼친 것 + bone 목록
+struct Skeleton
+{
+    vector<string> names;             // node 이름
+    vector<int> parents;              // parent node, root는 -1
+    vector<glm::mat4> bindLocal;      // aiNode::mTransformation (track이 없는 node는 이 값 그대로)
+    vector<int> nodeBones;            // node -> bone, bone이 아니면 -1
+    vector<unsigned int> boneNodes;   // bone -> node
+    vector<glm::mat4> boneOffsets;    // mesh space -> bone space (aiBone::mOffsetMatrix)
+    glm::mat4 globalInverse;          // root 변환의 역행렬
+
+    Skeleton() : globalInverse(1.0f) { }
+
+    unsigned int NodeCount() const { return (unsigned int)parents.size(); }
+    unsigned int BoneCount() const { return (unsigned int)boneNodes.size(); }
+    bool Empty() const { return boneNodes.empty(); }
+    int FindNode(const string &name) const
+    {
+        unordered_map<string, unsigned int>::const_iterator it = nodeIndex.find(name);
+        return it == nodeIndex.end() ? -1 : (int)it->second;
+    }
+    int FindBone(const string &name) const
+    {
+        int node = FindNode(name);
+        return node < 0 ? -1 : nodeBones[node];
+    }
+
+    // node tree를 펼치고 모든 mesh의 bone을 등록 (mesh 처리 전에 main thread에서)
+    void Build(const aiScene *scene)
+    {
+        *this = Skeleton();
+        addNode(scene->mRootNode, -1);
+        globalInverse = glm::inverse(bindLocal[0]);
+        bool overflow = false;
+        for (unsigned int m = 0; m < scene->mNumMeshes; m++)
+        {
+            const aiMesh *mesh = scene->mMeshes[m];
+            for (unsigned int b = 0; b < mesh->mNumBones; b++)
+            {
+                const aiBone *bone = mesh->mBones[b];
+                int node = FindNode(bone->mName.C_Str());
+                if (node < 0 || nodeBones[node] >= 0)
+                    continue;
+                if (BoneCount() >= ANIMATION_MAX_BONES)
+                {
+                    overflow = true;
+                    continue;
+                }
+                nodeBones[node] = (int)BoneCount();
+                boneNodes.push_back((unsigned int)node);
+                boneOffsets.push_back(AnimationMatrix(bone->mOffsetMatrix));
+            }
+        }
+        if (overflow)
+            cout << "ERROR::ANIMATION:: more than " << ANIMATION_MAX_BONES << " bones, extra bones are ignored" << endl;
+    }
+
+private:
+    unordered_map<string, unsigned int> nodeIndex;
+
+    void addNode(const aiNode *node, int parent)
+    {
+        unsigned int index = NodeCount();
+        names.push_back(node->mName.C_Str());
+        parents.push_back(parent);
+        bindLocal.push_back(AnimationMatrix(node->mTransformation));
+        nodeBones.push_back(-1);
+        nodeIndex.insert(make_pair(names.back(), index));
+        for (unsigned int i = 0; i < node->mNumChildren; i++)
+            addNode(node->mChildren[i], (int)index);
+    }
+};
+
+// local 변환 성분, frame마다 node 순서로 채널별로 모아둠 (SoA)
+enum AnimationChannel {
+    CHANNEL_TX, CHANNEL_TY, CHANNEL_TZ,
+    CHANNEL_QX, CHANNEL_QY, CHANNEL_QZ, CHANNEL_QW,
+    CHANNEL_SX, CHANNEL_SY, CHANNEL_SZ,
+    ANIMATION_CHANNELS
+};
+
+// 고정 rate로 다시 샘플링한 clip
+// data[(frame * ANIMATION_CHANNELS + channel) * stride + node], stride는 node 수를 4의 배수로 올린 값
+// frame 하나가 연속된 메모리라서 샘플링은 두 frame을 순서대로 읽기만 함
+struct AnimationClip
+{
+    string name;
+    float duration;       // 초
+    float sampleRate;
+    unsigned int frameCount;
+    unsigned int stride;
+    vector<float> data;
+
+    AnimationClip() : duration(0.0f), sampleRate(ANIMATION_SAMPLE_RATE), frameCount(0), stride(0) { }
+
+    const float *Frame(unsigned int frame) const { return &data[(size_t)frame * ANIMATION_CHANNELS * stride]; }
+    size_t Bytes() const { return data.size() * sizeof(float); }
+
+    // aiAnimation -> clip, track이 없는 node는 bind pose
+    static void Import(const aiAnimation *animation, const Skeleton &skeleton, AnimationClip &clip, float sampleRate = ANIMATION_SAMPLE_RATE)
+    {
+        double ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
+        clip.name = animation->mName.C_Str();
+        clip.duration = (float)(animation->mDuration / ticksPerSecond);
+        clip.sampleRate = sampleRate;
+        clip.frameCount = (unsigned int)ceil(clip.duration * sampleRate) + 1;
+        clip.stride = (skeleton.NodeCount() + 3) & ~3u;
+        clip.data.assign((size_t)clip.frameCount * ANIMATION_CHANNELS * clip.stride, 0.0f);
+
+        vector<const aiNodeAnim*> tracks(skeleton.NodeCount(), nullptr);
+        for (unsigned int i = 0; i < animation->mNumChannels; i++)
+        {
+            int node = skeleton.FindNode(animation->mChannels[i]->mNodeName.C_Str());
+            if (node >= 0)
+                tracks[node] = animation->mChannels[i];
+        }
+
+        for (unsigned int n = 0; n < clip.stride; n++)
+        {
+            glm::vec3 t(0.0f), s(1.0f);
+            glm::quat q(1.0f, 0.0f, 0.0f, 0.0f);
+            if (n < skeleton.NodeCount() && !tracks[n])
+                decompose(skeleton.bindLocal[n], t, q, s);
+            unsigned int positionKey = 0, rotationKey = 0, scalingKey = 0;
+            glm::quat previous = q;
+            for (unsigned int f = 0; f < clip.frameCount; f++)
+            {
+                if (n < skeleton.NodeCount() && tracks[n])
+                {
+                    const aiNodeAnim *track = tracks[n];
+                    double tick = min((double)f / sampleRate, (double)clip.duration) * ticksPerSecond;
+                    t = sampleVector(track->mPositionKeys, track->mNumPositionKeys, tick, positionKey, glm::vec3(0.0f));
+                    s = sampleVector(track->mScalingKeys, track->mNumScalingKeys, tick, scalingKey, glm::vec3(1.0f));
+                    q = sampleRotation(track->mRotationKeys, track->mNumRotationKeys, tick, rotationKey);
+                }
+                // 이웃 frame끼리 같은 반구에 둠 (frame 사이 nlerp가 항상 짧은 경로)
+                if (glm::dot(q, previous) < 0.0f)
+                    q = -q;
+                previous = q;
+                float *frame = &clip.data[(size_t)f * ANIMATION_CHANNELS * clip.stride];
+                const float values[ANIMATION_CHANNELS] = { t.x, t.y, t.z, q.x, q.y, q.z, q.w, s.x, s.y, s.z };
+                for (unsigned int c = 0; c < ANIMATION_CHANNELS; c++)
+                    frame[c * clip.stride + n] = values[c];
+            }
+        }
+    }
+
+private:
+    static void decompose(const glm::mat4 &m, glm::vec3 &t, glm::quat &q, glm::vec3 &s)
+    {
+        t = glm::vec3(m[3]);
+        s = glm::vec3(glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2])));
+        glm::mat3 rotation(glm::vec3(m[0]) / (s.x > 0.0f ? s.x : 1.0f),
+                           glm::vec3(m[1]) / (s.y > 0.0f ? s.y : 1.0f),
+                           glm::vec3(m[2]) / (s.z > 0.0f ? s.z : 1.0f));
+        q = glm::normalize(glm::quat_cast(rotation));
+    }
+    // frame 시간은 증가만 하므로 key 위치(cursor)를 이어서 찾음
+    template <typename Key>
+    static float keyFactor(const Key *keys, unsigned int count, double tick, unsigned int &cursor)
+    {
+        while (cursor + 1 < count && keys[cursor + 1].mTime <= tick)
+            cursor++;
+        if (cursor + 1 >= count)
+            return 0.0f;
+        double span = keys[cursor + 1].mTime - keys[cursor].mTime;
+        return span > 0.0 ? (float)min(max((tick - keys[cursor].mTime) / span, 0.0), 1.0) : 0.0f;
+    }
+    static glm::vec3 sampleVector(const aiVectorKey *keys, unsigned int count, double tick, unsigned int &cursor, const glm::vec3 &fallback)
+    {
+        if (count == 0)
+            return fallback;
+        float factor = keyFactor(keys, count, tick, cursor);
+        const aiVector3D &a = keys[cursor].mValue;
+        glm::vec3 result(a.x, a.y, a.z);
+        if (factor > 0.0f)
+        {
+            const aiVector3D &b = keys[cursor + 1].mValue;
+            result = glm::mix(result, glm::vec3(b.x, b.y, b.z), factor);
+        }
+        return result;
+    }
+    static glm::quat sampleRotation(const aiQuatKey *keys, unsigned int count, double tick, unsigned int &cursor)
+    {
+        if (count == 0)
+            return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        float factor = keyFactor(keys, count, tick, cursor);
+        const aiQuaternion &a = keys[cursor].mValue;
+        glm::quat result(a.w, a.x, a.y, a.z);
+        if (factor > 0.0f)
+        {
+            const aiQuaternion &b = keys[cursor + 1].mValue;
+            result = glm::slerp(result, glm::quat(b.w, b.x, b.y, b.z), factor);
+        }
+        return glm::normalize(result);
+    }
+};
+
+// 캐릭터 하나의 재생 상태
+struct Animator
+{
+    const AnimationClip *clip;
+    float time;
+    float speed;
+    bool loop;
+    // CrossFade 중이면 next로 fadeDuration 동안 넘어감
+    const AnimationClip *next;
+    float nextTime;
+    float fade;
+    float fadeDuration;
+
+    Animator() : clip(nullptr), time(0.0f), speed(1.0f), loop(true), next(nullptr), nextTime(0.0f), fade(0.0f), fadeDuration(0.0f) { }
+
+    void Play(const AnimationClip *clip, float time = 0.0f)
+    {
+        this->clip = clip;
+        this->time = time;
+        next = nullptr;
+    }
+    void CrossFade(const AnimationClip *target, float duration, float targetTime = 0.0f)
+    {
+        if (!clip || duration <= 0.0f)
+        {
+            Play(target, targetTime);
+            return;
+        }
+        next = target;
+        nextTime = targetTime;
+        fade = 0.0f;
+        fadeDuration = duration;
+    }
+    void Advance(float deltaTime)
+    {
+        time = wrap(clip, time + deltaTime * speed);
+        if (!next)
+            return;
+        nextTime = wrap(next, nextTime + deltaTime * speed);
+        fade += deltaTime;
+        if (fade >= fadeDuration)
+            Play(next, nextTime);
+    }
+    // next의 비중 (0이면 clip만)
+    float FadeWeight() const { return next ? min(fade / fadeDuration, 1.0f) : 0.0f; }
+
+private:
+    float wrap(const AnimationClip *c, float t) const
+    {
+        if (!c || c->duration <= 0.0f)
+            return 0.0f;
+        if (loop)
+            return t - floor(t / c->duration) * c->duration;
+        return min(max(t, 0.0f), c->duration);
+    }
+};
+
+// 프레임 단위 누적 시간
+struct AnimationStats
+{
+    unsigned int frames = 0;
+    unsigned int characters = 0;
+    unsigned int bones = 0;
+    unsigned int threads = 0;
+    double evaluateMs = 0.0;
+    double uploadMs = 0.0;
+    size_t uploadBytes = 0;
+
+    void Reset() { *this = AnimationStats(); }
+    void Print(const string &name) const
+    {
+        unsigned int n = max(frames, 1u);
+        cout << "ANIMATION:: " << name << " " << characters << " characters x " << bones << " bones (" << threads << " threads) | evaluate "
+             << evaluateMs / n << " ms/frame (" << (evaluateMs > 0.0 ? characters * (double)frames / evaluateMs : 0.0)
+             << " characters/ms) | upload " << uploadMs / n << " ms/frame, " << uploadBytes / n / 1024 << " KB/frame" << endl;
+    }
+};
+
+// 같은 skeleton을 쓰는 캐릭터들의 pose를 한꺼번에 계산해서 uniform buffer 하나로 올림
+// 캐릭터마다 bone palette가 buffer 안에 연속으로 있고, 그리기 전에 Bind(i)로 해당 범위만 연결
+class AnimationSystem
+{
+public:
+    explicit AnimationSystem(const Skeleton &skeleton) : skeleton(skeleton), ubo(0), paletteStride(0)
+    {
+        // 캐릭터 palette 시작은 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 배수여야 함
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = max(alignment, (GLint)sizeof(glm::mat4));
+        size_t bytes = max(skeleton.BoneCount(), 1u) * sizeof(glm::mat4);
+        bytes = (bytes + alignment - 1) / alignment * alignment;
+        paletteStride = (unsigned int)(bytes / sizeof(glm::mat4));
+    }
+    ~AnimationSystem()
+    {
+        if (ubo)
+            GLState::DeleteBuffers(1, &ubo);
+    }
+    AnimationSystem(const AnimationSystem &) = delete;
+    AnimationSystem &operator=(const AnimationSystem &) = delete;
+
+    // 캐릭터 추가, 반환값이 index
+    unsigned int Add(const AnimationClip *clip, float time = 0.0f)
+    {
+        animators.push_back(Animator());
+        animators.back().Play(clip, time);
+        palettes.resize(animators.size() * paletteStride, glm::mat4(1.0f));
+        return (unsigned int)animators.size() - 1;
+    }
+    unsigned int Size() const { return (unsigned int)animators.size(); }
+    Animator &operator[](unsigned int character) { return animators[character]; }
+    const glm::mat4 *Palette(unsigned int character) const { return &palettes[(size_t)character * paletteStride]; }
+    AnimationStats &Stats() { return stats; }
+
+    // 시간 진행 후 모든 캐릭터의 palette 계산, pool이 nullptr이면 이 thread에서
+    void Update(float deltaTime, ThreadPool *pool = &SharedThreadPool())
+    {
+        auto start = chrono::steady_clock::now();
+        for (unsigned int i = 0; i < animators.size(); i++)
+            animators[i].Advance(deltaTime);
+        if (pool)
+            pool->ParallelFor(Size(), [this](unsigned int i) { evaluate(i); });
+        else
+            for (unsigned int i = 0; i < Size(); i++)
+                evaluate(i);
+        stats.frames++;
+        stats.characters = Size();
+        stats.bones = skeleton.BoneCount();
+        stats.threads = pool ? pool->Size() : 1;
+        stats.evaluateMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    // palette 전체를 한 번에 올림 (이전 프레임 buffer는 orphan)
+    void Upload()
+    {
+        auto start = chrono::steady_clock::now();
+        size_t bytes = palettes.size() * sizeof(glm::mat4);
+        // shader block 크기만큼 Bind하므로 마지막 캐릭터 뒤에 여유 공간
+        size_t size = bytes + ANIMATION_MAX_BONES * sizeof(glm::mat4);
+        if (!ubo)
+            glGenBuffers(1, &ubo);
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, bytes, palettes.data());
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+        stats.uploadBytes += bytes;
+        stats.uploadMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    // character의 palette를 Bones block에 연결
+    void Bind(unsigned int character) const
+    {
+        GLState::BindBufferRange(GL_UNIFORM_BUFFER, ANIMATION_BONE_BINDING, ubo, (GLintptr)character * paletteStride * sizeof(glm::mat4),
+                          ANIMATION_MAX_BONES * sizeof(glm::mat4));
+    }
+
+private:
+    const Skeleton &skeleton;
+    vector<Animator> animators;
+    vector<glm::mat4> palettes;   // 캐릭터마다 paletteStride개
+    GLuint ubo;
+    unsigned int paletteStride;
+    AnimationStats stats;
+
+    // worker마다 하나씩 (캐릭터마다 할당하지 않음)
+    struct Scratch
+    {
+        vector<float> pose, target;
+        vector<glm::mat4> locals, globals;
+    };
+
+    void evaluate(unsigned int character)
+    {
+        const Animator &animator = animators[character];
+        glm::mat4 *palette = &palettes[(size_t)character * paletteStride];
+        if (!animator.clip || animator.clip->stride < skeleton.NodeCount())
+        {
+            for (unsigned int b = 0; b < skeleton.BoneCount(); b++)
+                palette[b] = glm::mat4(1.0f);
+            return;
+        }
+        static thread_local Scratch scratch;
+        unsigned int stride = animator.clip->stride;
+        scratch.pose.resize((size_t)ANIMATION_CHANNELS * stride);
+        scratch.locals.resize(stride);
+        scratch.globals.resize(skeleton.NodeCount());
+
+        // 1. clip 샘플링 (+ crossfade 대상과 섞음)
+        sample(*animator.clip, animator.time, scratch.pose.data());
+        if (animator.next && animator.next->stride == stride)
+        {
+            scratch.target.resize(scratch.pose.size());
+            sample(*animator.next, animator.nextTime, scratch.target.data());
+            blend(scratch.pose.data(), scratch.target.data(), animator.FadeWeight(), scratch.pose.data(), stride);
+        }
+        // 2. TRS -> local 행렬
+        composeLocals(scratch.pose.data(), stride, scratch.locals.data());
+        // 3. hierarchy, root에 globalInverse를 미리 곱해두면 bone마다 한 번 덜 곱함
+        for (unsigned int n = 0; n < skeleton.NodeCount(); n++)
+        {
+            int parent = skeleton.parents[n];
+            multiply(parent < 0 ? skeleton.globalInverse : scratch.globals[parent], scratch.locals[n], scratch.globals[n]);
+        }
+        // 4. palette = global * offset
+        for (unsigned int b = 0; b < skeleton.BoneCount(); b++)
+            multiply(scratch.globals[skeleton.boneNodes[b]], skeleton.boneOffsets[b], palette[b]);
+    }
+
+    static void sample(const AnimationClip &clip, float time, float *out)
+    {
+        float position = time * clip.sampleRate;
+        unsigned int last = clip.frameCount - 1;
+        unsigned int f0 = min((unsigned int)max(position, 0.0f), last);
+        unsigned int f1 = min(f0 + 1, last);
+        float factor = min(max(position - (float)f0, 0.0f), 1.0f);
+        blend(clip.Frame(f0), clip.Frame(f1), f0 == f1 ? 0.0f : factor, out, clip.stride);
+    }
+
+    // 두 pose를 weight로 섞음: 위치/scale은 lerp, 회전은 부호를 맞춘 nlerp (out은 a와 같아도 됨)
+    static void blend(const float *a, const float *b, float weight, float *out, unsigned int stride)
+    {
+#if ANIMATION_SIMD_WIDTH == 4
+        const __m128 w = _mm_set1_ps(weight);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 half = _mm_set1_ps(0.5f), threeHalves = _mm_set1_ps(1.5f);
+        for (unsigned int n = 0; n < stride; n += 4)
+        {
+            const unsigned int lerpChannels[6] = { CHANNEL_TX, CHANNEL_TY, CHANNEL_TZ, CHANNEL_SX, CHANNEL_SY, CHANNEL_SZ };
+            for (unsigned int i = 0; i < 6; i++)
+            {
+                size_t o = (size_t)lerpChannels[i] * stride + n;
+                __m128 va = _mm_loadu_ps(a + o), vb = _mm_loadu_ps(b + o);
+                _mm_storeu_ps(out + o, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), w)));
+            }
+            __m128 qa[4], qb[4];
+            for (unsigned int c = 0; c < 4; c++)
+            {
+                qa[c] = _mm_loadu_ps(a + (size_t)(CHANNEL_QX + c) * stride + n);
+                qb[c] = _mm_loadu_ps(b + (size_t)(CHANNEL_QX + c) * stride + n);
+            }
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qa[0], qb[0]), _mm_mul_ps(qa[1], qb[1])),
+                                    _mm_add_ps(_mm_mul_ps(qa[2], qb[2]), _mm_mul_ps(qa[3], qb[3])));
+            // dot < 0이면 b의 부호를 뒤집어 짧은 쪽으로
+            __m128 flip = _mm_and_ps(dot, signMask);
+            __m128 q[4];
+            for (unsigned int c = 0; c < 4; c++)
+                q[c] = _mm_add_ps(qa[c], _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(qb[c], flip), qa[c]), w));
+            __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])),
+                                        _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3])));
+            // rsqrt + Newton 한 번 (오차 ~1e-7)
+            __m128 inv = _mm_rsqrt_ps(length2);
+            inv = _mm_mul_ps(inv, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, length2), _mm_mul_ps(inv, inv))));
+            for (unsigned int c = 0; c < 4; c++)
+                _mm_storeu_ps(out + (size_t)(CHANNEL_QX + c) * stride + n, _mm_mul_ps(q[c], inv));
+        }
+#else
+        for (unsigned int n = 0; n < stride; n++)
+        {
+            const unsigned int lerpChannels[6] = { CHANNEL_TX, CHANNEL_TY, CHANNEL_TZ, CHANNEL_SX, CHANNEL_SY, CHANNEL_SZ };
+            for (unsigned int i = 0; i < 6; i++)
+            {
+                size_t o = (size_t)lerpChannels[i] * stride + n;
+                out[o] = a[o] + (b[o] - a[o]) * weight;
+            }
+            float qa[4], qb[4], dot = 0.0f;
+            for (unsigned int c = 0; c < 4; c++)
+            {
+                qa[c] = a[(size_t)(CHANNEL_QX + c) * stride + n];
+                qb[c] = b[(size_t)(CHANNEL_QX + c) * stride + n];
+                dot += qa[c] * qb[c];
+            }
+            float sign = dot < 0.0f ? -1.0f : 1.0f, q[4], length2 = 0.0f;
+            for (unsigned int c = 0; c < 4; c++)
+            {
+                q[c] = qa[c] + (qb[c] * sign - qa[c]) * weight;
+                length2 += q[c] * q[c];
+            }
+            float inv = 1.0f / sqrt(length2);
+            for (unsigned int c = 0; c < 4; c++)
+                out[(size_t)(CHANNEL_QX + c) * stride + n] = q[c] * inv;
+        }
+#endif
+    }
+
+    // SoA pose -> node별 local 행렬 (회전 * scale, 이동)
+    static void composeLocals(const float *pose, unsigned int stride, glm::mat4 *locals)
+    {
+#if ANIMATION_SIMD_WIDTH == 4
+        const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+        for (unsigned int n = 0; n < stride; n += 4)
+        {
+            __m128 x = _mm_loadu_ps(pose + CHANNEL_QX * stride + n), y = _mm_loadu_ps(pose + CHANNEL_QY * stride + n);
+            __m128 z = _mm_loadu_ps(pose + CHANNEL_QZ * stride + n), qw = _mm_loadu_ps(pose + CHANNEL_QW * stride + n);
+            __m128 sx = _mm_loadu_ps(pose + CHANNEL_SX * stride + n), sy = _mm_loadu_ps(pose + CHANNEL_SY * stride + n);
+            __m128 sz = _mm_loadu_ps(pose + CHANNEL_SZ * stride + n);
+            __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+            __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+            __m128 wx = _mm_mul_ps(qw, x), wy = _mm_mul_ps(qw, y), wz = _mm_mul_ps(qw, z);
+            // column 0..2, 각 성분이 4개 node
+            __m128 c0[4] = { _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                             _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                             _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx), zero };
+            __m128 c1[4] = { _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                             _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                             _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy), zero };
+            __m128 c2[4] = { _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                             _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                             _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz), zero };
+            __m128 c3[4] = { _mm_loadu_ps(pose + CHANNEL_TX * stride + n), _mm_loadu_ps(pose + CHANNEL_TY * stride + n),
+                             _mm_loadu_ps(pose + CHANNEL_TZ * stride + n), one };
+            // 성분별(SoA) -> node별 column (AoS)
+            _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+            _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+            _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+            _MM_TRANSPOSE4_PS(c3[0], c3[1], c3[2], c3[3]);
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                float *m = &locals[n + i][0][0];
+                _mm_storeu_ps(m, c0[i]);
+                _mm_storeu_ps(m + 4, c1[i]);
+                _mm_storeu_ps(m + 8, c2[i]);
+                _mm_storeu_ps(m + 12, c3[i]);
+            }
+        }
+#else
+        for (unsigned int n = 0; n < stride; n++)
+        {
+            glm::quat q(pose[CHANNEL_QW * stride + n], pose[CHANNEL_QX * stride + n], pose[CHANNEL_QY * stride + n], pose[CHANNEL_QZ * stride + n]);
+            glm::mat3 r = glm::mat3_cast(q);
+            glm::mat4 &m = locals[n];
+            m[0] = glm::vec4(r[0] * pose[CHANNEL_SX * stride + n], 0.0f);
+            m[1] = glm::vec4(r[1] * pose[CHANNEL_SY * stride + n], 0.0f);
+            m[2] = glm::vec4(r[2] * pose[CHANNEL_SZ * stride + n], 0.0f);
+            m[3] = glm::vec4(pose[CHANNEL_TX * stride + n], pose[CHANNEL_TY * stride + n], pose[CHANNEL_TZ * stride + n], 1.0f);
+        }
+#endif
+    }
+
+    // out = a * b (out은 a, b와 다른 행렬)
+    static void multiply(const glm::mat4 &a, const glm::mat4 &b, glm::mat4 &out)
+    {
+#if ANIMATION_SIMD_WIDTH == 4
+        __m128 a0 = _mm_loadu_ps(&a[0][0]), a1 = _mm_loadu_ps(&a[1][0]), a2 = _mm_loadu_ps(&a[2][0]), a3 = _mm_loadu_ps(&a[3][0]);
+        for (int c = 0; c < 4; c++)
+        {
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b[c][0])), _mm_mul_ps(a1, _mm_set1_ps(b[c][1]))),
+                                  _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b[c][2])), _mm_mul_ps(a3, _mm_set1_ps(b[c][3]))));
+            _mm_storeu_ps(&out[c][0], r);
+        }
+#else
+        out = a * b;
+#endif
+    }
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "frustum.h"
+
 #include <vector>
 
 // Defines several possible options for camera movement. Used as abstraction to stay away from window-system specific input methods
@@ -68,6 +70,13 @@ public:
         return glm::lookAt(Position, Position + Front, Up);
     }
 
+    // returns the world space view frustum for a perspective projection using Zoom as the vertical fov
+    Frustum GetFrustum(float aspect, float zNear, float zFar) const
+    {
+        glm::mat4 projection = glm::perspective(glm::radians(Zoom), aspect, zNear, zFar);
+        return Frustum(projection * glm::lookAt(Position, Position + Front, Up));
+    }
+
     // processes input received from any keyboard-like input system. Accepts input parameter in the form of camera defined ENUM (to abstract it from windowing systems)
     void ProcessKeyboard(Camera_Movement direction, float deltaTime)
     {
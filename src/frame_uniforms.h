@@ -0,0 +1,149 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl_state.h"
+#include "uniform_table.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// 모든 program이 같이 쓰는 프레임 단위 uniform (카메라, 광원)
+// buffer 하나에 두 block을 담고 프레임마다 glBufferSubData 한 번으로 올림
+// shader 쪽 선언은 shaders/frame_camera.glsl, shaders/frame_lights.glsl을 #include (std140, 멤버 순서와 크기가 아래 struct와 같아야 함)
+// Lights 배열 크기는 NR_LIGHTS define으로 FRAME_MAX_LIGHTS를 넣어줌
+// binding point는 UniformTable이 link할 때 이름으로 연결하므로 program마다 따로 설정하지 않음
+const unsigned int FRAME_MAX_LIGHTS = 32;
+
+struct CameraBlock
+{
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec4 viewPos;   // xyz만 사용
+};
+// std140: vec3 뒤에 float 하나가 들어가고 struct는 16byte 단위
+struct LightBlockEntry
+{
+    glm::vec3 position;
+    float linear;
+    glm::vec3 color;
+    float quadratic;
+    float radius;
+    float padding[3];
+};
+struct LightsBlock
+{
+    LightBlockEntry lights[FRAME_MAX_LIGHTS];
+    int count;
+    int padding[3];
+};
+static_assert(sizeof(CameraBlock) == 144, "Camera block must match std140");
+static_assert(sizeof(LightBlockEntry) == 48, "Light must match std140");
+static_assert(sizeof(LightsBlock) == FRAME_MAX_LIGHTS * 48 + 16, "Lights block must match std140");
+
+// 업로드 횟수 (여러 프레임 누적)
+struct FrameUniformStats
+{
+    unsigned int frames = 0;
+    unsigned int uploads = 0;
+    size_t bytes = 0;
+    double uploadMs = 0.0;
+
+    void Reset() { *this = FrameUniformStats(); }
+    void Print(const string &name) const
+    {
+        unsigned int n = frames ? frames : 1;
+        cout << "SHADER::FRAME_UBO:: " << name << " " << uploads / n << " upload/frame (" << bytes / n << " bytes) in "
+             << uploadMs * 1000.0 / n << " us" << endl;
+    }
+};
+
+class FrameUniforms
+{
+public:
+    FrameUniforms() : ubo(0), lightsOffset(0)
+    {
+        memset(&camera, 0, sizeof(camera));
+        memset(&lights, 0, sizeof(lights));
+    }
+    ~FrameUniforms()
+    {
+        if (ubo)
+            GLState::DeleteBuffers(1, &ubo);
+    }
+    FrameUniforms(const FrameUniforms &) = delete;
+    FrameUniforms &operator=(const FrameUniforms &) = delete;
+
+    void SetCamera(const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &viewPos)
+    {
+        camera.projection = projection;
+        camera.view = view;
+        camera.viewPos = glm::vec4(viewPos, 1.0f);
+    }
+    // 광원 목록은 프레임마다 ClearLights 후 AddLight, 넘치면 false
+    void ClearLights() { lights.count = 0; }
+    bool AddLight(const glm::vec3 &position, const glm::vec3 &color, float linear, float quadratic, float radius = 0.0f)
+    {
+        if (lights.count >= (int)FRAME_MAX_LIGHTS)
+            return false;
+        LightBlockEntry &light = lights.lights[lights.count++];
+        light.position = position;
+        light.color = color;
+        light.linear = linear;
+        light.quadratic = quadratic;
+        light.radius = radius;
+        return true;
+    }
+    unsigned int LightCount() const { return (unsigned int)lights.count; }
+
+    // 두 block을 한 번에 올림 (buffer는 처음에 만들고 binding point에 연결해 둠)
+    void Upload()
+    {
+        auto start = chrono::steady_clock::now();
+        if (!ubo)
+            create();
+        memcpy(staging.data(), &camera, sizeof(camera));
+        memcpy(staging.data() + lightsOffset, &lights, sizeof(lights));
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferData(GL_UNIFORM_BUFFER, staging.size(), nullptr, GL_STREAM_DRAW); // 이전 프레임 내용은 orphan
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, staging.size(), staging.data());
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+        stats.frames++;
+        stats.uploads++;
+        stats.bytes += staging.size();
+        stats.uploadMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    FrameUniformStats &Stats() { return stats; }
+
+private:
+    CameraBlock camera;
+    LightsBlock lights;
+    GLuint ubo;
+    size_t lightsOffset;   // Lights block 시작 (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 배수)
+    vector<unsigned char> staging;
+    FrameUniformStats stats;
+
+    void create()
+    {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = alignment > 0 ? alignment : 256;
+        lightsOffset = (sizeof(CameraBlock) + alignment - 1) / alignment * alignment;
+        staging.assign(lightsOffset + sizeof(LightsBlock), 0);
+        glGenBuffers(1, &ubo);
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferData(GL_UNIFORM_BUFFER, staging.size(), nullptr, GL_STREAM_DRAW);
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+        // orphan해도 buffer 이름은 그대로라 binding은 한 번만
+        GLState::BindBufferRange(GL_UNIFORM_BUFFER, UNIFORM_BLOCK_CAMERA, ubo, 0, sizeof(CameraBlock));
+        GLState::BindBufferRange(GL_UNIFORM_BUFFER, UNIFORM_BLOCK_LIGHTS, ubo, lightsOffset, sizeof(LightsBlock));
+    }
+};
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// batch 판정 SIMD 폭 (SSE 4개, 그 외 1개씩)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SIMD_WIDTH 4
+#else
+#define FRUSTUM_SIMD_WIDTH 1
+#endif
+// GCC/Clang x86이면 8개씩 판정하는 AVX 버전을 target attribute로 따로 컴파일해 두고
+// 실행 중에 CPU가 지원할 때만 씀 (-mavx 없이 빌드해도 됨), 배열은 그래서 8개 단위로 채움
+#if FRUSTUM_SIMD_WIDTH > 1 && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FRUSTUM_AVX 1
+#define FRUSTUM_BATCH_PAD 8
+#else
+#define FRUSTUM_AVX 0
+#define FRUSTUM_BATCH_PAD FRUSTUM_SIMD_WIDTH
+#endif
+
+// view frustum 평면 6개 (Gribb-Hartmann, projection * view 행렬에서 추출)
+// 평면은 dot(plane.xyz, p) + plane.w >= 0 이 안쪽, xyz는 단위벡터
+struct Frustum
+{
+    enum { PLANE_LEFT, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR, PLANE_COUNT };
+    glm::vec4 Planes[PLANE_COUNT];
+
+    Frustum() { }
+    // clip = viewProjection * world 인 행렬에서 world space 평면 추출
+    explicit Frustum(const glm::mat4 &viewProjection)
+    {
+        // glm은 column-major, m[col][row]
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; i++)
+            row[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        Planes[PLANE_LEFT]   = row[3] + row[0];
+        Planes[PLANE_RIGHT]  = row[3] - row[0];
+        Planes[PLANE_BOTTOM] = row[3] + row[1];
+        Planes[PLANE_TOP]    = row[3] - row[1];
+        Planes[PLANE_NEAR]   = row[3] + row[2];
+        Planes[PLANE_FAR]    = row[3] - row[2];
+        normalize();
+    }
+
+    // world space 평면 -> model space 평면 (model 행렬은 model -> world)
+    Frustum Transformed(const glm::mat4 &model) const
+    {
+        Frustum result;
+        for (int i = 0; i < PLANE_COUNT; i++)
+            result.Planes[i] = Planes[i] * model; // transpose(model) * plane
+        result.normalize();
+        return result;
+    }
+
+    // 구가 frustum과 겹치면 true (보수적, 모서리 근처는 통과할 수 있음)
+    bool IntersectsSphere(const glm::vec3 &center, float radius) const
+    {
+        for (int i = 0; i < PLANE_COUNT; i++)
+            if (glm::dot(glm::vec3(Planes[i]), center) + Planes[i].w < -radius)
+                return false;
+        return true;
+    }
+
+private:
+    void normalize()
+    {
+        for (int i = 0; i < PLANE_COUNT; i++)
+        {
+            float length = glm::length(glm::vec3(Planes[i]));
+            if (length > 0.0f)
+                Planes[i] /= length;
+        }
+    }
+};
+
+// pass별 culling 통계 (여러 프레임 누적)
+struct FrustumCullStats
+{
+    unsigned int tested = 0;
+    unsigned int visible = 0;
+    double cullMs = 0.0;
+
+    void Reset() { *this = FrustumCullStats(); }
+    void Print(const std::string &pass, unsigned int frames = 1) const
+    {
+        frames = frames ? frames : 1;
+        std::cout << "CULL:: " << pass << " visible " << visible / frames << " / " << tested / frames
+                  << " (culled " << (tested - visible) / frames << ") | " << cullMs / frames << " ms/frame" << std::endl;
+    }
+};
+
+// bounding sphere 여러 개를 SoA로 저장하고 SIMD로 한 번에 frustum 판정
+class BoundingSphereBatch
+{
+public:
+    BoundingSphereBatch() : count(0) { }
+
+    void Clear()
+    {
+        count = 0;
+        x.clear(); y.clear(); z.clear(); r.clear();
+    }
+    unsigned int Size() const { return count; }
+
+    unsigned int Add(const glm::vec3 &center, float radius)
+    {
+        // SIMD 폭 배수로 채워둠, 남는 칸은 반지름이 아주 작아서 항상 밖
+        if (count == x.size())
+        {
+            size_t size = x.size() + FRUSTUM_BATCH_PAD;
+            x.resize(size, 0.0f); y.resize(size, 0.0f); z.resize(size, 0.0f); r.resize(size, -1e30f);
+        }
+        x[count] = center.x; y[count] = center.y; z[count] = center.z; r[count] = radius;
+        return count++;
+    }
+    // model 행렬로 옮긴 AABB를 감싸는 구
+    unsigned int AddBox(const glm::mat4 &model, const glm::vec3 &boxMin, const glm::vec3 &boxMax)
+    {
+        glm::vec3 center = glm::vec3(model * glm::vec4((boxMin + boxMax) * 0.5f, 1.0f));
+        glm::vec3 half = (boxMax - boxMin) * 0.5f;
+        // 회전/scale된 AABB의 world 반 크기 = |M| * half
+        glm::vec3 extent = glm::abs(glm::vec3(model[0])) * half.x + glm::abs(glm::vec3(model[1])) * half.y + glm::abs(glm::vec3(model[2])) * half.z;
+        return Add(center, glm::length(extent));
+    }
+
+    // visible[i] = frusta 중 하나라도 겹치면 1 (point light 큐브맵처럼 여러 면을 한 번에 그리는 pass용)
+    void Cull(const Frustum *frusta, unsigned int frustumCount, std::vector<unsigned char> &visible, FrustumCullStats &stats) const
+    {
+        auto start = std::chrono::steady_clock::now();
+        visible.assign(x.size(), 0);
+        for (unsigned int f = 0; f < frustumCount; f++)
+            cullFrustum(frusta[f], visible.data());
+        visible.resize(count);
+        stats.tested += count;
+        for (unsigned int i = 0; i < count; i++)
+            stats.visible += visible[i];
+        stats.cullMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    void Cull(const Frustum &frustum, std::vector<unsigned char> &visible, FrustumCullStats &stats) const
+    {
+        Cull(&frustum, 1, visible, stats);
+    }
+
+    // AVX 버전 사용 여부 (처음 한 번 CPU 확인)
+    static bool HasAvx()
+    {
+#if FRUSTUM_AVX
+        static const bool supported = __builtin_cpu_supports("avx") != 0;
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+private:
+    std::vector<float> x, y, z, r;
+    unsigned int count;
+
+    void cullFrustum(const Frustum &frustum, unsigned char *visible) const
+    {
+#if FRUSTUM_AVX
+        if (HasAvx())
+        {
+            cullFrustumAvx(frustum, visible);
+            return;
+        }
+#endif
+        size_t size = x.size();
+#if FRUSTUM_SIMD_WIDTH == 4
+        for (size_t i = 0; i < size; i += 4)
+        {
+            __m128 cx = _mm_loadu_ps(&x[i]), cy = _mm_loadu_ps(&y[i]), cz = _mm_loadu_ps(&z[i]);
+            __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&r[i]));
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int p = 0; p < Frustum::PLANE_COUNT; p++)
+            {
+                const glm::vec4 &plane = frustum.Planes[p];
+                __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)), _mm_mul_ps(cy, _mm_set1_ps(plane.y))),
+                                      _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+            }
+            int mask = _mm_movemask_ps(inside);
+            for (int k = 0; k < 4; k++)
+                visible[i + k] |= (mask >> k) & 1;
+        }
+#else
+        for (size_t i = 0; i < size; i++)
+            visible[i] |= frustum.IntersectsSphere(glm::vec3(x[i], y[i], z[i]), r[i]) ? 1 : 0;
+#endif
+    }
+#if FRUSTUM_AVX
+    // 8개씩 (x.size()는 FRUSTUM_BATCH_PAD 배수)
+    __attribute__((target("avx"))) void cullFrustumAvx(const Frustum &frustum, unsigned char *visible) const
+    {
+        size_t size = x.size();
+        for (size_t i = 0; i < size; i += 8)
+        {
+            __m256 cx = _mm256_loadu_ps(&x[i]), cy = _mm256_loadu_ps(&y[i]), cz = _mm256_loadu_ps(&z[i]);
+            __m256 negR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&r[i]));
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int p = 0; p < Frustum::PLANE_COUNT; p++)
+            {
+                const glm::vec4 &plane = frustum.Planes[p];
+                __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(plane.x)), _mm256_mul_ps(cy, _mm256_set1_ps(plane.y))),
+                                         _mm256_add_ps(_mm256_mul_ps(cz, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, negR, _CMP_GE_OQ));
+            }
+            int mask = _mm256_movemask_ps(inside);
+            for (int k = 0; k < 8; k++)
+                visible[i + k] |= (mask >> k) & 1;
+        }
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <glad/glad.h>
+
+#include <iostream>
+#include <string>
+
+// 마지막으로 GL에 보낸 binding/상태를 기억해서 같은 값이면 GL 호출을 생략하는 층
+// 인자는 GL 함수와 같음 (glBindTexture(...) -> GLState::BindTexture(...))
+// 처음에는 모든 값이 "모름"이라 첫 호출은 항상 GL로 감
+// 캐시가 맞으려면 이 상태들은 모두 GLState로 바꿔야 함, GL을 직접 부른 곳이 있으면 그 뒤에 Invalidate()
+// 삭제도 GLState로 (삭제된 이름은 다시 쓰일 수 있고 bind된 것을 지우면 GL 쪽 binding이 0이 됨)
+// context 하나, GL thread 하나 기준
+enum GLStateCall {
+    GL_STATE_PROGRAM,
+    GL_STATE_TEXTURE_UNIT,   // glActiveTexture
+    GL_STATE_TEXTURE,
+    GL_STATE_VERTEX_ARRAY,
+    GL_STATE_BUFFER,
+    GL_STATE_FRAMEBUFFER,
+    GL_STATE_CAPABILITY,     // glEnable/glDisable
+    GL_STATE_BLEND_DEPTH,    // glBlendFunc, glDepthFunc, glDepthMask
+    GL_STATE_CALL_COUNT
+};
+
+// 실제로 보낸 호출과 생략한 호출 (여러 프레임 누적)
+struct GLStateStats
+{
+    unsigned int issued[GL_STATE_CALL_COUNT] = { };
+    unsigned int suppressed[GL_STATE_CALL_COUNT] = { };
+
+    void Reset() { *this = GLStateStats(); }
+    void Print(const std::string &name, unsigned int frames = 1) const
+    {
+        static const char *names[GL_STATE_CALL_COUNT] = { "program", "unit", "texture", "vao", "buffer", "fbo", "enable", "blend/depth" };
+        frames = frames ? frames : 1;
+        unsigned int totalIssued = 0, totalSuppressed = 0;
+        for (unsigned int i = 0; i < GL_STATE_CALL_COUNT; i++)
+        {
+            totalIssued += issued[i];
+            totalSuppressed += suppressed[i];
+        }
+        std::cout << "GL::STATE:: " << name << " " << totalIssued / frames << " calls/frame issued, " << totalSuppressed / frames << " suppressed |";
+        for (unsigned int i = 0; i < GL_STATE_CALL_COUNT; i++)
+            if (issued[i] || suppressed[i])
+                std::cout << " " << names[i] << " " << issued[i] / frames << "/" << (issued[i] + suppressed[i]) / frames;
+        std::cout << std::endl;
+    }
+};
+
+const unsigned int GL_STATE_MAX_UNITS = 32;     // 이 이상의 유닛은 캐시 없이 그대로 보냄
+const GLuint GL_STATE_UNKNOWN = ~0u;
+
+class GLState
+{
+public:
+    static GLStateStats &Stats()
+    {
+        static GLStateStats stats;
+        return stats;
+    }
+
+    // GL을 직접 부른 코드(외부 라이브러리 등) 뒤에 호출, 다음 호출은 모두 GL로 감
+    static void Invalidate()
+    {
+        cache() = Cache();
+    }
+
+    static void UseProgram(GLuint program)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_PROGRAM, c.program == program))
+            return;
+        c.program = program;
+        glUseProgram(program);
+    }
+
+    // unit은 glActiveTexture처럼 GL_TEXTURE0 + i
+    static void ActiveTexture(GLenum unit)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_TEXTURE_UNIT, c.activeUnit == unit))
+            return;
+        c.activeUnit = unit;
+        glActiveTexture(unit);
+    }
+    // 현재 active unit에 bind
+    static void BindTexture(GLenum target, GLuint texture)
+    {
+        Cache &c = cache();
+        GLuint *slot = textureSlot(c, target);
+        if (count(GL_STATE_TEXTURE, slot && *slot == texture))
+            return;
+        if (slot)
+            *slot = texture;
+        glBindTexture(target, texture);
+    }
+
+    static void BindVertexArray(GLuint vao)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_VERTEX_ARRAY, c.vao == vao))
+            return;
+        c.vao = vao;
+        // element buffer binding은 VAO 상태라 VAO가 바뀌면 알 수 없음
+        c.buffers[BUFFER_ELEMENT] = GL_STATE_UNKNOWN;
+        glBindVertexArray(vao);
+    }
+    static void BindBuffer(GLenum target, GLuint buffer)
+    {
+        Cache &c = cache();
+        int slot = bufferSlot(target);
+        if (count(GL_STATE_BUFFER, slot >= 0 && c.buffers[slot] == buffer))
+            return;
+        if (slot >= 0)
+            c.buffers[slot] = buffer;
+        glBindBuffer(target, buffer);
+    }
+    // indexed binding은 매번 보내지만 일반 binding point도 바뀌므로 기록
+    static void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        int slot = bufferSlot(target);
+        if (slot >= 0)
+            cache().buffers[slot] = buffer;
+        count(GL_STATE_BUFFER, false);
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+    static void BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        int slot = bufferSlot(target);
+        if (slot >= 0)
+            cache().buffers[slot] = buffer;
+        count(GL_STATE_BUFFER, false);
+        glBindBufferBase(target, index, buffer);
+    }
+
+    // GL_FRAMEBUFFER는 read/draw 둘 다
+    static void BindFramebuffer(GLenum target, GLuint framebuffer)
+    {
+        Cache &c = cache();
+        bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+        bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+        if (count(GL_STATE_FRAMEBUFFER, (!read || c.readFramebuffer == framebuffer) && (!draw || c.drawFramebuffer == framebuffer)))
+            return;
+        if (read)
+            c.readFramebuffer = framebuffer;
+        if (draw)
+            c.drawFramebuffer = framebuffer;
+        glBindFramebuffer(target, framebuffer);
+    }
+
+    static void Enable(GLenum capability) { setCapability(capability, true); }
+    static void Disable(GLenum capability) { setCapability(capability, false); }
+
+    static void BlendFunc(GLenum source, GLenum destination)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_BLEND_DEPTH, c.blendSource == source && c.blendDestination == destination))
+            return;
+        c.blendSource = source;
+        c.blendDestination = destination;
+        glBlendFunc(source, destination);
+    }
+    static void DepthFunc(GLenum func)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_BLEND_DEPTH, c.depthFunc == func))
+            return;
+        c.depthFunc = func;
+        glDepthFunc(func);
+    }
+    static void DepthMask(GLboolean flag)
+    {
+        Cache &c = cache();
+        if (count(GL_STATE_BLEND_DEPTH, c.depthMask == (int)flag))
+            return;
+        c.depthMask = flag;
+        glDepthMask(flag);
+    }
+
+    // 삭제: GL처럼 bind되어 있던 곳은 0으로
+    static void DeleteTextures(GLsizei n, const GLuint *textures)
+    {
+        Cache &c = cache();
+        for (GLsizei i = 0; i < n; i++)
+            for (unsigned int u = 0; u < GL_STATE_MAX_UNITS; u++)
+                for (unsigned int t = 0; t < TEXTURE_TARGETS; t++)
+                    if (c.textures[u][t] == textures[i])
+                        c.textures[u][t] = 0;
+        glDeleteTextures(n, textures);
+    }
+    static void DeleteBuffers(GLsizei n, const GLuint *buffers)
+    {
+        Cache &c = cache();
+        for (GLsizei i = 0; i < n; i++)
+            for (unsigned int b = 0; b < BUFFER_TARGETS; b++)
+                if (c.buffers[b] == buffers[i])
+                    c.buffers[b] = 0;
+        // bind되지 않은 VAO에 붙어 있던 element buffer는 추적하지 않으므로 모름으로
+        c.buffers[BUFFER_ELEMENT] = GL_STATE_UNKNOWN;
+        glDeleteBuffers(n, buffers);
+    }
+    static void DeleteVertexArrays(GLsizei n, const GLuint *arrays)
+    {
+        Cache &c = cache();
+        for (GLsizei i = 0; i < n; i++)
+            if (c.vao == arrays[i])
+            {
+                c.vao = 0;
+                c.buffers[BUFFER_ELEMENT] = GL_STATE_UNKNOWN;
+            }
+        glDeleteVertexArrays(n, arrays);
+    }
+    static void DeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+    {
+        Cache &c = cache();
+        for (GLsizei i = 0; i < n; i++)
+        {
+            if (c.readFramebuffer == framebuffers[i])
+                c.readFramebuffer = 0;
+            if (c.drawFramebuffer == framebuffers[i])
+                c.drawFramebuffer = 0;
+        }
+        glDeleteFramebuffers(n, framebuffers);
+    }
+    // 사용 중인 program은 GL이 바로 지우지 않지만 언제 이름이 재사용될지 모르므로 모름으로
+    static void DeleteProgram(GLuint program)
+    {
+        Cache &c = cache();
+        if (c.program == program)
+            c.program = GL_STATE_UNKNOWN;
+        glDeleteProgram(program);
+    }
+
+private:
+    enum { TEXTURE_2D, TEXTURE_CUBE_MAP, TEXTURE_2D_MULTISAMPLE, TEXTURE_2D_ARRAY, TEXTURE_3D, TEXTURE_TARGETS };
+    enum { BUFFER_ARRAY, BUFFER_ELEMENT, BUFFER_UNIFORM, BUFFER_SHADER_STORAGE, BUFFER_PIXEL_UNPACK, BUFFER_TARGETS };
+    const static unsigned int CAPABILITIES = 12;
+
+    struct Cache
+    {
+        GLuint program;
+        GLenum activeUnit;
+        GLuint textures[GL_STATE_MAX_UNITS][TEXTURE_TARGETS];
+        GLuint vao;
+        GLuint buffers[BUFFER_TARGETS];
+        GLuint readFramebuffer, drawFramebuffer;
+        GLenum capabilities[CAPABILITIES];
+        int enabled[CAPABILITIES];      // -1 모름, 0/1
+        GLenum blendSource, blendDestination, depthFunc;
+        int depthMask;
+
+        Cache() : program(GL_STATE_UNKNOWN), activeUnit(GL_STATE_UNKNOWN), vao(GL_STATE_UNKNOWN),
+                  readFramebuffer(GL_STATE_UNKNOWN), drawFramebuffer(GL_STATE_UNKNOWN),
+                  blendSource(GL_STATE_UNKNOWN), blendDestination(GL_STATE_UNKNOWN), depthFunc(GL_STATE_UNKNOWN), depthMask(-1)
+        {
+            for (unsigned int u = 0; u < GL_STATE_MAX_UNITS; u++)
+                for (unsigned int t = 0; t < TEXTURE_TARGETS; t++)
+                    textures[u][t] = GL_STATE_UNKNOWN;
+            for (unsigned int b = 0; b < BUFFER_TARGETS; b++)
+                buffers[b] = GL_STATE_UNKNOWN;
+            const GLenum tracked[CAPABILITIES] = {
+                GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_MULTISAMPLE,
+                GL_FRAMEBUFFER_SRGB, GL_TEXTURE_CUBE_MAP_SEAMLESS, GL_PROGRAM_POINT_SIZE, GL_POLYGON_OFFSET_FILL,
+                GL_DEPTH_CLAMP, GL_RASTERIZER_DISCARD
+            };
+            for (unsigned int i = 0; i < CAPABILITIES; i++)
+            {
+                capabilities[i] = tracked[i];
+                enabled[i] = -1;
+            }
+        }
+    };
+    static Cache &cache()
+    {
+        static Cache state;
+        return state;
+    }
+
+    // 생략했으면 true
+    static bool count(GLStateCall call, bool redundant)
+    {
+        GLStateStats &stats = Stats();
+        if (redundant)
+            stats.suppressed[call]++;
+        else
+            stats.issued[call]++;
+        return redundant;
+    }
+
+    // 추적하지 않는 target이나 유닛이면 nullptr (항상 GL로)
+    static GLuint *textureSlot(Cache &c, GLenum target)
+    {
+        if (c.activeUnit == GL_STATE_UNKNOWN)
+            return nullptr;
+        GLuint unit = c.activeUnit - GL_TEXTURE0;
+        if (unit >= GL_STATE_MAX_UNITS)
+            return nullptr;
+        switch (target)
+        {
+        case GL_TEXTURE_2D:             return &c.textures[unit][TEXTURE_2D];
+        case GL_TEXTURE_CUBE_MAP:       return &c.textures[unit][TEXTURE_CUBE_MAP];
+        case GL_TEXTURE_2D_MULTISAMPLE: return &c.textures[unit][TEXTURE_2D_MULTISAMPLE];
+        case GL_TEXTURE_2D_ARRAY:       return &c.textures[unit][TEXTURE_2D_ARRAY];
+        case GL_TEXTURE_3D:             return &c.textures[unit][TEXTURE_3D];
+        }
+        return nullptr;
+    }
+    static int bufferSlot(GLenum target)
+    {
+        switch (target)
+        {
+        case GL_ARRAY_BUFFER:          return BUFFER_ARRAY;
+        case GL_ELEMENT_ARRAY_BUFFER:  return BUFFER_ELEMENT;
+        case GL_UNIFORM_BUFFER:        return BUFFER_UNIFORM;
+        case GL_SHADER_STORAGE_BUFFER: return BUFFER_SHADER_STORAGE;
+        case GL_PIXEL_UNPACK_BUFFER:   return BUFFER_PIXEL_UNPACK;
+        }
+        return -1;
+    }
+    static void setCapability(GLenum capability, bool enable)
+    {
+        Cache &c = cache();
+        int *enabled = nullptr;
+        for (unsigned int i = 0; i < CAPABILITIES && !enabled; i++)
+            if (c.capabilities[i] == capability)
+                enabled = &c.enabled[i];
+        if (count(GL_STATE_CAPABILITY, enabled && *enabled == (enable ? 1 : 0)))
+            return;
+        if (enabled)
+            *enabled = enable ? 1 : 0;
+        if (enable)
+            glEnable(capability);
+        else
+            glDisable(capability);
+    }
+};
+
+#endif
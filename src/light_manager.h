@@ -0,0 +1,229 @@
+#ifndef LIGHT_MANAGER_H
+#define LIGHT_MANAGER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl_state.h"
+#include "shader_source.h"
+#include "uniform_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// 광원 목록을 SoA 배열 3개로 buffer 하나에 담아 shader가 직접 읽게 함 (uniform 배열을 이름으로 하나씩 올리지 않음)
+//   positions    : uint count (16byte) + vec4[capacity]  xyz 위치
+//   colors       : vec4[capacity]                       rgb 색
+//   attenuations : vec4[capacity]                       x linear, y quadratic, z radius
+// shader 쪽은 shaders/light_list.glsl을 #include하고 Defines()를 넣어서 compile
+// SSBO(GL 4.3)가 있으면 shader storage buffer라 개수는 capacity만큼 (shader에는 크기 제한 없음)
+// 없으면 uniform block으로, capacity는 GL_MAX_UNIFORM_BLOCK_SIZE에 맞게 줄어듦
+// 바뀐 광원만 LIGHT_MANAGER_CHUNK 단위로 배열마다 따로 올림 (위치만 움직이면 colors는 안 올림)
+const unsigned int LIGHT_MANAGER_CHUNK = 64;
+const unsigned int LIGHT_MANAGER_HEADER = 16;   // positions 앞의 count (vec4 정렬)
+
+enum LightArray { LIGHT_POSITIONS, LIGHT_COLORS, LIGHT_ATTENUATIONS, LIGHT_ARRAY_COUNT };
+
+// 업로드 횟수 (여러 프레임 누적)
+struct LightManagerStats
+{
+    unsigned int frames = 0;
+    unsigned int uploads = 0;   // glBufferSubData 호출
+    size_t bytes = 0;
+    size_t fullBytes = 0;       // 매번 전부 올렸다면
+    double uploadMs = 0.0;
+
+    void Reset() { *this = LightManagerStats(); }
+    void Print(const string &name, unsigned int lights, bool storage) const
+    {
+        unsigned int n = frames ? frames : 1;
+        cout << "LIGHT::MANAGER:: " << name << " " << lights << " lights (" << (storage ? "SSBO" : "UBO") << ") | " << uploads / n
+             << " uploads/frame, " << bytes / n << " bytes (full " << fullBytes / n << ") in " << uploadMs * 1000.0 / n << " us" << endl;
+    }
+};
+
+class LightManager
+{
+public:
+    // GL context가 있어야 함 (지원 여부와 크기 제한을 여기서 확인), buffer는 처음 Upload에서 만듦
+    explicit LightManager(unsigned int capacity) : storage(StorageSupported()), count(0), uploadedCount(~0u), buffer(0)
+    {
+        if (!storage)
+        {
+            GLint maxBlockSize = 16384;
+            glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxBlockSize);
+            unsigned int limit = ((unsigned int)maxBlockSize - LIGHT_MANAGER_HEADER) / sizeof(glm::vec4);
+            if (capacity > limit)
+            {
+                cout << "LIGHT::MANAGER:: no shader storage buffer, capacity " << capacity << " -> " << limit << " (uniform block)" << endl;
+                capacity = limit;
+            }
+        }
+        this->capacity = capacity > 0 ? capacity : 1;
+        for (unsigned int a = 0; a < LIGHT_ARRAY_COUNT; a++)
+        {
+            arrays[a].assign(this->capacity, glm::vec4(0.0f));
+            dirty[a].assign((this->capacity + LIGHT_MANAGER_CHUNK - 1) / LIGHT_MANAGER_CHUNK, 1);
+        }
+    }
+    ~LightManager()
+    {
+        if (buffer)
+            GLState::DeleteBuffers(1, &buffer);
+    }
+    LightManager(const LightManager &) = delete;
+    LightManager &operator=(const LightManager &) = delete;
+
+    // GL 4.3 또는 ARB_shader_storage_buffer_object, fragment shader에서 block 3개를 읽을 수 있어야 함
+    static bool StorageSupported()
+    {
+        static int supported = -1;
+        if (supported < 0)
+        {
+            bool extension = GLAD_GL_VERSION_4_3 != 0;
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count && !extension; i++)
+            {
+                const char *name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+                extension = name && strcmp(name, "GL_ARB_shader_storage_buffer_object") == 0;
+            }
+            GLint blocks = 0;
+            if (extension)
+                glGetIntegerv(GL_MAX_FRAGMENT_SHADER_STORAGE_BLOCKS, &blocks);
+            supported = blocks >= (GLint)LIGHT_ARRAY_COUNT ? 1 : 0;
+        }
+        return supported == 1;
+    }
+
+    // shaders/light_list.glsl용 (LIGHTS_SSBO, MAX_LIGHTS)
+    ShaderDefines Defines() const
+    {
+        return ShaderDefines().Set("LIGHTS_SSBO", storage ? 1 : 0).Set("MAX_LIGHTS", (int)capacity);
+    }
+    bool UsesStorage() const { return storage; }
+    unsigned int Capacity() const { return capacity; }
+    unsigned int Count() const { return count; }
+
+    // 새 광원의 index, 넘치면 -1
+    int Add(const glm::vec3 &position, const glm::vec3 &color, float linear = 0.0f, float quadratic = 0.0f, float radius = 0.0f)
+    {
+        if (count >= capacity)
+            return -1;
+        unsigned int index = count++;
+        SetPosition(index, position);
+        SetColor(index, color);
+        SetAttenuation(index, linear, quadratic, radius);
+        return (int)index;
+    }
+    // shader가 읽는 개수 (capacity 안에서 줄이거나 늘림, 뒤쪽 광원 데이터는 그대로 남음)
+    void SetCount(unsigned int count)
+    {
+        this->count = count < capacity ? count : capacity;
+    }
+    // 값이 같으면 dirty로 만들지 않음 (매 프레임 같은 값을 넣어도 업로드 없음)
+    void SetPosition(unsigned int index, const glm::vec3 &position) { set(LIGHT_POSITIONS, index, glm::vec4(position, 1.0f)); }
+    void SetColor(unsigned int index, const glm::vec3 &color) { set(LIGHT_COLORS, index, glm::vec4(color, 1.0f)); }
+    void SetAttenuation(unsigned int index, float linear, float quadratic, float radius)
+    {
+        set(LIGHT_ATTENUATIONS, index, glm::vec4(linear, quadratic, radius, 0.0f));
+    }
+    glm::vec3 Position(unsigned int index) const { return glm::vec3(arrays[LIGHT_POSITIONS][index]); }
+    glm::vec3 Color(unsigned int index) const { return glm::vec3(arrays[LIGHT_COLORS][index]); }
+
+    // 바뀐 chunk만 올림, 처음에는 buffer를 만들고 binding point에 연결
+    void Upload()
+    {
+        auto start = chrono::steady_clock::now();
+        if (!buffer)
+            create();
+        GLenum target = storage ? GL_SHADER_STORAGE_BUFFER : GL_UNIFORM_BUFFER;
+        GLState::BindBuffer(target, buffer);
+        if (count != uploadedCount)
+        {
+            GLuint header[4] = { count, 0, 0, 0 };
+            glBufferSubData(target, offsets[LIGHT_POSITIONS], sizeof(header), header);
+            uploadedCount = count;
+            stats.uploads++;
+            stats.bytes += sizeof(header);
+        }
+        // count가 닿는 chunk까지만 (chunk는 통째로 올려서 나중에 count를 늘려도 빠지는 광원이 없게)
+        unsigned int usedChunks = (count + LIGHT_MANAGER_CHUNK - 1) / LIGHT_MANAGER_CHUNK;
+        for (unsigned int a = 0; a < LIGHT_ARRAY_COUNT; a++)
+        {
+            GLintptr base = offsets[a] + (a == LIGHT_POSITIONS ? LIGHT_MANAGER_HEADER : 0);
+            unsigned int c = 0;
+            while (c < usedChunks)
+            {
+                if (!dirty[a][c])
+                {
+                    c++;
+                    continue;
+                }
+                // 연속된 dirty chunk는 한 번에
+                unsigned int first = c;
+                while (c < usedChunks && dirty[a][c])
+                    dirty[a][c++] = 0;
+                unsigned int begin = first * LIGHT_MANAGER_CHUNK;
+                unsigned int end = min(c * LIGHT_MANAGER_CHUNK, capacity);
+                glBufferSubData(target, base + begin * sizeof(glm::vec4), (end - begin) * sizeof(glm::vec4), &arrays[a][begin]);
+                stats.uploads++;
+                stats.bytes += (end - begin) * sizeof(glm::vec4);
+            }
+        }
+        stats.frames++;
+        stats.fullBytes += LIGHT_MANAGER_HEADER + (size_t)count * sizeof(glm::vec4) * LIGHT_ARRAY_COUNT;
+        stats.uploadMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    LightManagerStats &Stats() { return stats; }
+    void PrintStats(const string &name) const { stats.Print(name, count, storage); }
+
+private:
+    bool storage;
+    unsigned int capacity;
+    unsigned int count;
+    unsigned int uploadedCount;
+    GLuint buffer;
+    GLintptr offsets[LIGHT_ARRAY_COUNT];   // 배열별 시작 (binding offset alignment 배수)
+    vector<glm::vec4> arrays[LIGHT_ARRAY_COUNT];
+    vector<unsigned char> dirty[LIGHT_ARRAY_COUNT];   // chunk별
+    LightManagerStats stats;
+
+    void set(unsigned int array, unsigned int index, const glm::vec4 &value)
+    {
+        if (index >= capacity || arrays[array][index] == value)
+            return;
+        arrays[array][index] = value;
+        dirty[array][index / LIGHT_MANAGER_CHUNK] = 1;
+    }
+
+    void create()
+    {
+        GLenum target = storage ? GL_SHADER_STORAGE_BUFFER : GL_UNIFORM_BUFFER;
+        GLint alignment = 256;
+        glGetIntegerv(storage ? GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT : GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = alignment > 0 ? alignment : 256;
+        GLsizeiptr sizes[LIGHT_ARRAY_COUNT];
+        GLintptr offset = 0;
+        for (unsigned int a = 0; a < LIGHT_ARRAY_COUNT; a++)
+        {
+            sizes[a] = (a == LIGHT_POSITIONS ? LIGHT_MANAGER_HEADER : 0) + (GLsizeiptr)capacity * sizeof(glm::vec4);
+            offsets[a] = offset;
+            offset = (offset + sizes[a] + alignment - 1) / alignment * alignment;
+        }
+        glGenBuffers(1, &buffer);
+        GLState::BindBuffer(target, buffer);
+        glBufferData(target, offset, nullptr, GL_DYNAMIC_DRAW);
+        // binding point 번호는 uniform block과 같음 (light_list.glsl의 layout(binding))
+        const GLuint bindings[LIGHT_ARRAY_COUNT] = { UNIFORM_BLOCK_LIGHT_POSITIONS, UNIFORM_BLOCK_LIGHT_COLORS, UNIFORM_BLOCK_LIGHT_ATTENUATIONS };
+        for (unsigned int a = 0; a < LIGHT_ARRAY_COUNT; a++)
+            GLState::BindBufferRange(target, bindings[a], buffer, offsets[a], sizes[a]);
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#undef APIENTRY
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <sys/stat.h>
+
+#include <cstddef>
+#include <string>
+
+// 파일 수정시간(초), 파일이 없으면 -1
+long long FileModifiedTime(const std::string &path)
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
+        return -1;
+    return (long long)info.st_mtime;
+}
+
+// 읽기 전용 메모리 매핑 파일
+// Windows는 MapViewOfFile, 그 외에는 mmap 사용
+class MappedFile
+{
+public:
+    MappedFile() : data(nullptr), size(0)
+#ifdef _WIN32
+        , file(INVALID_HANDLE_VALUE), mapping(NULL)
+#endif
+    {
+    }
+    ~MappedFile()
+    {
+        Close();
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // 파일 열고 전체를 매핑, 실패하면 false
+    bool Open(const std::string &path)
+    {
+        Close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL)
+        {
+            Close();
+            return false;
+        }
+        data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            Close();
+            return false;
+        }
+        size = (size_t)fileSize.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+        void *ptr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // 매핑은 fd를 닫아도 유지됨
+        if (ptr == MAP_FAILED)
+            return false;
+        data = (const unsigned char*)ptr;
+        size = (size_t)info.st_size;
+#endif
+        return true;
+    }
+    void Close()
+    {
+#ifdef _WIN32
+        if (data != nullptr)
+            UnmapViewOfFile(data);
+        if (mapping != NULL)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        mapping = NULL;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data != nullptr)
+            munmap((void*)data, size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const unsigned char *Data() const { return data; }
+    size_t Size() const { return size; }
+    bool IsOpen() const { return data != nullptr; }
+
+private:
+    const unsigned char *data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef MATERIAL_H
+#define MATERIAL_H
+
+#include <glad/glad.h>
+
+#include "gl_state.h"
+#include "uniform_table.h"
+
+#include <string>
+#include <vector>
+using namespace std;
+
+// mesh 텍스처 종류, shader의 sampler 이름은 texture_diffuse1, texture_specular1 ...
+enum MaterialTextureType
+{
+    MATERIAL_TEXTURE_DIFFUSE,
+    MATERIAL_TEXTURE_SPECULAR,
+    MATERIAL_TEXTURE_NORMAL,
+    MATERIAL_TEXTURE_HEIGHT,
+    MATERIAL_TEXTURE_UNKNOWN,
+};
+
+inline const char *MaterialTextureName(MaterialTextureType type)
+{
+    static const char *names[] = { "texture_diffuse", "texture_specular", "texture_normal", "texture_height", "" };
+    return names[type];
+}
+
+inline MaterialTextureType MaterialTextureTypeFromName(const string &name)
+{
+    for (int type = 0; type < MATERIAL_TEXTURE_UNKNOWN; type++)
+        if (name == MaterialTextureName((MaterialTextureType)type))
+            return (MaterialTextureType)type;
+    return MATERIAL_TEXTURE_UNKNOWN;
+}
+
+// GL에 올라간 텍스처, type은 assimp에서 읽을 때의 이름 (texture_diffuse 등)
+struct Texture{
+    unsigned int id;
+    string type;
+    string path;
+};
+
+// 텍스처 목록을 로드할 때 한 번 정리해 두고, shader별 sampler 위치는 처음 쓸 때 한 번만 조회
+// Bind()는 문자열/할당 없이 미리 만든 표대로 유닛 바인딩 + glUniform1i만 함
+class Material
+{
+public:
+    struct Slot
+    {
+        unsigned int texture;      // GL 텍스처 id
+        MaterialTextureType type;
+        unsigned int number;       // 같은 종류 안에서 몇 번째인지 (1부터, sampler 이름의 N)
+    };
+    // shader 하나에 대해 조회해 둔 uniform 위치 (없으면 -1)
+    struct Binding
+    {
+        unsigned int program;
+        vector<GLint> samplers;    // slots와 같은 순서
+        GLint model;               // render_queue.h에서 draw마다 설정
+        GLint positionOffset;      // 압축 vertex 복원용 (mesh.h)
+        GLint positionScale;
+    };
+
+    Material() : id(nextId()), lastBinding(0) { }
+
+    // textures의 type 문자열은 여기서만 비교함
+    explicit Material(const vector<Texture> &textures) : id(nextId()), lastBinding(0)
+    {
+        unsigned int numbers[MATERIAL_TEXTURE_UNKNOWN + 1] = { 0 };
+        slots.reserve(textures.size());
+        for (unsigned int i = 0; i < textures.size(); i++)
+        {
+            Slot slot;
+            slot.texture = textures[i].id;
+            slot.type = MaterialTextureTypeFromName(textures[i].type);
+            slot.number = ++numbers[slot.type];
+            slots.push_back(slot);
+        }
+    }
+
+    const vector<Slot> &Slots() const { return slots; }
+    // 정렬 키용 번호 (만들어진 순서)
+    unsigned int Id() const { return id; }
+
+    // program의 uniform 위치 표 (없으면 만듦), 같은 program으로 연속으로 그리면 바로 반환
+    const Binding &Resolve(GLuint program) const
+    {
+        if (lastBinding < bindings.size() && bindings[lastBinding].program == program)
+            return bindings[lastBinding];
+        for (unsigned int i = 0; i < bindings.size(); i++)
+            if (bindings[i].program == program)
+            {
+                lastBinding = i;
+                return bindings[i];
+            }
+
+        Binding binding;
+        binding.program = program;
+        binding.samplers.resize(slots.size(), -1);
+        for (unsigned int i = 0; i < slots.size(); i++)
+        {
+            if (slots[i].type == MATERIAL_TEXTURE_UNKNOWN)
+                continue;
+            string name = MaterialTextureName(slots[i].type) + to_string(slots[i].number);
+            binding.samplers[i] = glGetUniformLocation(program, name.c_str());
+        }
+        binding.model = glGetUniformLocation(program, "model");
+        binding.positionOffset = glGetUniformLocation(program, "positionOffset");
+        binding.positionScale = glGetUniformLocation(program, "positionScale");
+        bindings.push_back(binding);
+        lastBinding = (unsigned int)bindings.size() - 1;
+        return bindings.back();
+    }
+
+    // slot i를 텍스처 유닛 i에 바인딩하고 sampler를 유닛에 연결 (program은 use 된 상태)
+    const Binding &Bind(GLuint program) const
+    {
+        const Binding &binding = Resolve(program);
+        for (unsigned int i = 0; i < slots.size(); i++)
+        {
+            GLState::ActiveTexture(GL_TEXTURE0 + i);
+            if (binding.samplers[i] >= 0)
+            {
+                glUniform1i(binding.samplers[i], (GLint)i);
+                UniformTable::Forget(program, binding.samplers[i]);
+            }
+            GLState::BindTexture(GL_TEXTURE_2D, slots[i].texture);
+        }
+        GLState::ActiveTexture(GL_TEXTURE0);
+        return binding;
+    }
+
+private:
+    unsigned int id;
+    vector<Slot> slots;
+    // shader별 표, 보통 1~3개라서 선형 탐색 (Resolve가 추가하면 이전 참조는 무효)
+    mutable vector<Binding> bindings;
+    mutable unsigned int lastBinding;
+
+    static unsigned int nextId()
+    {
+        static unsigned int counter = 0;
+        return ++counter;
+    }
+};
+
+#endif
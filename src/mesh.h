@@ -6,116 +6,345 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "shader.h"
+#include "material.h"
+#include "meshlet.h"
+#include "render_queue.h"
+#include "vertex_layout.h"
+#include "gl_state.h"
 
 #include <string>
 #include <vector>
 using namespace std;
 
-#define MAX_BONE_INFLUENCE 4
-
-struct Vertex{
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
-    glm::vec3 Tangent;
-    glm::vec3 Bitangent;
-    int m_BoneIDs[MAX_BONE_INFLUENCE];
-    float m_Weights[MAX_BONE_INFLUENCE];
-};
-struct Texture{
-    unsigned int id;
+// 아직 GL에 올라가지 않은 텍스처 참조 (type, 파일경로)
+struct TextureRef{
     string type;
     string path;
 };
+// 단순화된 index (vertex는 원본과 공유), mesh_simplify.h에서 생성
+struct MeshLodData{
+    vector<unsigned int> indices;
+    float error; // 원본 대비 최대 오차 (model space 거리)
+};
+// GL과 무관한 CPU 쪽 mesh 데이터, worker thread에서 만들어짐
+struct MeshData{
+    vector<Vertex> vertices;
+    vector<unsigned int> indices;
+    vector<TextureRef> textures;
+    unsigned int layout = VERTEX_LAYOUT_FULL; // 원본에 있는 attribute (VertexAttributeBits)
+    vector<MeshLodData> lods;                 // LOD1부터, 비어있으면 LOD0만
+};
+// EBO 안의 LOD 하나 범위
+struct MeshLod{
+    unsigned int firstIndex;
+    unsigned int indexCount;
+    float error;
+};
+// 압축된 vertex (20 byte), 인코딩과 오차 측정은 vertex_compress.h
+struct CompressedVertex{
+    unsigned short Position[4];  // mesh AABB 기준 unorm16, w는 bitangent 부호 (0: -1, 65535: +1)
+    short Normal[2];             // octahedral snorm16
+    unsigned short TexCoords[2]; // half float
+    short Tangent[2];            // octahedral snorm16
+};
+struct CompressedMeshData{
+    vector<CompressedVertex> vertices;
+    vector<unsigned short> indices16; // vertex가 65536개 이하일 때만 채워짐, 비어있으면 32bit index 사용
+    glm::vec3 positionOffset;         // AABB min
+    glm::vec3 positionScale;          // AABB 크기
+};
 
 class Mesh{
 public:
-    //Mesh 데이터
+    //Mesh 데이터 (CPU 쪽), ReleaseCpuData() 후에는 비어있음
     vector<Vertex> vertices;
-    vector<unsigned int> indices;
+    vector<unsigned int> indices;     // LOD0
+    vector<unsigned int> lodIndices;  // LOD1.. 를 이어붙인 것
+    unsigned int VertexCount;         // GPU에 올라간 개수 (CPU 데이터를 버려도 유지)
     vector<Texture> textures;
+    Material material;                // textures로 만든 바인딩 표 (sampler 이름/위치 조회는 로드 후 한 번)
+    vector<MeshLod> Lods;             // Lods[0]이 원본, EBO 안에서 indices 뒤에 lodIndices 순서
+    vector<Meshlet> Meshlets;         // LOD0을 나눈 묶음 (meshlet.h), 비어있으면 DrawCulled도 전체를 그림
+    glm::vec3 BoundsMin, BoundsMax;   // model space AABB
     unsigned int VAO;
+    unsigned int Layout; // GPU에 올린 attribute (VertexAttributeBits)
+    //압축 vertex 정보, shader에서 positionOffset + aPos.xyz * positionScale로 복원
+    bool Compressed;
+    glm::vec3 PositionOffset;
+    glm::vec3 PositionScale;
+    GLenum IndexType; // GL_UNSIGNED_INT 또는 GL_UNSIGNED_SHORT
     //함수
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures)
+    //데이터는 복사하지 않고 가져옴 (호출하는 쪽에서 std::move)
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures,
+         unsigned int layout = VERTEX_LAYOUT_FULL, const CompressedMeshData *compressed = nullptr,
+         const vector<MeshLodData> &lods = vector<MeshLodData>())
+        : vertices(std::move(vertices)), indices(std::move(indices)), VertexCount((unsigned int)this->vertices.size()),
+          textures(std::move(textures)), material(this->textures), BoundsMin(0.0f), BoundsMax(0.0f), Layout(layout), Compressed(compressed != nullptr),
+          PositionOffset(0.0f), PositionScale(1.0f), IndexType(GL_UNSIGNED_INT)
     {
-        this->vertices = vertices;
-        this->indices = indices;
-        this->textures = textures;
+        // 인자는 이미 비어있으므로 아래는 멤버만 사용
+        if (VertexCount > 0)
+            BoundsMin = BoundsMax = this->vertices[0].Position;
+        for (unsigned int i = 1; i < VertexCount; i++)
+        {
+            BoundsMin = glm::min(BoundsMin, this->vertices[i].Position);
+            BoundsMax = glm::max(BoundsMax, this->vertices[i].Position);
+        }
+        unsigned int indexCount = (unsigned int)this->indices.size();
+        MeshLod base = { 0, indexCount, 0.0f };
+        Lods.push_back(base);
+        for (unsigned int i = 0; i < lods.size(); i++)
+        {
+            MeshLod lod = { (unsigned int)(indexCount + lodIndices.size()), (unsigned int)lods[i].indices.size(), lods[i].error };
+            Lods.push_back(lod);
+            lodIndices.insert(lodIndices.end(), lods[i].indices.begin(), lods[i].indices.end());
+        }
 
-        setupMesh();
+        if (compressed)
+            setupCompressedMesh(*compressed);
+        else
+            setupMesh();
     }
-    void Draw(Shader shader)
+    //GL 객체는 하나만 있으므로 이동만 가능, 이동하면 GL 객체도 넘어가고 원래 mesh는 0이 됨
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+    Mesh(Mesh &&other) noexcept
+        : vertices(std::move(other.vertices)), indices(std::move(other.indices)), lodIndices(std::move(other.lodIndices)), VertexCount(other.VertexCount),
+          textures(std::move(other.textures)), material(std::move(other.material)), Lods(std::move(other.Lods)), Meshlets(std::move(other.Meshlets)),
+          BoundsMin(other.BoundsMin), BoundsMax(other.BoundsMax), VAO(other.VAO), Layout(other.Layout), Compressed(other.Compressed),
+          PositionOffset(other.PositionOffset), PositionScale(other.PositionScale), IndexType(other.IndexType), VBO(other.VBO), EBO(other.EBO),
+          cullCounts(std::move(other.cullCounts)), cullOffsets(std::move(other.cullOffsets))
     {
-        unsigned int diffuseNr = 1;
-        unsigned int specularNr = 1;
-        unsigned int normalNr = 1;
-        unsigned int heightNr = 1;
-        for(unsigned int i = 0; i < textures.size(); i++)
-        {
-            glActiveTexture(GL_TEXTURE0 + i); // 바인딩하기 전에 텍스처 유닛 활성화
-            // 텍스처 넘버(diffuse_textureN 에서 N) 구하기
-            string number;
-            string name = textures[i].type;
-            if(name == "texture_diffuse")
-                number = std::to_string(diffuseNr++);
-            else if(name == "texture_specular")
-                number = std::to_string(specularNr++);
-            else if(name == "texture_normal")
-                number = std::to_string(normalNr++);
-            else if(name == "texture_height")
-                number = std::to_string(heightNr++);
-
-            glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), i);
-            glBindTexture(GL_TEXTURE_2D, textures[i].id);
-        }
-        glActiveTexture(GL_TEXTURE0);
+        other.VAO = other.VBO = other.EBO = 0;
+    }
+    Mesh &operator=(Mesh &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        ReleaseGpuBuffers();
+        vertices = std::move(other.vertices);
+        indices = std::move(other.indices);
+        lodIndices = std::move(other.lodIndices);
+        VertexCount = other.VertexCount;
+        textures = std::move(other.textures);
+        material = std::move(other.material);
+        Lods = std::move(other.Lods);
+        Meshlets = std::move(other.Meshlets);
+        BoundsMin = other.BoundsMin;
+        BoundsMax = other.BoundsMax;
+        Layout = other.Layout;
+        Compressed = other.Compressed;
+        PositionOffset = other.PositionOffset;
+        PositionScale = other.PositionScale;
+        IndexType = other.IndexType;
+        cullCounts = std::move(other.cullCounts);
+        cullOffsets = std::move(other.cullOffsets);
+        VAO = other.VAO;
+        VBO = other.VBO;
+        EBO = other.EBO;
+        other.VAO = other.VBO = other.EBO = 0;
+        return *this;
+    }
+    ~Mesh()
+    {
+        ReleaseGpuBuffers();
+    }
+
+    //업로드가 끝난 CPU 데이터 해제 (culling/picking에 필요하면 호출하지 않음)
+    size_t ReleaseCpuData()
+    {
+        size_t bytes = vertices.capacity() * sizeof(Vertex) + (indices.capacity() + lodIndices.capacity()) * sizeof(unsigned int);
+        vector<Vertex>().swap(vertices);
+        vector<unsigned int>().swap(indices);
+        vector<unsigned int>().swap(lodIndices);
+        return bytes;
+    }
+    //mesh별 VAO/VBO/EBO 삭제 (MeshArena로만 그릴 때), 이후 Draw/DrawCulled/Submit은 아무것도 안 함
+    size_t ReleaseGpuBuffers()
+    {
+        if (VAO == 0)
+            return 0;
+        const MeshLod &last = Lods.back();
+        size_t bytes = VertexBytes() + (size_t)(last.firstIndex + last.indexCount) * (IndexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int));
+        GLState::DeleteVertexArrays(1, &VAO);
+        GLState::DeleteBuffers(1, &VBO);
+        GLState::DeleteBuffers(1, &EBO);
+        VAO = VBO = EBO = 0;
+        return bytes;
+    }
+    // EBO 안에서 index 위치 -> draw 호출용 offset
+    void *IndexOffset(unsigned int firstIndex) const
+    {
+        return (void*)((size_t)firstIndex * (IndexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int)));
+    }
+    // GPU vertex buffer 크기 (byte)
+    size_t VertexBytes() const
+    {
+        return (size_t)VertexCount * (Compressed ? sizeof(CompressedVertex) : GetVertexLayout(Layout).stride);
+    }
+    void Draw(const Shader &shader, unsigned int lod = 0)
+    {
+        if (VAO == 0)
+            return;
+        bindMaterial(shader);
 
         // mesh 그리기
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        const MeshLod &range = Lods[lod < Lods.size() ? lod : Lods.size() - 1];
+        GLState::BindVertexArray(VAO);
+        glDrawElements(GL_TRIANGLES, range.indexCount, IndexType, IndexOffset(range.firstIndex));
+    }
+    // 바로 그리지 않고 queue에 넣음, model은 shader의 "model" uniform으로 설정됨
+    void Submit(RenderQueue &queue, const Shader &shader, const glm::mat4 &model, unsigned int depth,
+                unsigned int lod = 0, unsigned int pass = 0) const
+    {
+        if (VAO == 0)
+            return;
+        const MeshLod &range = Lods[lod < Lods.size() ? lod : Lods.size() - 1];
+        RenderCommand command = RenderQueue::Command();
+        command.key = RenderQueue::MakeKey(pass, false, shader.ID, material.Id(), depth);
+        command.program = shader.ID;
+        command.vao = VAO;
+        command.material = &material;
+        command.indexType = IndexType;
+        command.count = (GLsizei)range.indexCount;
+        command.indexOffset = IndexOffset(range.firstIndex);
+        command.modelLocation = material.Resolve(shader.ID).model;
+        command.model = model;
+        if (Compressed)
+        {
+            command.uniforms = applyCompressedUniforms;
+            command.object = this;
+        }
+        queue.Submit(command);
+    }
+    // meshlet 단위 culling 후 보이는 구간만 그림, frustum/eye는 이 mesh의 model space 기준
+    void DrawCulled(const Shader &shader, const Frustum &frustum, const glm::vec3 &eye, MeshletCullStats &stats)
+    {
+        if (Meshlets.empty())
+        {
+            stats.trianglesTotal += Lods[0].indexCount / 3;
+            stats.trianglesDrawn += Lods[0].indexCount / 3;
+            Draw(shader);
+            return;
+        }
+        if (VAO == 0)
+            return;
+        CullMeshlets(Meshlets, frustum, eye, IndexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int),
+                     cullCounts, cullOffsets, stats);
+        if (cullCounts.empty())
+            return;
+        bindMaterial(shader);
+        GLState::BindVertexArray(VAO);
+        glMultiDrawElements(GL_TRIANGLES, cullCounts.data(), IndexType, cullOffsets.data(), (GLsizei)cullCounts.size());
+        GLState::BindVertexArray(0);
     }
 private:
     //렌더링 데이터
     unsigned int VBO, EBO;
+    // DrawCulled에서 보이는 meshlet 구간 (매번 할당하지 않도록 재사용)
+    vector<GLsizei> cullCounts;
+    vector<const void*> cullOffsets;
+
+    // 텍스처와 압축 복원 uniform (위치는 material에 캐시된 것 사용)
+    void bindMaterial(const Shader &shader)
+    {
+        const Material::Binding &binding = material.Bind(shader.ID);
+        if (Compressed)
+        {
+            glUniform3fv(binding.positionOffset, 1, &PositionOffset[0]);
+            glUniform3fv(binding.positionScale, 1, &PositionScale[0]);
+            UniformTable::Forget(shader.ID, binding.positionOffset);
+            UniformTable::Forget(shader.ID, binding.positionScale);
+        }
+    }
+    // queue에서 실행될 때 압축 복원 uniform
+    static void applyCompressedUniforms(const RenderCommand &command)
+    {
+        const Mesh *mesh = (const Mesh*)command.object;
+        const Material::Binding &binding = mesh->material.Resolve(command.program);
+        glUniform3fv(binding.positionOffset, 1, &mesh->PositionOffset[0]);
+        glUniform3fv(binding.positionScale, 1, &mesh->PositionScale[0]);
+        UniformTable::Forget(command.program, binding.positionOffset);
+        UniformTable::Forget(command.program, binding.positionScale);
+    }
+    // LOD0 + lodIndices를 EBO에 (합친 사본을 만들지 않고 두 번에 나눠 올림)
+    void uploadIndices(const unsigned int *base)
+    {
+        size_t baseBytes = (size_t)Lods[0].indexCount * sizeof(unsigned int);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, baseBytes + lodIndices.size() * sizeof(unsigned int), NULL, GL_STATIC_DRAW);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, baseBytes, base);
+        if (!lodIndices.empty())
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, baseBytes, lodIndices.size() * sizeof(unsigned int), lodIndices.data());
+    }
     void setupMesh()
     {
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
     
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);  
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-        // vertex positions
-        glEnableVertexAttribArray(0);	
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-        // vertex normals
-        glEnableVertexAttribArray(1);	
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-        // vertex texture coords
-        glEnableVertexAttribArray(2);	
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-        // vertex tangent
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
-        // vertex bitangent
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
-		// ids
-		glEnableVertexAttribArray(5);
-		glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, m_BoneIDs));
-		// weights
-		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Weights));
+        GLState::BindVertexArray(VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+
+        // Layout에 있는 attribute만 촘촘하게 담아서 업로드
+        const VertexLayoutOps &layout = GetVertexLayout(Layout);
+        vector<unsigned char> packed(vertices.size() * layout.stride);
+        layout.pack(vertices.data(), vertices.size(), packed.data());
+        glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), GL_STATIC_DRAW);
+
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        uploadIndices(indices.data());
+
+        // vertex attribute (없는 attribute는 꺼둠, shader에서는 기본값 0)
+        layout.setupAttributes();
         
-        glBindVertexArray(0);
-    }  
+        GLState::BindVertexArray(0);
+    }
+    // 압축 vertex 업로드, attribute 위치는 setupMesh와 같음 (bone 없음, 4번은 비움)
+    void setupCompressedMesh(const CompressedMeshData &data)
+    {
+        PositionOffset = data.positionOffset;
+        PositionScale = data.positionScale;
+        IndexType = data.indices16.empty() ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        GLState::BindVertexArray(VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(CompressedVertex), data.vertices.data(), GL_STATIC_DRAW);
+
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        if (IndexType == GL_UNSIGNED_SHORT)
+        {
+            vector<unsigned short> allIndices(data.indices16);
+            allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, allIndices.size() * sizeof(unsigned short), allIndices.data(), GL_STATIC_DRAW);
+        }
+        else
+            uploadIndices(indices.data());
+
+        // vertex positions (unorm16 xyz + bitangent 부호)
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompressedVertex), (void*)offsetof(CompressedVertex, Position));
+        // vertex normals (octahedral)
+        if (Layout & VERTEX_NORMAL)
+        {
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompressedVertex), (void*)offsetof(CompressedVertex, Normal));
+        }
+        // vertex texture coords (half)
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompressedVertex), (void*)offsetof(CompressedVertex, TexCoords));
+        // vertex tangent (octahedral)
+        if (Layout & VERTEX_TANGENT)
+        {
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, sizeof(CompressedVertex), (void*)offsetof(CompressedVertex, Tangent));
+        }
+
+        GLState::BindVertexArray(0);
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,202 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <glad/glad.h>
+
+#include "gl_state.h"
+#include "mesh.h"
+#include "shader.h"
+#include "vertex_layout.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+using namespace std;
+
+// glMultiDrawElementsIndirect 명령 하나 (GL spec 구조 그대로)
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint  baseVertex;
+    GLuint baseInstance;
+};
+
+// 여러 Mesh를 VBO/EBO 하나에 몰아넣고 텍스처 묶음(material)별로 한 번씩 그림
+// GL 4.3 이상이면 glMultiDrawElementsIndirect, 아니면 glDrawElementsBaseVertex로 명령을 하나씩 실행
+// 압축 vertex(CompressedVertex)는 mesh마다 복원 uniform이 달라서 지원하지 않음
+// LOD가 있으면 LOD마다 같은 순서의 명령 묶음을 따로 둠 (commands[lod * meshCount + ...])
+class MeshArena
+{
+public:
+    unsigned int VAO;
+
+    MeshArena() : VAO(0), VBO(0), EBO(0), commandBuffer(0), layout(0), vertexBytes(0), lodCount(0) { }
+    ~MeshArena()
+    {
+        if (VAO == 0)
+            return;
+        GLState::DeleteVertexArrays(1, &VAO);
+        GLState::DeleteBuffers(1, &VBO);
+        GLState::DeleteBuffers(1, &EBO);
+        if (commandBuffer != 0)
+            GLState::DeleteBuffers(1, &commandBuffer);
+    }
+    MeshArena(const MeshArena &) = delete;
+    MeshArena &operator=(const MeshArena &) = delete;
+
+    // meshes의 CPU 데이터로 arena 생성, 압축 mesh가 있으면 false
+    bool Build(const vector<Mesh> &meshes)
+    {
+        commands.clear();
+        groups.clear();
+        layout = 0;
+        lodCount = 1;
+        size_t vertexCount = 0, indexCount = 0;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            if (meshes[i].Compressed)
+                return false;
+            layout |= meshes[i].Layout; // 모든 mesh가 같은 형식을 써야 하므로 합집합
+            vertexCount += meshes[i].vertices.size();
+            indexCount += meshes[i].indices.size() + meshes[i].lodIndices.size();
+            lodCount = max(lodCount, (unsigned int)meshes[i].Lods.size());
+        }
+        const VertexLayoutOps &ops = GetVertexLayout(layout);
+
+        // 1. vertex/index 이어붙이기, mesh와 LOD마다 base vertex와 first index 기록
+        //    LOD가 부족한 mesh는 가장 낮은 LOD를 계속 씀
+        vector<unsigned char> vertices(vertexCount * ops.stride);
+        vector<unsigned int> indices;
+        indices.reserve(indexCount);
+        vector<DrawElementsIndirectCommand> meshCommands(meshes.size() * lodCount);
+        size_t baseVertex = 0;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            const Mesh &mesh = meshes[i];
+            ops.pack(mesh.vertices.data(), mesh.vertices.size(), &vertices[baseVertex * ops.stride]);
+            GLuint firstIndex = (GLuint)indices.size();
+            for (unsigned int lod = 0; lod < lodCount; lod++)
+            {
+                const MeshLod &range = mesh.Lods[min(lod, (unsigned int)mesh.Lods.size() - 1)];
+                DrawElementsIndirectCommand &command = meshCommands[lod * meshes.size() + i];
+                command.count = (GLuint)range.indexCount;
+                command.instanceCount = 1;
+                command.firstIndex = firstIndex + range.firstIndex;
+                command.baseVertex = (GLint)baseVertex;
+                command.baseInstance = 0;
+            }
+            indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+            indices.insert(indices.end(), mesh.lodIndices.begin(), mesh.lodIndices.end());
+            baseVertex += mesh.vertices.size();
+        }
+
+        // 2. 같은 텍스처 묶음을 쓰는 mesh끼리 명령을 연속으로 배치
+        map<vector<unsigned int>, unsigned int> groupIndex;
+        vector<vector<unsigned int>> groupMeshes;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            vector<unsigned int> key;
+            for (unsigned int j = 0; j < meshes[i].textures.size(); j++)
+                key.push_back(meshes[i].textures[j].id);
+            map<vector<unsigned int>, unsigned int>::iterator it = groupIndex.find(key);
+            if (it == groupIndex.end())
+            {
+                it = groupIndex.insert(make_pair(key, (unsigned int)groups.size())).first;
+                Group group;
+                group.material = Material(meshes[i].textures);
+                groups.push_back(group);
+                groupMeshes.push_back(vector<unsigned int>());
+            }
+            groupMeshes[it->second].push_back(i);
+        }
+        for (unsigned int lod = 0; lod < lodCount; lod++)
+            for (unsigned int g = 0; g < groups.size(); g++)
+            {
+                if (lod == 0)
+                {
+                    groups[g].firstCommand = (unsigned int)commands.size();
+                    groups[g].commandCount = (unsigned int)groupMeshes[g].size();
+                }
+                for (unsigned int j = 0; j < groupMeshes[g].size(); j++)
+                    commands.push_back(meshCommands[lod * meshes.size() + groupMeshes[g][j]]);
+            }
+
+        // 3. GL buffer
+        if (VAO == 0)
+        {
+            glGenVertexArrays(1, &VAO);
+            glGenBuffers(1, &VBO);
+            glGenBuffers(1, &EBO);
+        }
+        GLState::BindVertexArray(VAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size(), vertices.data(), GL_STATIC_DRAW);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        ops.setupAttributes();
+        GLState::BindVertexArray(0);
+        vertexBytes = vertices.size() + indices.size() * sizeof(unsigned int);
+
+        if (GLAD_GL_VERSION_4_3)
+        {
+            if (commandBuffer == 0)
+                glGenBuffers(1, &commandBuffer);
+            GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data(), GL_STATIC_DRAW);
+            GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+        return true;
+    }
+
+    // material 묶음마다 텍스처 바인딩 + multi draw 한 번
+    void Draw(const Shader &shader, unsigned int lod = 0) const
+    {
+        // LOD 묶음은 mesh 수(= LOD0 명령 수)만큼씩 떨어져 있음
+        unsigned int lodBase = min(lod, lodCount - 1) * (unsigned int)(commands.size() / lodCount);
+        GLState::BindVertexArray(VAO);
+        if (commandBuffer != 0)
+            GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+        for (unsigned int g = 0; g < groups.size(); g++)
+        {
+            const Group &group = groups[g];
+            unsigned int firstCommand = lodBase + group.firstCommand;
+            group.material.Bind(shader.ID);
+            if (commandBuffer != 0)
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                    (void*)(firstCommand * sizeof(DrawElementsIndirectCommand)), group.commandCount, 0);
+            else
+            {
+                for (unsigned int i = firstCommand; i < firstCommand + group.commandCount; i++)
+                    glDrawElementsBaseVertex(GL_TRIANGLES, commands[i].count, GL_UNSIGNED_INT,
+                        (void*)(commands[i].firstIndex * sizeof(unsigned int)), commands[i].baseVertex);
+            }
+        }
+        if (commandBuffer != 0)
+            GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        GLState::BindVertexArray(0);
+    }
+
+    bool IsBuilt() const { return VAO != 0 && !commands.empty(); }
+    unsigned int DrawCalls() const { return (unsigned int)groups.size(); }
+    unsigned int Commands() const { return lodCount ? (unsigned int)commands.size() / lodCount : 0; }
+    unsigned int LodCount() const { return lodCount; }
+    size_t Bytes() const { return vertexBytes; }
+
+private:
+    struct Group
+    {
+        Material material;
+        unsigned int firstCommand;
+        unsigned int commandCount;
+    };
+    unsigned int VBO, EBO, commandBuffer;
+    unsigned int layout;
+    size_t vertexBytes;
+    unsigned int lodCount;
+    vector<DrawElementsIndirectCommand> commands;
+    vector<Group> groups;
+};
+
+#endif
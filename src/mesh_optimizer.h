@@ -0,0 +1,296 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// import 단계 mesh 최적화 (GL 호출 없음, worker thread에서 실행)
+// 1. 같은 vertex 합치기 (hash)
+// 2. Tipsify로 vertex cache 친화적인 삼각형 순서 (Sander et al. 2007)
+// 3. Tipsify 경계 단위 cluster를 바깥을 보는 순서로 정렬해서 overdraw 감소
+// 4. index 순서대로 vertex 재배치 (vertex fetch 지역성)
+const unsigned int MESH_OPTIMIZER_CACHE_SIZE = 16; // Tipsify와 ACMR 계산에 쓰는 FIFO cache 크기
+
+struct MeshOptimizeReport
+{
+    unsigned int verticesBefore = 0, verticesAfter = 0;
+    unsigned int triangles = 0;
+    unsigned int clusters = 0;
+    float acmrBefore = 0.0f, acmrAfter = 0.0f; // 삼각형당 cache miss (최소 0.5)
+    float atvrBefore = 0.0f, atvrAfter = 0.0f; // vertex당 cache miss (최소 1.0)
+
+    void Print(const string &name) const
+    {
+        cout << "MESH::OPTIMIZE:: " << name << " vertices " << verticesBefore << " -> " << verticesAfter
+             << " | " << triangles << " triangles, " << clusters << " clusters | ACMR " << acmrBefore << " -> " << acmrAfter
+             << " | ATVR " << atvrBefore << " -> " << atvrAfter << endl;
+    }
+};
+
+// FIFO vertex cache 시뮬레이션, cache miss 수 반환
+inline unsigned int SimulateVertexCache(const vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize = MESH_OPTIMIZER_CACHE_SIZE)
+{
+    // vertex가 cache에 들어간 시점(miss 번호)으로 FIFO 판정
+    vector<unsigned int> insertedAt(vertexCount, 0);
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < indices.size(); i++)
+    {
+        unsigned int v = indices[i];
+        if (insertedAt[v] == 0 || misses + 1 - insertedAt[v] > cacheSize)
+        {
+            misses++;
+            insertedAt[v] = misses;
+        }
+    }
+    return misses;
+}
+
+// 완전히 같은 vertex를 하나로 합침
+inline void WeldVertices(vector<Vertex> &vertices, vector<unsigned int> &indices)
+{
+    struct VertexHash
+    {
+        size_t operator()(const Vertex &v) const
+        {
+            // FNV-1a (Vertex에는 padding이 없음)
+            const unsigned char *bytes = (const unsigned char*)&v;
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < sizeof(Vertex); i++)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            return (size_t)hash;
+        }
+    };
+    struct VertexEqual
+    {
+        bool operator()(const Vertex &a, const Vertex &b) const { return memcmp(&a, &b, sizeof(Vertex)) == 0; }
+    };
+
+    unordered_map<Vertex, unsigned int, VertexHash, VertexEqual> unique;
+    unique.reserve(vertices.size());
+    vector<unsigned int> remap(vertices.size());
+    vector<Vertex> welded;
+    welded.reserve(vertices.size());
+    for (unsigned int i = 0; i < vertices.size(); i++)
+    {
+        auto inserted = unique.insert(make_pair(vertices[i], (unsigned int)welded.size()));
+        if (inserted.second)
+            welded.push_back(vertices[i]);
+        remap[i] = inserted.first->second;
+    }
+    for (unsigned int i = 0; i < indices.size(); i++)
+        indices[i] = remap[indices[i]];
+    vertices.swap(welded);
+}
+
+// Tipsify 삼각형 재배치, clusterStarts에 hard boundary(dead-end로 건너뛴 위치, 삼각형 번호) 기록
+inline vector<unsigned int> TipsifyIndices(const vector<unsigned int> &indices, unsigned int vertexCount, unsigned int cacheSize,
+                                           vector<unsigned int> &clusterStarts)
+{
+    unsigned int triangleCount = (unsigned int)indices.size() / 3;
+    // vertex -> 삼각형 인접 리스트 (CSR)
+    vector<unsigned int> live(vertexCount, 0);
+    for (unsigned int i = 0; i < indices.size(); i++)
+        live[indices[i]]++;
+    vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (unsigned int v = 0; v < vertexCount; v++)
+        offsets[v + 1] = offsets[v] + live[v];
+    vector<unsigned int> adjacency(indices.size());
+    vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned int t = 0; t < triangleCount; t++)
+        for (unsigned int k = 0; k < 3; k++)
+            adjacency[fill[indices[t * 3 + k]]++] = t;
+
+    vector<unsigned int> cacheTime(vertexCount, 0);
+    vector<bool> emitted(triangleCount, false);
+    vector<unsigned int> deadEnd;
+    vector<unsigned int> candidates;
+    vector<unsigned int> result;
+    result.reserve(indices.size());
+    clusterStarts.clear();
+
+    unsigned int timestamp = cacheSize + 1;
+    unsigned int cursor = 0;
+    int fanning = vertexCount > 0 ? 0 : -1;
+    bool boundary = true;
+    while (fanning >= 0)
+    {
+        if (boundary)
+            clusterStarts.push_back((unsigned int)result.size() / 3);
+        // fanning vertex 주변 삼각형 전부 출력
+        candidates.clear();
+        for (unsigned int a = offsets[fanning]; a < offsets[fanning + 1]; a++)
+        {
+            unsigned int t = adjacency[a];
+            if (emitted[t])
+                continue;
+            emitted[t] = true;
+            for (unsigned int k = 0; k < 3; k++)
+            {
+                unsigned int v = indices[t * 3 + k];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                if (timestamp - cacheTime[v] > cacheSize)
+                    cacheTime[v] = timestamp++;
+            }
+        }
+        // 다음 fanning vertex: cache에 남아있을 1-ring 중 가장 오래된 것
+        int next = -1;
+        int best = -1;
+        for (unsigned int c = 0; c < candidates.size(); c++)
+        {
+            unsigned int v = candidates[c];
+            if (live[v] == 0)
+                continue;
+            int priority = 0;
+            if (timestamp - cacheTime[v] + 2 * live[v] <= cacheSize)
+                priority = (int)(timestamp - cacheTime[v]);
+            if (priority > best)
+            {
+                best = priority;
+                next = (int)v;
+            }
+        }
+        boundary = false;
+        if (next < 0)
+        {
+            // dead-end: 최근 vertex stack, 그래도 없으면 순서대로 탐색
+            boundary = true;
+            while (!deadEnd.empty() && next < 0)
+            {
+                unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0)
+                    next = (int)v;
+            }
+            while (next < 0 && cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                    next = (int)cursor;
+                cursor++;
+            }
+        }
+        fanning = next;
+    }
+    return result;
+}
+
+// cluster를 mesh 중심에서 바깥을 보는 정도로 정렬 (바깥쪽 면을 먼저 그려서 안쪽 면이 depth test에서 걸러지게)
+inline void SortClustersForOverdraw(const vector<Vertex> &vertices, vector<unsigned int> &indices, vector<unsigned int> clusterStarts)
+{
+    unsigned int triangleCount = (unsigned int)indices.size() / 3;
+    if (clusterStarts.size() < 2)
+        return;
+    clusterStarts.push_back(triangleCount);
+
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    struct Cluster
+    {
+        unsigned int begin, end;
+        glm::vec3 center;
+        glm::vec3 normal;
+        float area;
+        float sortKey;
+    };
+    vector<Cluster> clusters(clusterStarts.size() - 1);
+    for (unsigned int c = 0; c < clusters.size(); c++)
+    {
+        Cluster &cluster = clusters[c];
+        cluster.begin = clusterStarts[c];
+        cluster.end = clusterStarts[c + 1];
+        cluster.center = glm::vec3(0.0f);
+        cluster.normal = glm::vec3(0.0f);
+        cluster.area = 0.0f;
+        for (unsigned int t = cluster.begin; t < cluster.end; t++)
+        {
+            const glm::vec3 &p0 = vertices[indices[t * 3 + 0]].Position;
+            const glm::vec3 &p1 = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3 &p2 = vertices[indices[t * 3 + 2]].Position;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0); // 길이 = 넓이 * 2
+            float area = glm::length(n) * 0.5f;
+            cluster.normal += n;
+            cluster.center += (p0 + p1 + p2) / 3.0f * area;
+            cluster.area += area;
+        }
+        meshCenter += cluster.center;
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f)
+            cluster.center /= cluster.area;
+    }
+    if (meshArea > 0.0f)
+        meshCenter /= meshArea;
+    for (unsigned int c = 0; c < clusters.size(); c++)
+    {
+        float length = glm::length(clusters[c].normal);
+        clusters[c].sortKey = length > 0.0f ? glm::dot(clusters[c].center - meshCenter, clusters[c].normal / length) : 0.0f;
+    }
+    stable_sort(clusters.begin(), clusters.end(), [](const Cluster &a, const Cluster &b) { return a.sortKey > b.sortKey; });
+
+    vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (unsigned int c = 0; c < clusters.size(); c++)
+        sorted.insert(sorted.end(), indices.begin() + clusters[c].begin * 3, indices.begin() + clusters[c].end * 3);
+    indices.swap(sorted);
+}
+
+// index에서 처음 쓰이는 순서대로 vertex 재배치, 안 쓰이는 vertex는 제거
+inline void RemapVerticesForFetch(vector<Vertex> &vertices, vector<unsigned int> &indices)
+{
+    const unsigned int unused = ~0u;
+    vector<unsigned int> remap(vertices.size(), unused);
+    vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (unsigned int i = 0; i < indices.size(); i++)
+    {
+        unsigned int &slot = remap[indices[i]];
+        if (slot == unused)
+        {
+            slot = (unsigned int)ordered.size();
+            ordered.push_back(vertices[indices[i]]);
+        }
+        indices[i] = slot;
+    }
+    vertices.swap(ordered);
+}
+
+// 전체 최적화, 결과는 data에 그대로 덮어씀
+inline MeshOptimizeReport OptimizeMesh(MeshData &data)
+{
+    MeshOptimizeReport report;
+    report.verticesBefore = (unsigned int)data.vertices.size();
+    report.triangles = (unsigned int)data.indices.size() / 3;
+    if (data.indices.size() < 3 || data.indices.size() % 3 != 0)
+    {
+        report.verticesAfter = report.verticesBefore;
+        return report;
+    }
+    unsigned int missesBefore = SimulateVertexCache(data.indices, (unsigned int)data.vertices.size());
+    report.acmrBefore = (float)missesBefore / report.triangles;
+    report.atvrBefore = report.verticesBefore ? (float)missesBefore / report.verticesBefore : 0.0f;
+
+    WeldVertices(data.vertices, data.indices);
+    vector<unsigned int> clusterStarts;
+    data.indices = TipsifyIndices(data.indices, (unsigned int)data.vertices.size(), MESH_OPTIMIZER_CACHE_SIZE, clusterStarts);
+    SortClustersForOverdraw(data.vertices, data.indices, clusterStarts);
+    RemapVerticesForFetch(data.vertices, data.indices);
+
+    unsigned int missesAfter = SimulateVertexCache(data.indices, (unsigned int)data.vertices.size());
+    report.verticesAfter = (unsigned int)data.vertices.size();
+    report.clusters = (unsigned int)clusterStarts.size();
+    report.acmrAfter = (float)missesAfter / report.triangles;
+    report.atvrAfter = report.verticesAfter ? (float)missesAfter / report.verticesAfter : 0.0f;
+    return report;
+}
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef MESH_SIMPLIFY_H
+#define MESH_SIMPLIFY_H
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// quadric error 기반 mesh 단순화 (Garland-Heckbert edge collapse)
+// vertex는 기존 vertex 위치로만 합쳐지므로 LOD끼리 vertex buffer를 공유하고 index만 다름
+// UV/normal seam(같은 위치에 vertex가 여러 개)과 경계 vertex는 고정해서 텍스처가 찢어지지 않게 함
+
+// LOD 생성 설정
+struct LodSettings
+{
+    unsigned int levels = 4;  // LOD0 포함 최대 단계 수 (3~5 권장)
+    float ratio = 0.5f;       // 단계마다 목표 삼각형 비율
+    float maxError = 0.02f;   // 허용 오차, mesh bounding box 대각선 길이 대비
+};
+
+// 4x4 대칭 행렬 (plane 거리 제곱 합)
+struct Quadric
+{
+    double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+
+    Quadric() : a00(0), a01(0), a02(0), a03(0), a11(0), a12(0), a13(0), a22(0), a23(0), a33(0) { }
+    // 평면 n.x + d = 0
+    Quadric(const glm::dvec3 &n, double d)
+        : a00(n.x * n.x), a01(n.x * n.y), a02(n.x * n.z), a03(n.x * d),
+          a11(n.y * n.y), a12(n.y * n.z), a13(n.y * d),
+          a22(n.z * n.z), a23(n.z * d), a33(d * d) { }
+    Quadric &operator+=(const Quadric &q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+        a11 += q.a11; a12 += q.a12; a13 += q.a13;
+        a22 += q.a22; a23 += q.a23; a33 += q.a33;
+        return *this;
+    }
+    double Evaluate(const glm::vec3 &p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        return a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x
+             + a11 * y * y + 2 * a12 * y * z + 2 * a13 * y
+             + a22 * z * z + 2 * a23 * z + a33;
+    }
+};
+
+// indices를 targetIndexCount 이하로 줄임 (maxError는 절대 거리), 실제 최대 오차는 resultError로
+inline vector<unsigned int> SimplifyIndices(const vector<Vertex> &vertices, const vector<unsigned int> &source,
+                                            size_t targetIndexCount, float maxError, float &resultError)
+{
+    resultError = 0.0f;
+    unsigned int vertexCount = (unsigned int)vertices.size();
+    vector<unsigned int> indices = source;
+
+    // 1. 같은 위치 vertex 묶기 (canonical = 그 위치의 첫 vertex)
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3 &p) const
+        {
+            unsigned int h[3];
+            memcpy(h, &p, sizeof(h));
+            return (size_t)(h[0] * 73856093u ^ h[1] * 19349663u ^ h[2] * 83492791u);
+        }
+    };
+    unordered_map<glm::vec3, unsigned int, PositionHash> positions;
+    vector<unsigned int> canonical(vertexCount);
+    vector<bool> locked(vertexCount, false);
+    for (unsigned int v = 0; v < vertexCount; v++)
+    {
+        auto inserted = positions.insert(make_pair(vertices[v].Position, v));
+        canonical[v] = inserted.first->second;
+        if (!inserted.second)
+            locked[v] = locked[canonical[v]] = true; // seam
+    }
+    for (unsigned int v = 0; v < vertexCount; v++)
+        if (locked[canonical[v]])
+            locked[v] = true;
+
+    // 2. 경계/비다양체 edge의 vertex 고정 (위치 기준 edge를 삼각형 몇 개가 공유하는지)
+    {
+        unordered_map<unsigned long long, unsigned int> edgeUse;
+        edgeUse.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3)
+            for (unsigned int k = 0; k < 3; k++)
+            {
+                unsigned int a = canonical[indices[i + k]], b = canonical[indices[i + (k + 1) % 3]];
+                if (a > b)
+                    swap(a, b);
+                edgeUse[(unsigned long long)a << 32 | b]++;
+            }
+        for (size_t i = 0; i < indices.size(); i += 3)
+            for (unsigned int k = 0; k < 3; k++)
+            {
+                unsigned int a = indices[i + k], b = indices[i + (k + 1) % 3];
+                unsigned int ca = canonical[a], cb = canonical[b];
+                if (ca > cb)
+                    swap(ca, cb);
+                if (edgeUse[(unsigned long long)ca << 32 | cb] != 2)
+                    locked[a] = locked[b] = true;
+            }
+    }
+
+    // 3. vertex quadric (위치 기준)
+    vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        glm::dvec3 p0 = glm::dvec3(vertices[indices[i]].Position);
+        glm::dvec3 n = glm::cross(glm::dvec3(vertices[indices[i + 1]].Position) - p0, glm::dvec3(vertices[indices[i + 2]].Position) - p0);
+        double length = glm::length(n);
+        if (length <= 0.0)
+            continue;
+        n /= length;
+        Quadric q(n, -glm::dot(n, p0));
+        for (unsigned int k = 0; k < 3; k++)
+            quadrics[canonical[indices[i + k]]] += q;
+    }
+
+    // 4. edge collapse를 비용 순으로, 한 pass에서는 서로 겹치지 않는 것만
+    double errorLimit = (double)maxError * maxError;
+    struct Collapse
+    {
+        unsigned int from, to;
+        double cost;
+    };
+    vector<Collapse> collapses;
+    vector<unsigned int> remap(vertexCount);
+    vector<bool> touched(vertexCount);
+    vector<unsigned int> offsets(vertexCount + 1), adjacency, fill;
+    while (indices.size() > targetIndexCount)
+    {
+        // vertex -> 삼각형
+        fill.assign(vertexCount, 0);
+        for (size_t i = 0; i < indices.size(); i++)
+            fill[indices[i]]++;
+        offsets[0] = 0;
+        for (unsigned int v = 0; v < vertexCount; v++)
+            offsets[v + 1] = offsets[v] + fill[v];
+        adjacency.resize(indices.size());
+        copy(offsets.begin(), offsets.end() - 1, fill.begin());
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+
+        collapses.clear();
+        for (size_t i = 0; i < indices.size(); i += 3)
+            for (unsigned int k = 0; k < 3; k++)
+            {
+                unsigned int from = indices[i + k], to = indices[i + (k + 1) % 3];
+                for (unsigned int dir = 0; dir < 2; dir++, swap(from, to))
+                {
+                    if (locked[from])
+                        continue;
+                    Quadric q = quadrics[canonical[from]];
+                    q += quadrics[canonical[to]];
+                    Collapse c = { from, to, max(q.Evaluate(vertices[to].Position), 0.0) };
+                    collapses.push_back(c);
+                }
+            }
+        sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b) { return a.cost < b.cost; });
+
+        for (unsigned int v = 0; v < vertexCount; v++)
+            remap[v] = v;
+        touched.assign(vertexCount, false);
+        size_t remaining = indices.size();
+        unsigned int applied = 0;
+        for (size_t c = 0; c < collapses.size() && remaining > targetIndexCount; c++)
+        {
+            const Collapse &collapse = collapses[c];
+            if (collapse.cost > errorLimit)
+                break;
+            if (touched[collapse.from] || touched[collapse.to])
+                continue;
+            // 뒤집히는 삼각형이 생기면 거부
+            const glm::vec3 &target = vertices[collapse.to].Position;
+            bool flips = false;
+            unsigned int removed = 0;
+            for (unsigned int a = offsets[collapse.from]; a < offsets[collapse.from + 1] && !flips; a++)
+            {
+                const unsigned int *t = &indices[adjacency[a] * 3];
+                if (t[0] == collapse.to || t[1] == collapse.to || t[2] == collapse.to)
+                {
+                    removed++;
+                    continue;
+                }
+                glm::vec3 p[3], q[3];
+                for (unsigned int k = 0; k < 3; k++)
+                {
+                    p[k] = vertices[t[k]].Position;
+                    q[k] = t[k] == collapse.from ? target : p[k];
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                if (glm::dot(before, after) <= 0.0f)
+                    flips = true;
+            }
+            if (flips)
+                continue;
+            remap[collapse.from] = collapse.to;
+            quadrics[canonical[collapse.to]] += quadrics[canonical[collapse.from]];
+            for (unsigned int a = offsets[collapse.from]; a < offsets[collapse.from + 1]; a++)
+                for (unsigned int k = 0; k < 3; k++)
+                    touched[indices[adjacency[a] * 3 + k]] = true;
+            remaining -= removed * 3;
+            resultError = max(resultError, (float)sqrt(collapse.cost));
+            applied++;
+        }
+        if (applied == 0)
+            break;
+
+        // remap 적용, 면적이 0이 된 삼각형 제거
+        size_t write = 0;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            unsigned int a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+            if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c])
+                continue;
+            indices[write++] = a;
+            indices[write++] = b;
+            indices[write++] = c;
+        }
+        indices.resize(write);
+    }
+    return indices;
+}
+
+// data.lods에 LOD1부터 채움, 더 줄일 수 없으면 일찍 멈춤
+inline void GenerateLods(MeshData &data, const LodSettings &settings)
+{
+    data.lods.clear();
+    if (data.vertices.empty())
+        return;
+    glm::vec3 minPos = data.vertices[0].Position, maxPos = minPos;
+    for (unsigned int i = 1; i < data.vertices.size(); i++)
+    {
+        minPos = glm::min(minPos, data.vertices[i].Position);
+        maxPos = glm::max(maxPos, data.vertices[i].Position);
+    }
+    float maxError = settings.maxError * glm::length(maxPos - minPos);
+
+    data.lods.reserve(settings.levels);
+    const vector<unsigned int> *previous = &data.indices;
+    float previousError = 0.0f;
+    for (unsigned int level = 1; level < settings.levels; level++)
+    {
+        size_t target = (size_t)(previous->size() / 3 * settings.ratio) * 3;
+        float error;
+        vector<unsigned int> simplified = SimplifyIndices(data.vertices, *previous, target, maxError, error);
+        if (simplified.empty() || simplified.size() > previous->size() * 9 / 10)
+            break;
+        vector<unsigned int> clusters;
+        MeshLodData lod;
+        lod.indices = TipsifyIndices(simplified, (unsigned int)data.vertices.size(), MESH_OPTIMIZER_CACHE_SIZE, clusters);
+        lod.error = max(error, previousError);
+        previousError = lod.error;
+        data.lods.push_back(lod);
+        previous = &data.lods.back().indices;
+    }
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef MESHLET_H
+#define MESHLET_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "frustum.h"
+#include "vertex_layout.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// mesh의 index buffer를 작은 삼각형 묶음(meshlet)으로 나누고 CPU에서 묶음 단위로 culling
+// index는 재배치하지 않고 연속 구간으로만 자름 (mesh_optimizer.h의 Tipsify 순서가 이미 공간적으로 모여 있음)
+// 그래서 EBO는 그대로이고, 보이는 구간만 glMultiDrawElements로 그림
+const unsigned int MESHLET_MAX_TRIANGLES = 124;
+const unsigned int MESHLET_MAX_VERTICES = 64;
+
+struct Meshlet
+{
+    unsigned int firstIndex;  // LOD0 index buffer 안의 위치
+    unsigned int indexCount;
+    glm::vec3 center;         // bounding sphere (model space)
+    float radius;
+    glm::vec3 coneAxis;       // 삼각형 normal들을 감싸는 cone
+    float coneCutoff;         // sin(cone 반각), 1이면 backface culling 불가
+};
+
+// culling 통계 (여러 mesh/프레임 누적)
+struct MeshletCullStats
+{
+    unsigned int meshlets = 0;
+    unsigned int frustumCulled = 0;
+    unsigned int backfaceCulled = 0;
+    unsigned int ranges = 0;            // 합쳐진 draw 구간 수
+    unsigned long long trianglesTotal = 0;
+    unsigned long long trianglesDrawn = 0;
+    double cullMs = 0.0;
+
+    void Reset() { *this = MeshletCullStats(); }
+    void Print(const string &name, unsigned int frames = 1) const
+    {
+        frames = max(frames, 1u);
+        cout << "MESHLET::CULL:: " << name << " " << meshlets / frames << " meshlets/frame, culled frustum " << frustumCulled / frames
+             << " backface " << backfaceCulled / frames << " | triangles " << trianglesDrawn / frames << " / " << trianglesTotal / frames
+             << " (" << (trianglesTotal ? 100.0 * (double)(trianglesTotal - trianglesDrawn) / trianglesTotal : 0.0) << "% saved) | "
+             << ranges / frames << " ranges | cull " << cullMs / frames << " ms/frame" << endl;
+    }
+};
+
+// 연속된 삼각형을 MESHLET_MAX_TRIANGLES/VERTICES 한도까지 묶음
+inline vector<Meshlet> BuildMeshlets(const vector<Vertex> &vertices, const vector<unsigned int> &indices,
+                                     unsigned int maxTriangles = MESHLET_MAX_TRIANGLES, unsigned int maxVertices = MESHLET_MAX_VERTICES)
+{
+    vector<Meshlet> meshlets;
+    vector<unsigned int> stamp(vertices.size(), ~0u); // vertex가 마지막으로 들어간 meshlet 번호
+    vector<unsigned int> unique;
+    unique.reserve(maxVertices);
+
+    size_t begin = 0;
+    for (size_t i = 0; i <= indices.size(); i += 3)
+    {
+        // 현재 삼각형이 들어갈 자리가 있는지
+        bool flush = i == indices.size();
+        unsigned int meshletId = (unsigned int)meshlets.size();
+        if (!flush)
+        {
+            unsigned int added = 0;
+            for (unsigned int k = 0; k < 3; k++)
+                if (stamp[indices[i + k]] != meshletId)
+                    added++;
+            flush = (i - begin) / 3 >= maxTriangles || unique.size() + added > maxVertices;
+        }
+        if (flush && i > begin)
+        {
+            Meshlet meshlet;
+            meshlet.firstIndex = (unsigned int)begin;
+            meshlet.indexCount = (unsigned int)(i - begin);
+
+            // bounding sphere: AABB 중심 + 최대 거리
+            glm::vec3 minPos = vertices[unique[0]].Position, maxPos = minPos;
+            for (unsigned int u = 1; u < unique.size(); u++)
+            {
+                minPos = glm::min(minPos, vertices[unique[u]].Position);
+                maxPos = glm::max(maxPos, vertices[unique[u]].Position);
+            }
+            meshlet.center = (minPos + maxPos) * 0.5f;
+            meshlet.radius = 0.0f;
+            for (unsigned int u = 0; u < unique.size(); u++)
+                meshlet.radius = max(meshlet.radius, glm::length(vertices[unique[u]].Position - meshlet.center));
+
+            // normal cone: 평균 방향과 가장 벌어진 normal 사이 각도
+            vector<glm::vec3> normals;
+            normals.reserve(meshlet.indexCount / 3);
+            glm::vec3 axis(0.0f);
+            for (size_t t = begin; t < i; t += 3)
+            {
+                const glm::vec3 &p0 = vertices[indices[t]].Position;
+                glm::vec3 n = glm::cross(vertices[indices[t + 1]].Position - p0, vertices[indices[t + 2]].Position - p0);
+                float length = glm::length(n);
+                if (length <= 0.0f)
+                    continue;
+                normals.push_back(n / length);
+                axis += normals.back();
+            }
+            float axisLength = glm::length(axis);
+            meshlet.coneAxis = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+            float minDot = axisLength > 0.0f ? 1.0f : -1.0f;
+            for (unsigned int n = 0; n < normals.size(); n++)
+                minDot = min(minDot, glm::dot(normals[n], meshlet.coneAxis));
+            // 반각이 거의 90도 이상이면 cone으로 거를 수 없음
+            meshlet.coneCutoff = minDot <= 0.1f ? 1.0f : sqrt(1.0f - minDot * minDot);
+            meshlets.push_back(meshlet);
+
+            begin = i;
+            unique.clear();
+            meshletId++;
+        }
+        if (i == indices.size())
+            break;
+        for (unsigned int k = 0; k < 3; k++)
+        {
+            unsigned int v = indices[i + k];
+            if (stamp[v] != meshletId)
+            {
+                stamp[v] = meshletId;
+                unique.push_back(v);
+            }
+        }
+    }
+    return meshlets;
+}
+
+// frustum/eye는 mesh의 model space 기준
+// 보이는 meshlet의 index 구간을 이어붙여서 counts/offsets(glMultiDrawElements 인자)로 출력
+inline void CullMeshlets(const vector<Meshlet> &meshlets, const Frustum &frustum, const glm::vec3 &eye, size_t indexSize,
+                         vector<GLsizei> &counts, vector<const void*> &offsets, MeshletCullStats &stats)
+{
+    auto start = chrono::steady_clock::now();
+    counts.clear();
+    offsets.clear();
+    unsigned int rangeBegin = 0, rangeEnd = 0;
+    bool open = false;
+    for (unsigned int i = 0; i < meshlets.size(); i++)
+    {
+        const Meshlet &m = meshlets[i];
+        stats.trianglesTotal += m.indexCount / 3;
+        if (!frustum.IntersectsSphere(m.center, m.radius))
+        {
+            stats.frustumCulled++;
+            continue;
+        }
+        // 구 안의 모든 점에서 cone 안의 모든 normal이 카메라 반대쪽을 보면 제외
+        glm::vec3 view = m.center - eye;
+        if (glm::dot(view, m.coneAxis) >= m.coneCutoff * glm::length(view) + m.radius)
+        {
+            stats.backfaceCulled++;
+            continue;
+        }
+        stats.trianglesDrawn += m.indexCount / 3;
+        // 바로 앞 구간에 이어지면 합침
+        if (open && rangeEnd == m.firstIndex)
+        {
+            rangeEnd += m.indexCount;
+            continue;
+        }
+        if (open)
+        {
+            counts.push_back((GLsizei)(rangeEnd - rangeBegin));
+            offsets.push_back((const void*)((size_t)rangeBegin * indexSize));
+        }
+        rangeBegin = m.firstIndex;
+        rangeEnd = m.firstIndex + m.indexCount;
+        open = true;
+    }
+    if (open)
+    {
+        counts.push_back((GLsizei)(rangeEnd - rangeBegin));
+        offsets.push_back((const void*)((size_t)rangeBegin * indexSize));
+    }
+    stats.meshlets += (unsigned int)meshlets.size();
+    stats.ranges += (unsigned int)counts.size();
+    stats.cullMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+#endif
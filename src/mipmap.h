@@ -0,0 +1,501 @@
+#ifndef MIPMAP_H
+#define MIPMAP_H
+
+#include <glad/glad.h>
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+// filter SIMD 폭 (SSE는 픽셀 하나(RGBA)씩)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPMAP_SIMD_WIDTH 4
+#else
+#define MIPMAP_SIMD_WIDTH 1
+#endif
+// GCC/Clang x86이면 AVX2 kernel(세로 pass 8 float씩, sRGB 변환표 gather)을 target attribute로 따로 컴파일해 두고
+// 실행 중에 CPU가 지원할 때만 씀 (-mavx2 없이 빌드해도 됨), MSVC는 SSE만
+#if MIPMAP_SIMD_WIDTH > 1 && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MIPMAP_AVX2 1
+#define MIPMAP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MIPMAP_AVX2 0
+#endif
+
+// MipmapBuilder::Build 옵션
+enum MipmapFlags
+{
+    MIPMAP_SRGB       = 1 << 0, // RGB를 linear로 바꿔서 filter하고 다시 sRGB로 저장 (alpha는 그대로)
+    MIPMAP_NORMAL_MAP = 1 << 1, // xyz를 [-1, 1]로 filter한 뒤 길이 1로 재정규화
+    MIPMAP_KAISER     = 1 << 2  // box 대신 Kaiser window sinc (반경 2 texel, 선명하지만 느림)
+};
+
+// RGBA8 mip 하나
+struct MipLevel
+{
+    int width, height;
+    vector<unsigned char> pixels;
+};
+
+// level 0(원본)부터 1x1까지
+struct MipChain
+{
+    vector<MipLevel> levels;
+
+    size_t Bytes() const
+    {
+        size_t bytes = 0;
+        for (unsigned int i = 0; i < levels.size(); i++)
+            bytes += levels[i].pixels.size();
+        return bytes;
+    }
+};
+
+// Build 누적 통계, 처리량은 원본 픽셀 기준
+struct MipmapStats
+{
+    unsigned int chains = 0;
+    size_t sourcePixels = 0;
+    size_t outputPixels = 0; // level 1 이상
+    double ms = 0.0;
+
+    void Print() const
+    {
+        cout << "TEXTURE::MIPMAP:: " << chains << " chains, " << sourcePixels / 1e6 << " MPixels -> " << outputPixels / 1e6 << " MPixels in "
+             << ms << " ms (" << (ms > 0.0 ? sourcePixels / (ms * 1000.0) : 0.0) << " MPixels/s)" << endl;
+    }
+};
+
+// CPU mip chain 생성
+// 각 level은 float로 이전 level에서 만들고(가로 pass -> 세로 pass), 16줄 단위로 worker thread에 나눔
+// glGenerateMipmap과 달리 sRGB는 linear 공간에서, normal map은 재정규화해서 줄임
+class MipmapBuilder
+{
+public:
+    // pool이 nullptr이면 호출한 thread에서만 실행 (pool의 worker 안에서 부를 때)
+    static void Build(const unsigned char *rgba, int width, int height, unsigned int flags, MipChain &out, ThreadPool *pool = &SharedThreadPool())
+    {
+        auto start = chrono::steady_clock::now();
+        const Tables &tables = Tables::Get();
+        Codec codec(tables, flags);
+
+        out.levels.assign(1, MipLevel());
+        out.levels[0].width = width;
+        out.levels[0].height = height;
+        out.levels[0].pixels.assign(rgba, rgba + (size_t)width * height * 4);
+
+        vector<float> source, target; // level 1 이상은 float로 유지 (level 0은 8bit에서 바로 읽음)
+        size_t outputPixels = 0;
+        int sw = width, sh = height;
+        while (sw > 1 || sh > 1)
+        {
+            int dw = max(sw / 2, 1), dh = max(sh / 2, 1);
+            Taps tapsX(sw, dw, flags), tapsY(sh, dh, flags);
+            target.resize((size_t)dw * dh * 4);
+            out.levels.push_back(MipLevel());
+            MipLevel &level = out.levels.back();
+            level.width = dw;
+            level.height = dh;
+            level.pixels.resize((size_t)dw * dh * 4);
+
+            const float *sourceFloat = out.levels.size() == 2 ? nullptr : source.data();
+            unsigned int jobs = (unsigned int)((dh + ROWS_PER_JOB - 1) / ROWS_PER_JOB);
+            auto job = [&](unsigned int index) {
+                filterRows(rgba, sourceFloat, sw, codec, tapsX, tapsY, dw, (int)index * ROWS_PER_JOB, min((int)(index + 1) * ROWS_PER_JOB, dh),
+                           target.data(), level.pixels.data());
+            };
+            if (pool && jobs > 1)
+                pool->ParallelFor(jobs, job);
+            else
+                for (unsigned int i = 0; i < jobs; i++)
+                    job(i);
+
+            outputPixels += (size_t)dw * dh;
+            source.swap(target);
+            sw = dw;
+            sh = dh;
+        }
+
+        lock_guard<mutex> lock(statsMutex());
+        MipmapStats &stats = statsStorage();
+        stats.chains++;
+        stats.sourcePixels += (size_t)width * height;
+        stats.outputPixels += outputPixels;
+        stats.ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    // 바인딩된 GL_TEXTURE_2D에 모든 level 업로드 (데이터는 RGBA8, internalFormat은 원본 채널 수에 맞게)
+    static void Upload(const MipChain &chain, GLenum internalFormat)
+    {
+        for (unsigned int i = 0; i < chain.levels.size(); i++)
+        {
+            const MipLevel &level = chain.levels[i];
+            glTexImage2D(GL_TEXTURE_2D, (GLint)i, internalFormat, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.pixels.data());
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)chain.levels.size() - 1);
+    }
+
+    static MipmapStats Stats()
+    {
+        lock_guard<mutex> lock(statsMutex());
+        return statsStorage();
+    }
+
+    // AVX2 kernel 사용 여부 (처음 한 번 CPU 확인)
+    static bool HasAvx2()
+    {
+#if MIPMAP_AVX2
+        static const bool supported = __builtin_cpu_supports("avx2") != 0;
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+private:
+    static const int ROWS_PER_JOB = 16;
+    static const int KAISER_RADIUS = 2; // 줄어든 level의 texel 단위
+
+    // 8bit <-> float 변환표
+    struct Tables
+    {
+        float srgbToLinear[256];
+        unsigned char linearToSrgb[4096];
+
+        static const Tables &Get()
+        {
+            static Tables tables;
+            return tables;
+        }
+    private:
+        Tables()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                float c = i / 255.0f;
+                srgbToLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+            }
+            for (int i = 0; i < 4096; i++)
+            {
+                float c = i / 4095.0f;
+                c = c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+                linearToSrgb[i] = (unsigned char)(c * 255.0f + 0.5f);
+            }
+        }
+    };
+    // flag에 따른 채널별 읽기/쓰기
+    struct Codec
+    {
+        alignas(16) float decode[256][4];
+        alignas(16) float scale[4], bias[4]; // sRGB가 아니면 decode = byte * scale + bias
+        const Tables &tables;
+        unsigned int flags;
+        bool linear;
+
+        Codec(const Tables &tables, unsigned int flags) : tables(tables), flags(flags), linear(!(flags & MIPMAP_SRGB) || (flags & MIPMAP_NORMAL_MAP))
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                bool normal = c < 3 && (flags & MIPMAP_NORMAL_MAP);
+                scale[c] = normal ? 2.0f / 255.0f : 1.0f / 255.0f;
+                bias[c] = normal ? -1.0f : 0.0f;
+            }
+            for (int i = 0; i < 256; i++)
+                for (int c = 0; c < 4; c++)
+                {
+                    if (c < 3 && (flags & MIPMAP_NORMAL_MAP))
+                        decode[i][c] = i / 255.0f * 2.0f - 1.0f;
+                    else if (c < 3 && (flags & MIPMAP_SRGB))
+                        decode[i][c] = tables.srgbToLinear[i];
+                    else
+                        decode[i][c] = i / 255.0f;
+                }
+        }
+        void DecodeRow(const unsigned char *src, int width, float *dst) const
+        {
+            int x = 0;
+#if MIPMAP_SIMD_WIDTH > 1
+            // 4픽셀(16byte)씩 정수 -> float 변환
+            if (linear)
+            {
+                __m128i zero = _mm_setzero_si128();
+                __m128 scale4 = _mm_load_ps(scale), bias4 = _mm_load_ps(bias);
+                for (; x + 16 <= width * 4; x += 16)
+                {
+                    __m128i bytes = _mm_loadu_si128((const __m128i*)(src + x));
+                    __m128i low = _mm_unpacklo_epi8(bytes, zero), high = _mm_unpackhi_epi8(bytes, zero);
+                    __m128i words[4] = { _mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+                    for (int i = 0; i < 4; i++)
+                        _mm_storeu_ps(dst + x + i * 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(words[i]), scale4), bias4));
+                }
+            }
+#endif
+#if MIPMAP_AVX2
+            if (!linear && HasAvx2())
+                x = decodeGatherAvx2(&decode[0][0], src, width * 4, dst);
+#endif
+            for (; x < width * 4; x += 4)
+                for (int c = 0; c < 4; c++)
+                    dst[x + c] = decode[src[x + c]][c];
+        }
+        // filter 결과 정리 (float는 다음 level의 입력) 후 8bit로
+        void EncodeRow(float *values, int width, unsigned char *dst) const
+        {
+            for (int x = 0; x < width * 4; x += 4)
+            {
+                float *p = values + x;
+                if (flags & MIPMAP_NORMAL_MAP)
+                {
+                    float length = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+                    if (length > 1e-6f)
+                        for (int c = 0; c < 3; c++)
+                            p[c] /= length;
+                    else
+                    {
+                        p[0] = p[1] = 0.0f;
+                        p[2] = 1.0f;
+                    }
+                    for (int c = 0; c < 3; c++)
+                        dst[x + c] = (unsigned char)(p[c] * 127.5f + 128.0f);
+                }
+                else
+                    for (int c = 0; c < 3; c++)
+                    {
+                        p[c] = min(max(p[c], 0.0f), 1.0f);
+                        dst[x + c] = (flags & MIPMAP_SRGB) ? tables.linearToSrgb[(int)(p[c] * 4095.0f + 0.5f)] : (unsigned char)(p[c] * 255.0f + 0.5f);
+                    }
+                p[3] = min(max(p[3], 0.0f), 1.0f);
+                dst[x + 3] = (unsigned char)(p[3] * 255.0f + 0.5f);
+            }
+        }
+    };
+
+    // 한 축의 filter 표, 출력 i는 source[index[i * count + k]] * weight[i * count + k]의 합
+    struct Taps
+    {
+        int count;
+        bool half; // box로 정확히 절반 (i -> 2i, 2i + 1), filterHalf 사용
+        vector<int> index;
+        vector<float> weight;
+
+        Taps(int sourceSize, int targetSize, unsigned int flags) : half(!(flags & MIPMAP_KAISER) && sourceSize == targetSize * 2)
+        {
+            if (sourceSize == targetSize)
+            {
+                count = 1;
+                for (int i = 0; i < targetSize; i++)
+                {
+                    index.push_back(i);
+                    weight.push_back(1.0f);
+                }
+                return;
+            }
+            float scale = (float)sourceSize / targetSize;
+            float radius = (flags & MIPMAP_KAISER) ? KAISER_RADIUS * scale : scale * 0.5f;
+            count = 0;
+            for (int i = 0; i < targetSize; i++)
+            {
+                float center = (i + 0.5f) * scale;
+                count = max(count, (int)ceilf(center + radius) - (int)floorf(center - radius));
+            }
+            index.resize((size_t)targetSize * count);
+            weight.resize((size_t)targetSize * count);
+            for (int i = 0; i < targetSize; i++)
+            {
+                float center = (i + 0.5f) * scale;
+                int first = (int)floorf(center - radius);
+                float sum = 0.0f;
+                for (int k = 0; k < count; k++)
+                {
+                    int j = first + k;
+                    float w;
+                    if (flags & MIPMAP_KAISER)
+                        w = kaiser((j + 0.5f - center) / scale);
+                    else // box: [j, j + 1)과 [center - radius, center + radius)이 겹치는 길이
+                        w = max(0.0f, min((float)j + 1.0f, center + radius) - max((float)j, center - radius));
+                    index[(size_t)i * count + k] = min(max(j, 0), sourceSize - 1);
+                    weight[(size_t)i * count + k] = w;
+                    sum += w;
+                }
+                for (int k = 0; k < count; k++)
+                    weight[(size_t)i * count + k] /= sum;
+            }
+        }
+        // sinc * Kaiser window (beta 4), t는 줄어든 level의 texel 단위
+        static float kaiser(float t)
+        {
+            const float beta = 4.0f, pi = 3.14159265f;
+            float r = t / KAISER_RADIUS;
+            if (fabsf(r) >= 1.0f)
+                return 0.0f;
+            float sinc = fabsf(t) < 1e-5f ? 1.0f : sinf(pi * t) / (pi * t);
+            return sinc * bessel0(beta * sqrtf(1.0f - r * r)) / bessel0(beta);
+        }
+        static float bessel0(float x)
+        {
+            float sum = 1.0f, term = 1.0f;
+            for (int k = 1; k < 16; k++)
+            {
+                term *= (x / (2.0f * k)) * (x / (2.0f * k));
+                sum += term;
+            }
+            return sum;
+        }
+    };
+
+    // 출력 줄 [y0, y1): 필요한 source 줄을 가로로 먼저 줄여두고 세로로 합침
+    static void filterRows(const unsigned char *level0, const float *source, int sourceWidth, const Codec &codec, const Taps &tapsX, const Taps &tapsY,
+                           int width, int y0, int y1, float *target, unsigned char *pixels)
+    {
+        if (tapsX.half && tapsY.half)
+        {
+            filterHalf(level0, source, sourceWidth, codec, width, y0, y1, target, pixels);
+            return;
+        }
+        int first = tapsY.index[(size_t)y0 * tapsY.count], last = first;
+        for (size_t i = (size_t)y0 * tapsY.count; i < (size_t)y1 * tapsY.count; i++)
+        {
+            first = min(first, tapsY.index[i]);
+            last = max(last, tapsY.index[i]);
+        }
+        size_t stride = (size_t)width * 4;
+        float *horizontal = scratch(0, (size_t)(last - first + 1) * stride);
+        for (int row = first; row <= last; row++)
+            filterHorizontal(sourceRow(level0, source, sourceWidth, codec, row, 1), tapsX, width, horizontal + (size_t)(row - first) * stride);
+        for (int y = y0; y < y1; y++)
+        {
+            float *dst = target + (size_t)y * stride;
+            memset(dst, 0, stride * sizeof(float));
+            for (int k = 0; k < tapsY.count; k++)
+            {
+                size_t tap = (size_t)y * tapsY.count + k;
+                if (tapsY.weight[tap] != 0.0f)
+                    accumulate(horizontal + (size_t)(tapsY.index[tap] - first) * stride, tapsY.weight[tap], stride, dst);
+            }
+            codec.EncodeRow(dst, width, pixels + (size_t)y * stride);
+        }
+    }
+    // 2x2 box 전용 (짝수 크기), 가로/세로 pass 없이 네 픽셀 평균
+    static void filterHalf(const unsigned char *level0, const float *source, int sourceWidth, const Codec &codec, int width, int y0, int y1,
+                           float *target, unsigned char *pixels)
+    {
+        size_t stride = (size_t)width * 4;
+        for (int y = y0; y < y1; y++)
+        {
+            const float *row0 = sourceRow(level0, source, sourceWidth, codec, y * 2, 1);
+            const float *row1 = sourceRow(level0, source, sourceWidth, codec, y * 2 + 1, 2);
+            float *dst = target + (size_t)y * stride;
+            for (int x = 0; x < width; x++)
+            {
+                const float *a = row0 + x * 8, *b = row1 + x * 8;
+#if MIPMAP_SIMD_WIDTH > 1
+                __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(a + 4)), _mm_add_ps(_mm_loadu_ps(b), _mm_loadu_ps(b + 4)));
+                _mm_storeu_ps(dst + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                for (int c = 0; c < 4; c++)
+                    dst[x * 4 + c] = (a[c] + a[c + 4] + b[c] + b[c + 4]) * 0.25f;
+#endif
+            }
+            codec.EncodeRow(dst, width, pixels + (size_t)y * stride);
+        }
+    }
+    // source level의 한 줄 (level 0이면 thread별 scratch slot에 float로 변환)
+    static const float *sourceRow(const unsigned char *level0, const float *source, int sourceWidth, const Codec &codec, int row, int slot)
+    {
+        if (source)
+            return source + (size_t)row * sourceWidth * 4;
+        float *decoded = scratch(slot, (size_t)sourceWidth * 4);
+        codec.DecodeRow(level0 + (size_t)row * sourceWidth * 4, sourceWidth, decoded);
+        return decoded;
+    }
+    // worker마다 재사용하는 임시 버퍼 (job마다 할당하지 않도록)
+    static float *scratch(int slot, size_t size)
+    {
+        static thread_local vector<float> buffers[3];
+        if (buffers[slot].size() < size)
+            buffers[slot].resize(size);
+        return buffers[slot].data();
+    }
+    static void filterHorizontal(const float *src, const Taps &taps, int width, float *dst)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const int *index = &taps.index[(size_t)x * taps.count];
+            const float *weight = &taps.weight[(size_t)x * taps.count];
+#if MIPMAP_SIMD_WIDTH > 1
+            __m128 sum = _mm_setzero_ps();
+            for (int k = 0; k < taps.count; k++)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + index[k] * 4), _mm_set1_ps(weight[k])));
+            _mm_storeu_ps(dst + x * 4, sum);
+#else
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (int k = 0; k < taps.count; k++)
+                for (int c = 0; c < 4; c++)
+                    sum[c] += src[index[k] * 4 + c] * weight[k];
+            memcpy(dst + x * 4, sum, sizeof(sum));
+#endif
+        }
+    }
+    // dst += src * weight
+    static void accumulate(const float *src, float weight, size_t count, float *dst)
+    {
+        size_t i = 0;
+#if MIPMAP_AVX2
+        if (HasAvx2())
+            i = accumulateAvx2(src, weight, count, dst);
+#endif
+#if MIPMAP_SIMD_WIDTH > 1
+        __m128 w4 = _mm_set1_ps(weight);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), w4)));
+#endif
+        for (; i < count; i++)
+            dst[i] += src[i] * weight;
+    }
+
+#if MIPMAP_AVX2
+    // 2픽셀(8byte)씩 decode[byte][channel] gather, 처리한 개수를 돌려줌
+    MIPMAP_TARGET_AVX2 static int decodeGatherAvx2(const float *decode, const unsigned char *src, int count, float *dst)
+    {
+        __m256i channel = _mm256_setr_epi32(0, 1, 2, 3, 0, 1, 2, 3);
+        int x = 0;
+        for (; x + 8 <= count; x += 8)
+        {
+            __m256i bytes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + x)));
+            __m256i index = _mm256_add_epi32(_mm256_slli_epi32(bytes, 2), channel);
+            _mm256_storeu_ps(dst + x, _mm256_i32gather_ps(decode, index, 4));
+        }
+        return x;
+    }
+    MIPMAP_TARGET_AVX2 static size_t accumulateAvx2(const float *src, float weight, size_t count, float *dst)
+    {
+        __m256 w8 = _mm256_set1_ps(weight);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), w8)));
+        return i;
+    }
+#endif
+
+    static mutex &statsMutex()
+    {
+        static mutex m;
+        return m;
+    }
+    static MipmapStats &statsStorage()
+    {
+        static MipmapStats stats;
+        return stats;
+    }
+};
+
+#endif
@@ -13,17 +13,50 @@
 #include "stb_image.h"
 #include "mesh.h"
 #include "shader.h"
+#include "model_cache.h"
+#include "thread_pool.h"
+#include "texture_loader.h"
+#include "texture_cache.h"
+#include "vertex_compress.h"
+#include "mesh_arena.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplify.h"
+#include "camera.h"
+#include "process_memory.h"
+#include "obj_loader.h"
+#include "animation.h"
 
+#include <chrono>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
+// TextureCache에서 참조를 하나 가져옴, 다 쓰면 TextureCache::Release(id)
 unsigned int TextureFromFile(const char *path, const string &directory, bool gamma = false);
 
+// Model 캐시 키에 들어가는 assimp import flag
+const unsigned int MODEL_IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
+
+// Model 생성 옵션
+enum ModelFlags {
+    MODEL_ASYNC_TEXTURES    = 1 << 0, // SharedTextureLoader()로 텍스처를 비동기 로드, 매 프레임 Update() 필요
+    MODEL_COMPRESS_VERTICES = 1 << 1, // GPU에는 CompressedVertex로 올림, *_compact.vs shader 필요
+    MODEL_MULTI_DRAW        = 1 << 2, // 모든 mesh를 MeshArena 하나에 넣고 material별 multi draw 한 번으로 그림
+    MODEL_SKIP_OPTIMIZE     = 1 << 3, // import시 mesh 최적화(mesh_optimizer.h) 생략 (비교용)
+    MODEL_GENERATE_LODS     = 1 << 4, // quadric 단순화로 LOD 생성 (mesh_simplify.h), Draw(shader, lod)로 선택
+    MODEL_BUILD_MESHLETS    = 1 << 5, // LOD0을 meshlet으로 나눔 (meshlet.h), DrawCulled로 CPU culling
+    MODEL_KEEP_CPU_DATA     = 1 << 6, // 업로드 후에도 mesh의 vertices/indices 유지 (picking 등), 기본은 해제
+    MODEL_USE_ASSIMP        = 1 << 7, // .obj도 obj_loader.h 대신 assimp로 읽음 (비교용)
+    MODEL_COMPRESS_TEXTURES = 1 << 8, // 텍스처를 BCn으로 압축해서 올림 (texture_compress.h, .dds 캐시), ASYNC보다 우선
+    MODEL_ANIMATED          = 1 << 9, // bone weight, skeleton, animation clip을 읽음 (animation.h), 모델 캐시와 COMPRESS_VERTICES는 쓰지 않음
+    MODEL_KEEP_MESH_BUFFERS = 1 << 10 // MULTI_DRAW여도 mesh별 VAO/VBO/EBO 유지 (multiDraw = false, Submit 비교용), 기본은 arena를 만든 뒤 삭제
+};
+
 class Model 
 {
 public:
@@ -32,106 +65,324 @@ public:
     vector<Mesh>    meshes;
     string directory;
     bool gammaCorrection;
+    unsigned int flags;
+    VertexCompressionReport compression; // MODEL_COMPRESS_VERTICES일 때 메모리/오차 합계
+    MeshArena arena;                     // MODEL_MULTI_DRAW일 때 모든 mesh를 담은 buffer
+    bool multiDraw;                      // false면 기존처럼 mesh마다 그림 (비교용, MODEL_KEEP_MESH_BUFFERS 필요)
+    LodSettings lodSettings;             // MODEL_GENERATE_LODS 설정
+    vector<float> lodErrors;             // LOD별 최대 오차 (모든 mesh 중 최대, model space)
+    glm::vec3 boundsCenter;              // model space bounding sphere
+    float boundsRadius;
+    glm::vec3 boundsMin, boundsMax;      // model space AABB
+    BoundingSphereBatch meshBounds;      // mesh별 bounding sphere (model space), Draw(shader, model, frustum, ...)에서 사용
+    Skeleton skeleton;                   // MODEL_ANIMATED일 때 node tree와 bone
+    vector<AnimationClip> animations;    // MODEL_ANIMATED일 때 scene의 모든 animation
 
     // 생성자
-    Model(string const &path, bool gamma = false) : gammaCorrection(gamma)
+    Model(string const &path, bool gamma = false, unsigned int flags = 0, const LodSettings &lodSettings = LodSettings())
+        : gammaCorrection(gamma), flags(flags & MODEL_ANIMATED ? flags & ~MODEL_COMPRESS_VERTICES : flags), multiDraw(false), lodSettings(lodSettings), boundsCenter(0.0f), boundsRadius(0.0f), boundsMin(0.0f), boundsMax(0.0f)
     {
         loadModel(path);
     }
+    // loadTexture에서 Acquire한 텍스처를 반납 (다른 Model이 안 쓰면 TextureCache가 삭제)
+    ~Model()
+    {
+        for (unsigned int i = 0; i < textures_loaded.size(); i++)
+            TextureCache::Release(textures_loaded[i].id);
+    }
+    Model(const Model &) = delete;
+    Model &operator=(const Model &) = delete;
+
+    // Draw함수, lod는 0(원본)부터 LodCount()-1까지
+    void Draw(Shader &shader, unsigned int lod = 0)
+    {
+        if (multiDraw && arena.IsBuilt())
+        {
+            arena.Draw(shader, lod);
+            return;
+        }
+        for(unsigned int i = 0; i < meshes.size(); i++)
+            meshes[i].Draw(shader, lod);
+    }
 
-    // Draw함수
-    void Draw(Shader &shader)
+    // frustum(world space) 밖의 mesh는 건너뜀, multi draw면 model 전체로 판정
+    void Draw(Shader &shader, const glm::mat4 &model, const Frustum &frustum, FrustumCullStats &stats, unsigned int lod = 0)
     {
+        Frustum local = frustum.Transformed(model);
+        if (multiDraw && arena.IsBuilt())
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            bool visible = local.IntersectsSphere(boundsCenter, boundsRadius);
+            stats.tested++;
+            stats.visible += visible ? 1 : 0;
+            stats.cullMs += elapsedMs(start);
+            if (visible)
+                arena.Draw(shader, lod);
+            return;
+        }
+        meshBounds.Cull(local, meshVisible, stats);
         for(unsigned int i = 0; i < meshes.size(); i++)
-            meshes[i].Draw(shader);
+            if (meshVisible[i])
+                meshes[i].Draw(shader, lod);
+    }
+
+    // meshlet 단위 frustum/backface culling 후 그림 (MODEL_BUILD_MESHLETS, LOD0만)
+    // frustum은 world space, model은 shader에 넘긴 model 행렬
+    void DrawCulled(Shader &shader, const glm::mat4 &model, const Frustum &frustum, const glm::vec3 &cameraPosition, MeshletCullStats &stats)
+    {
+        Frustum local = frustum.Transformed(model);
+        glm::vec3 eye = glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+        for(unsigned int i = 0; i < meshes.size(); i++)
+            meshes[i].DrawCulled(shader, local, eye, stats);
+    }
+
+    // mesh별로 queue에 넣음 (multi draw arena는 쓰지 않음), depth는 model 중심까지 거리
+    void Submit(RenderQueue &queue, const Shader &shader, const glm::mat4 &model, unsigned int lod = 0, unsigned int pass = 0) const
+    {
+        unsigned int depth = queue.Depth(glm::vec3(model * glm::vec4(boundsCenter, 1.0f)));
+        for(unsigned int i = 0; i < meshes.size(); i++)
+            meshes[i].Submit(queue, shader, model, depth, lod, pass);
+    }
+
+    unsigned int LodCount() const { return (unsigned int)lodErrors.size(); }
+    // 해당 LOD로 그릴 때 삼각형 수
+    unsigned int Triangles(unsigned int lod) const
+    {
+        unsigned int triangles = 0;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+            triangles += meshes[i].Lods[lod < meshes[i].Lods.size() ? lod : meshes[i].Lods.size() - 1].indexCount / 3;
+        return triangles;
+    }
+    // 화면에 투영된 오차가 pixelError 이하인 가장 낮은 LOD 선택
+    // worldCenter/worldScale은 이 instance의 model 행렬로 옮긴 boundsCenter와 균등 scale
+    unsigned int SelectLod(const Camera &camera, const glm::vec3 &worldCenter, float worldScale, float viewportHeight, float pixelError = 1.0f) const
+    {
+        float distance = glm::length(worldCenter - camera.Position) - boundsRadius * worldScale;
+        if (distance <= 0.0f || lodErrors.size() < 2)
+            return 0;
+        // 거리 distance에서 world 단위 1이 차지하는 pixel 수
+        float pixelsPerUnit = viewportHeight / (2.0f * distance * tan(glm::radians(camera.Zoom) * 0.5f));
+        unsigned int lod = 0;
+        while (lod + 1 < lodErrors.size() && lodErrors[lod + 1] * worldScale * pixelsPerUnit <= pixelError)
+            lod++;
+        return lod;
     }
     
 private:
+    // textures_loaded의 path -> index
+    unordered_map<string, unsigned int> textureIndex;
+    // Draw(shader, model, frustum, ...)의 mesh별 culling 결과 (매번 할당하지 않도록 재사용)
+    vector<unsigned char> meshVisible;
+
     // loadModel 함수
     void loadModel(string const &path)
     {
-        Assimp::Importer importer;
-        const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
-        // 오류검사
-        if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
+        // 파일의 폴더경로 탐색
+        directory = path.substr(0, path.find_last_of('/'));
+
+        // 캐시가 최신이면 assimp를 거치지 않음
+        auto start = std::chrono::high_resolution_clock::now();
+        string cachePath = path + MODEL_CACHE_EXTENSION;
+        bool animated = (flags & MODEL_ANIMATED) != 0; // skeleton/clip은 캐시에 없음
+        if (!animated && loadModelCache(cachePath, path, cacheOptions()))
         {
-            cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
+            cout << "MODEL::CACHE:: " << path << " loaded from cache in " << elapsedMs(start) << " ms" << endl;
             return;
         }
-        // 파일의 폴더경로 탐색
-        directory = path.substr(0, path.find_last_of('/'));
 
-        processNode(scene->mRootNode, scene);
+        // .obj는 assimp를 거치지 않고 직접 파싱, 실패하거나 다른 형식이면 assimp
+        Assimp::Importer importer;
+        const aiScene* scene = nullptr;
+        vector<aiMesh*> sceneMeshes;
+        vector<MeshData> meshData;
+        vector<string> meshNames;
+        ThreadPool &pool = SharedThreadPool();
+        bool nativeObj = !(flags & MODEL_USE_ASSIMP) && !animated && ObjLoader::IsObjPath(path);
+        if (nativeObj)
+        {
+            ObjLoadReport objReport;
+            nativeObj = ObjLoader::Load(path, pool, meshData, meshNames, objReport);
+            if (nativeObj)
+                objReport.Print(path);
+            else
+            {
+                cout << "ERROR::OBJ:: failed to parse " << path << ", falling back to assimp" << endl;
+                meshData.clear();
+                meshNames.clear();
+            }
+        }
+        if (!nativeObj)
+        {
+            scene = importer.ReadFile(path, MODEL_IMPORT_FLAGS);
+            // 오류검사
+            if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
+            {
+                cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
+                return;
+            }
+            // node 트리를 순서대로 펼침 (mesh 순서 고정)
+            processNode(scene->mRootNode, scene, sceneMeshes);
+            meshData.resize(sceneMeshes.size());
+            for (unsigned int i = 0; i < sceneMeshes.size(); i++)
+                meshNames.push_back(sceneMeshes[i]->mName.C_Str());
+            if (animated)
+                loadAnimations(path, scene);
+        }
+        double importMs = elapsedMs(start);
+
+        // vertex/index 추출(assimp)과 최적화/LOD/압축은 worker thread에서 병렬로
+        start = std::chrono::high_resolution_clock::now();
+        vector<CompressedMeshData> compressed(flags & MODEL_COMPRESS_VERTICES ? meshData.size() : 0);
+        vector<VertexCompressionReport> reports(compressed.size());
+        vector<MeshOptimizeReport> optimizeReports(flags & MODEL_SKIP_OPTIMIZE ? 0 : meshData.size());
+        pool.ParallelFor((unsigned int)meshData.size(), [&](unsigned int i) {
+            if (scene)
+                processMesh(sceneMeshes[i], scene, animated ? &skeleton : nullptr, meshData[i]);
+            if (!optimizeReports.empty())
+                optimizeReports[i] = OptimizeMesh(meshData[i]);
+            if (flags & MODEL_GENERATE_LODS)
+                GenerateLods(meshData[i], lodSettings);
+            if (!compressed.empty())
+                compressMesh(meshData[i].vertices.data(), (unsigned int)meshData[i].vertices.size(),
+                             meshData[i].indices.data(), (unsigned int)meshData[i].indices.size(), compressed[i], reports[i]);
+        });
+        double convertMs = elapsedMs(start);
+        reportOptimize(path, meshNames, optimizeReports);
+
+        // 다음 실행을 위해 캐시 작성 (업로드하면서 meshData를 Mesh로 옮기므로 먼저)
+        start = std::chrono::high_resolution_clock::now();
+        if (!animated && !ModelCache::Write(cachePath, path, MODEL_IMPORT_FLAGS, cacheOptions(), meshData))
+            cout << "ERROR::MODEL::CACHE:: failed to write " << cachePath << endl;
+        double cacheMs = elapsedMs(start);
+
+        // 텍스처 로드와 GL buffer 생성은 context가 있는 이 thread에서
+        start = std::chrono::high_resolution_clock::now();
+        meshes.reserve(meshData.size());
+        for (unsigned int i = 0; i < meshData.size(); i++)
+            meshes.push_back(uploadMesh(meshData[i], compressed.empty() ? nullptr : &compressed[i]));
+        double uploadMs = elapsedMs(start);
+        finishLoad(path, reports);
+
+        cout << (nativeObj ? "MODEL::OBJ:: " : "MODEL::ASSIMP:: ") << path << " (" << meshData.size() << " meshes, " << pool.Size() << " threads)"
+             << " import " << importMs << " ms | convert " << convertMs << " ms | upload " << uploadMs
+             << " ms | cache write " << cacheMs << " ms" << endl;
     }
 
-    void processNode(aiNode *node, const aiScene *scene)
+    // 캐시에서 mesh와 texture 복원
+    bool loadModelCache(const string &cachePath, const string &path, const ModelCacheOptions &options)
     {
-        //현재 노드의 mesh 처리
-        for(unsigned int i = 0; i < node->mNumMeshes; i++)
+        ModelCache cache;
+        if (!cache.Open(cachePath, path, MODEL_IMPORT_FLAGS, options))
+            return false;
+        const vector<CachedMesh> &cached = cache.Meshes();
+        vector<CompressedMeshData> compressed(flags & MODEL_COMPRESS_VERTICES ? cached.size() : 0);
+        vector<VertexCompressionReport> reports(compressed.size());
+        SharedThreadPool().ParallelFor((unsigned int)compressed.size(), [&](unsigned int i) {
+            compressMesh(cached[i].vertices, cached[i].vertexCount, cached[i].indices, cached[i].indexCount, compressed[i], reports[i]);
+        });
+        meshes.reserve(cached.size());
+        for (unsigned int i = 0; i < cached.size(); i++)
         {
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            meshes.push_back(processMesh(mesh, scene));
+            vector<Vertex> vertices(cached[i].vertices, cached[i].vertices + cached[i].vertexCount);
+            vector<unsigned int> indices(cached[i].indices, cached[i].indices + cached[i].indexCount);
+            vector<Texture> textures;
+            for (unsigned int j = 0; j < cached[i].textures.size(); j++)
+                textures.push_back(loadTexture(cached[i].textures[j].path.c_str(), cached[i].textures[j].type));
+            vector<MeshLodData> lods(cached[i].lods.size());
+            for (unsigned int j = 0; j < lods.size(); j++)
+            {
+                lods[j].indices.assign(cached[i].lods[j].indices, cached[i].lods[j].indices + cached[i].lods[j].indexCount);
+                lods[j].error = cached[i].lods[j].error;
+            }
+            meshes.push_back(Mesh(std::move(vertices), std::move(indices), std::move(textures), cached[i].layout,
+                                  compressed.empty() ? nullptr : &compressed[i], lods));
         }
+        finishLoad(path, reports);
+        return true;
+    }
+
+    static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // mesh를 방문 순서대로 모음
+    void processNode(aiNode *node, const aiScene *scene, vector<aiMesh*> &sceneMeshes)
+    {
+        //현재 노드의 mesh 처리
+        for(unsigned int i = 0; i < node->mNumMeshes; i++)
+            sceneMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
         for(unsigned int i = 0; i < node->mNumChildren; i++)
         {
-            processNode(node->mChildren[i], scene);
+            processNode(node->mChildren[i], scene, sceneMeshes);
         }
 
     }
 
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene)
+    // aiMesh -> MeshData, GL 호출 없음 (worker thread에서 실행)
+    // skeleton이 있으면 bone weight도 채움 (skeleton은 읽기만 함)
+    static void processMesh(const aiMesh *mesh, const aiScene *scene, const Skeleton *skeleton, MeshData &data)
     {
-        vector<Vertex> vertices;
-        vector<unsigned int> indices;
-        vector<Texture> textures;
+        vector<Vertex> &vertices = data.vertices;
+        vector<unsigned int> &indices = data.indices;
 
         // mesh의 vertex들 가져오기
+        vertices.resize(mesh->mNumVertices);
+        bool hasNormals = mesh->HasNormals();
+        bool hasTexCoords = mesh->mTextureCoords[0] != nullptr; // 텍스처 좌표가 있는지 확인
+        // 실제로 있는 attribute만 GPU에 올림
+        data.layout = VERTEX_POSITION;
+        if (hasNormals)
+            data.layout |= VERTEX_NORMAL;
+        if (hasTexCoords)
+            data.layout |= VERTEX_TEXCOORDS | VERTEX_TANGENT | VERTEX_BITANGENT;
         for(unsigned int i = 0; i < mesh->mNumVertices; i++)
         {
-            Vertex vertex;
-            glm::vec3 vector;
+            Vertex &vertex = vertices[i];
             // positions
-            vector.x = mesh->mVertices[i].x;
-            vector.y = mesh->mVertices[i].y;
-            vector.z = mesh->mVertices[i].z;
-            vertex.Position = vector;
+            vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
             // normals
-            if (mesh->HasNormals())
-            {
-                vector.x = mesh->mNormals[i].x;
-                vector.y = mesh->mNormals[i].y;
-                vector.z = mesh->mNormals[i].z;
-                vertex.Normal = vector;
-            }
+            if (hasNormals)
+                vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+            else
+                vertex.Normal = glm::vec3(0.0f);
             // texture coordinates
-            if(mesh->mTextureCoords[0]) // 텍스처 좌표가 있는지 확인
+            if(hasTexCoords)
             {
-                glm::vec2 vec;
-                vec.x = mesh->mTextureCoords[0][i].x; 
-                vec.y = mesh->mTextureCoords[0][i].y;
-                vertex.TexCoords = vec;
-                // tangent
-                vector.x = mesh->mTangents[i].x;
-                vector.y = mesh->mTangents[i].y;
-                vector.z = mesh->mTangents[i].z;
-                vertex.Tangent = vector;
-                // bitangent
-                vector.x = mesh->mBitangents[i].x;
-                vector.y = mesh->mBitangents[i].y;
-                vector.z = mesh->mBitangents[i].z;
-                vertex.Bitangent = vector;
+                vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+                // tangent, bitangent
+                vertex.Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+                vertex.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
             }
             else
+            {
                 vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-
-            vertices.push_back(vertex);
+                vertex.Tangent = glm::vec3(0.0f);
+                vertex.Bitangent = glm::vec3(0.0f);
+            }
+            for (int j = 0; j < MAX_BONE_INFLUENCE; j++)
+            {
+                vertex.m_BoneIDs[j] = 0;
+                vertex.m_Weights[j] = 0.0f;
+            }
+        }
+        // bone이 없는 mesh도 weight 0으로 올림 (shader에서 weight 합이 0이면 skinning 생략)
+        if (skeleton && !skeleton->Empty())
+        {
+            data.layout |= VERTEX_BONES;
+            processBones(mesh, *skeleton, vertices);
         }
         //mesh face에 접근, indices 가져오기
+        unsigned int indexCount = 0;
+        for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+            indexCount += mesh->mFaces[i].mNumIndices;
+        indices.resize(indexCount);
+        unsigned int *out = indices.data();
         for(unsigned int i = 0; i < mesh->mNumFaces; i++)
         {
-            aiFace face = mesh->mFaces[i];
+            const aiFace &face = mesh->mFaces[i];
             for(unsigned int j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);        
+                *out++ = face.mIndices[j];
         }
         // Material 처리
         aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];    
@@ -143,93 +394,273 @@ private:
         // normal: texture_normalN
 
         // 1. diffuse maps
-        vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+        collectMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse", data.textures);
         // 2. specular maps
-        vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+        collectMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", data.textures);
         // 3. normal maps
-        std::vector<Texture> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
-        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
+        collectMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal", data.textures);
         // 4. height maps
-        std::vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
-        textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
-        
-        // 완성된 Mesh 반환
-        return Mesh(vertices, indices, textures);
+        collectMaterialTextures(material, aiTextureType_AMBIENT, "texture_height", data.textures);
     }
 
-    //texture 불러오기
-    vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName)
+    // vertex마다 weight가 큰 bone MAX_BONE_INFLUENCE개를 남기고 합이 1이 되게 정규화
+    static void processBones(const aiMesh *mesh, const Skeleton &skeleton, vector<Vertex> &vertices)
     {
-        vector<Texture> textures;
-        for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+        for (unsigned int b = 0; b < mesh->mNumBones; b++)
         {
-            aiString str;
-            mat->GetTexture(type, i, &str);
-
-            bool skip = false;
-            for(unsigned int j = 0; j < textures_loaded.size(); j++)
+            const aiBone *bone = mesh->mBones[b];
+            int boneIndex = skeleton.FindBone(bone->mName.C_Str());
+            if (boneIndex < 0)
+                continue;
+            for (unsigned int w = 0; w < bone->mNumWeights; w++)
             {
-                if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
+                const aiVertexWeight &weight = bone->mWeights[w];
+                if (weight.mVertexId >= vertices.size() || weight.mWeight <= 0.0f)
+                    continue;
+                Vertex &vertex = vertices[weight.mVertexId];
+                int slot = 0;
+                for (int j = 1; j < MAX_BONE_INFLUENCE; j++)
+                    if (vertex.m_Weights[j] < vertex.m_Weights[slot])
+                        slot = j;
+                if (weight.mWeight > vertex.m_Weights[slot])
                 {
-                    textures.push_back(textures_loaded[j]);
-                    skip = true; //사용되어진 텍스처임을 알려줌
-                    break;
+                    vertex.m_BoneIDs[slot] = boneIndex;
+                    vertex.m_Weights[slot] = weight.mWeight;
                 }
             }
-            if(!skip)
-            {
-                Texture texture;
-                texture.id = TextureFromFile(str.C_Str(), this->directory);
-                texture.type = typeName;
-                texture.path = str.C_Str();
-                textures.push_back(texture);
-                textures_loaded.push_back(texture);
-            }
         }
-        return textures;
+        for (unsigned int i = 0; i < vertices.size(); i++)
+        {
+            float total = 0.0f;
+            for (int j = 0; j < MAX_BONE_INFLUENCE; j++)
+                total += vertices[i].m_Weights[j];
+            if (total > 0.0f)
+                for (int j = 0; j < MAX_BONE_INFLUENCE; j++)
+                    vertices[i].m_Weights[j] /= total;
+        }
+    }
+    // skeleton을 만들고 scene의 animation을 모두 clip으로 (mesh 처리 전, main thread)
+    void loadAnimations(const string &path, const aiScene *scene)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        skeleton.Build(scene);
+        animations.resize(scene->mNumAnimations);
+        size_t bytes = 0;
+        SharedThreadPool().ParallelFor(scene->mNumAnimations, [&](unsigned int i) {
+            AnimationClip::Import(scene->mAnimations[i], skeleton, animations[i]);
+        });
+        for (unsigned int i = 0; i < animations.size(); i++)
+            bytes += animations[i].Bytes();
+        cout << "MODEL::ANIMATION:: " << path << " " << skeleton.BoneCount() << " bones / " << skeleton.NodeCount() << " nodes, "
+             << animations.size() << " clips (" << bytes / 1024 << " KB at " << ANIMATION_SAMPLE_RATE << " Hz) in " << elapsedMs(start) << " ms" << endl;
     }
-};
 
+    // vertex 압축 후 원본과 비교 (worker thread)
+    static void compressMesh(const Vertex *vertices, unsigned int vertexCount, const unsigned int *indices, unsigned int indexCount,
+                             CompressedMeshData &compressed, VertexCompressionReport &report)
+    {
+        CompressMesh(vertices, vertexCount, indices, indexCount, compressed);
+        report = MeasureCompression(vertices, vertexCount, indexCount, compressed);
+    }
+    void reportCompression(const string &path, const vector<VertexCompressionReport> &reports)
+    {
+        if (reports.empty())
+            return;
+        for (unsigned int i = 0; i < reports.size(); i++)
+            compression.Merge(reports[i]);
+        compression.Print(path);
+    }
 
-unsigned int TextureFromFile(const char *path, const string &directory, bool gamma)
-{
-    string filename = string(path);
-    filename = directory + '/' + filename;
+    // mesh별 최적화 전후 vertex cache 효율
+    static void reportOptimize(const string &path, const vector<string> &names, const vector<MeshOptimizeReport> &reports)
+    {
+        unsigned int before = 0, after = 0, triangles = 0;
+        float missesBefore = 0.0f, missesAfter = 0.0f;
+        for (unsigned int i = 0; i < reports.size(); i++)
+        {
+            reports[i].Print(path + " [" + names[i] + "]");
+            before += reports[i].verticesBefore;
+            after += reports[i].verticesAfter;
+            triangles += reports[i].triangles;
+            missesBefore += reports[i].acmrBefore * reports[i].triangles;
+            missesAfter += reports[i].acmrAfter * reports[i].triangles;
+        }
+        if (triangles > 0)
+            cout << "MODEL::OPTIMIZE:: " << path << " vertices " << before << " -> " << after << " | ACMR "
+                 << missesBefore / triangles << " -> " << missesAfter / triangles << endl;
+    }
+    // 캐시 내용에 영향을 주는 Model 옵션
+    ModelCacheOptions cacheOptions() const
+    {
+        ModelCacheOptions options;
+        options.processFlags = flags & (MODEL_SKIP_OPTIMIZE | MODEL_GENERATE_LODS | MODEL_USE_ASSIMP);
+        bool lods = (flags & MODEL_GENERATE_LODS) != 0;
+        options.lodLevels = lods ? lodSettings.levels : 0;
+        options.lodRatio = lods ? lodSettings.ratio : 0.0f;
+        options.lodError = lods ? lodSettings.maxError : 0.0f;
+        return options;
+    }
+
+    // mesh가 모두 만들어진 뒤 공통 처리
+    void finishLoad(const string &path, const vector<VertexCompressionReport> &reports)
+    {
+        reportCompression(path, reports);
+        reportLayout(path);
+        updateBounds();
+        updateLods(path);
+        buildMeshlets(path);
+        buildArena(path);
+        releaseCpuData(path);
+    }
+    // 위 처리가 끝나면 CPU 쪽 vertex/index는 필요 없음 (MODEL_KEEP_CPU_DATA가 아니면 해제)
+    void releaseCpuData(const string &path)
+    {
+        size_t released = 0;
+        if (!(flags & MODEL_KEEP_CPU_DATA))
+            for (unsigned int i = 0; i < meshes.size(); i++)
+                released += meshes[i].ReleaseCpuData();
+        ProcessMemory memory = QueryProcessMemory();
+        cout << "MODEL::MEMORY:: " << path << " released " << released / 1024 << " KB of mesh data, RSS "
+             << memory.current / (1024 * 1024) << " MB (peak " << memory.peak / (1024 * 1024) << " MB)" << endl;
+    }
+    // model space AABB와 bounding sphere (mesh AABB 합집합)
+    void updateBounds()
+    {
+        boundsMin = boundsMax = glm::vec3(0.0f);
+        meshBounds.Clear();
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            boundsMin = i ? glm::min(boundsMin, meshes[i].BoundsMin) : meshes[i].BoundsMin;
+            boundsMax = i ? glm::max(boundsMax, meshes[i].BoundsMax) : meshes[i].BoundsMax;
+            meshBounds.AddBox(glm::mat4(1.0f), meshes[i].BoundsMin, meshes[i].BoundsMax);
+        }
+        boundsCenter = (boundsMin + boundsMax) * 0.5f;
+        boundsRadius = glm::length(boundsMax - boundsMin) * 0.5f;
+    }
+    // LOD별 오차와 삼각형 수
+    void updateLods(const string &path)
+    {
+        lodErrors.assign(1, 0.0f);
+        for (unsigned int i = 0; i < meshes.size(); i++)
+            for (unsigned int lod = 1; lod < meshes[i].Lods.size(); lod++)
+            {
+                if (lodErrors.size() <= lod)
+                    lodErrors.push_back(0.0f);
+                lodErrors[lod] = max(lodErrors[lod], meshes[i].Lods[lod].error);
+            }
+        if (lodErrors.size() < 2)
+            return;
+        cout << "MODEL::LOD:: " << path << " triangles";
+        for (unsigned int lod = 0; lod < lodErrors.size(); lod++)
+            cout << (lod ? " / " : " ") << Triangles(lod) << " (error " << lodErrors[lod] << ")";
+        cout << endl;
+    }
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
+    // MODEL_BUILD_MESHLETS면 mesh마다 meshlet 생성 (index 순서는 그대로라 EBO는 건드리지 않음)
+    void buildMeshlets(const string &path)
+    {
+        if (!(flags & MODEL_BUILD_MESHLETS))
+            return;
+        auto start = std::chrono::high_resolution_clock::now();
+        SharedThreadPool().ParallelFor((unsigned int)meshes.size(), [&](unsigned int i) {
+            meshes[i].Meshlets = BuildMeshlets(meshes[i].vertices, meshes[i].indices);
+        });
+        size_t count = 0, triangles = 0;
+        unsigned int cones = 0;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            count += meshes[i].Meshlets.size();
+            triangles += meshes[i].Lods[0].indexCount / 3;
+            for (unsigned int j = 0; j < meshes[i].Meshlets.size(); j++)
+                if (meshes[i].Meshlets[j].coneCutoff < 1.0f)
+                    cones++;
+        }
+        cout << "MODEL::MESHLET:: " << path << " " << count << " meshlets, " << (count ? (float)triangles / count : 0.0f)
+             << " triangles avg, " << cones << " with backface cone (" << elapsedMs(start) << " ms)" << endl;
+    }
 
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-    if (data)
+    // 모든 attribute를 올렸을 때 대비 GPU vertex buffer 크기
+    void reportLayout(const string &path)
     {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
+        size_t fullBytes = 0, uploadedBytes = 0;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            fullBytes += (size_t)meshes[i].VertexCount * sizeof(Vertex);
+            uploadedBytes += meshes[i].VertexBytes();
+        }
+        cout << "MODEL::LAYOUT:: " << path << " vertex buffers " << fullBytes / 1024 << " KB -> " << uploadedBytes / 1024 << " KB" << endl;
+    }
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+    // MODEL_MULTI_DRAW면 mesh들을 arena 하나로 합침
+    void buildArena(const string &path)
+    {
+        if (!(flags & MODEL_MULTI_DRAW))
+            return;
+        if (!arena.Build(meshes))
+        {
+            cout << "ERROR::MODEL::MULTIDRAW:: " << path << " compressed meshes are not supported, using per-mesh draw" << endl;
+            return;
+        }
+        multiDraw = true;
+        // 같은 데이터가 arena에 있으므로 mesh별 buffer는 삭제 (meshlet DrawCulled는 mesh buffer로 그림)
+        size_t released = 0;
+        if (!(flags & (MODEL_KEEP_MESH_BUFFERS | MODEL_BUILD_MESHLETS)))
+            for (unsigned int i = 0; i < meshes.size(); i++)
+                released += meshes[i].ReleaseGpuBuffers();
+        cout << "MODEL::MULTIDRAW:: " << path << " " << meshes.size() << " meshes -> " << arena.DrawCalls() << " draw calls ("
+             << (GLAD_GL_VERSION_4_3 ? "glMultiDrawElementsIndirect" : "glDrawElementsBaseVertex") << "), arena "
+             << arena.Bytes() / 1024 << " KB, released " << released / 1024 << " KB of mesh buffers" << endl;
+    }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // MeshData의 텍스처를 불러오고 GL buffer 생성 (GL thread), vertex/index는 Mesh로 옮겨감
+    Mesh uploadMesh(MeshData &data, const CompressedMeshData *compressed)
+    {
+        vector<Texture> textures;
+        for (unsigned int i = 0; i < data.textures.size(); i++)
+            textures.push_back(loadTexture(data.textures[i].path.c_str(), data.textures[i].type));
+        Mesh mesh(std::move(data.vertices), std::move(data.indices), std::move(textures), data.layout, compressed, data.lods);
+        vector<MeshLodData>().swap(data.lods);
+        return mesh;
+    }
 
-        stbi_image_free(data);
+    //material의 텍스처 경로 수집
+    static void collectMaterialTextures(aiMaterial *mat, aiTextureType type, const string &typeName, vector<TextureRef> &textures)
+    {
+        for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
+        {
+            aiString str;
+            mat->GetTexture(type, i, &str);
+            TextureRef ref;
+            ref.type = typeName;
+            ref.path = str.C_Str();
+            textures.push_back(ref);
+        }
     }
-    else
+
+    // 이 Model에서 이미 쓴 텍스처면 재사용, 아니면 프로세스 공유 TextureCache에서 가져옴
+    Texture loadTexture(const char *path, const string &typeName)
     {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
+        unordered_map<string, unsigned int>::iterator loaded = textureIndex.find(path);
+        if (loaded != textureIndex.end())
+            return textures_loaded[loaded->second]; //사용되어진 텍스처
+        unsigned int cacheFlags = typeName == "texture_normal" ? TEXTURE_NORMAL_MAP : 0;
+        if (flags & MODEL_ASYNC_TEXTURES)
+            cacheFlags |= TEXTURE_ASYNC;
+        if (flags & MODEL_COMPRESS_TEXTURES)
+            cacheFlags |= TEXTURE_COMPRESS;
+        Texture texture;
+        texture.id = TextureCache::Acquire(this->directory + '/' + path, cacheFlags).ID;
+        texture.type = typeName;
+        texture.path = path;
+        textureIndex[texture.path] = (unsigned int)textures_loaded.size();
+        textures_loaded.push_back(texture);
+        return texture;
     }
+};
+
 
-    return textureID;
+unsigned int TextureFromFile(const char *path, const string &directory, bool gamma)
+{
+    return TextureCache::Acquire(directory + '/' + string(path), gamma ? TEXTURE_SRGB : 0).ID;
 }
-#endif
\ No newline at end of file
+#endif
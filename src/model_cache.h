@@ -0,0 +1,275 @@
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include "mesh.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <vector>
+
+// Model 바이너리 캐시 (.meshcache)
+// 구조: Header | source path | [MeshRecord | TextureRef... | LodRecord...] * meshCount | (16byte 정렬) vertex/index/LOD index blob
+// 키: source path, 수정시간, assimp import flag, 후처리 옵션, 버전, sizeof(Vertex)
+const char MODEL_CACHE_MAGIC[4] = { 'M', 'D', 'L', 'C' };
+const uint32_t MODEL_CACHE_VERSION = 4;
+const char *const MODEL_CACHE_EXTENSION = ".meshcache";
+
+// import 후 데이터에 영향을 주는 처리 옵션, 하나라도 다르면 캐시 무효
+struct ModelCacheOptions
+{
+    uint32_t processFlags; // 예: 최적화 여부, LOD 생성 여부
+    uint32_t lodLevels;
+    float    lodRatio;
+    float    lodError;
+};
+
+struct ModelCacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t importFlags;
+    ModelCacheOptions options;
+    uint32_t vertexStride;
+    int64_t  sourceTime;
+    uint32_t meshCount;
+    uint32_t pathLength;
+};
+
+struct ModelCacheMeshRecord
+{
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t textureCount;
+    uint32_t layout; // VertexAttributeBits
+    uint32_t lodCount;
+    uint32_t padding;
+};
+
+struct ModelCacheLodRecord
+{
+    uint64_t indexOffset;
+    uint32_t indexCount;
+    float    error;
+};
+
+// 매핑된 캐시 안의 LOD index
+struct CachedLod
+{
+    const unsigned int *indices;
+    unsigned int        indexCount;
+    float               error;
+};
+
+// 매핑된 캐시 안의 mesh 하나, vertex/index는 매핑된 메모리를 직접 가리킴
+struct CachedMesh
+{
+    const Vertex       *vertices;
+    unsigned int        vertexCount;
+    const unsigned int *indices;
+    unsigned int        indexCount;
+    unsigned int        layout;
+    vector<TextureRef> textures;
+    vector<CachedLod>  lods;
+};
+
+class ModelCache
+{
+public:
+    // 캐시 파일을 매핑하고 검증, 오래됐거나 깨졌으면 false
+    bool Open(const string &cachePath, const string &sourcePath, unsigned int importFlags, const ModelCacheOptions &options)
+    {
+        meshes.clear();
+        long long sourceTime = FileModifiedTime(sourcePath);
+        if (sourceTime < 0 || !file.Open(cachePath))
+            return false;
+
+        size_t cursor = 0;
+        ModelCacheHeader header;
+        if (!read(cursor, &header, sizeof(header)))
+            return fail();
+        if (memcmp(header.magic, MODEL_CACHE_MAGIC, 4) != 0 || header.version != MODEL_CACHE_VERSION ||
+            header.importFlags != importFlags || memcmp(&header.options, &options, sizeof(options)) != 0 || header.vertexStride != sizeof(Vertex) ||
+            header.sourceTime != sourceTime)
+            return fail();
+        string cachedPath;
+        if (!readString(cursor, header.pathLength, cachedPath) || cachedPath != sourcePath)
+            return fail();
+
+        meshes.resize(header.meshCount);
+        for (unsigned int i = 0; i < header.meshCount; i++)
+        {
+            ModelCacheMeshRecord record;
+            if (!read(cursor, &record, sizeof(record)))
+                return fail();
+            uint64_t vertexBytes = (uint64_t)record.vertexCount * sizeof(Vertex);
+            uint64_t indexBytes = (uint64_t)record.indexCount * sizeof(unsigned int);
+            if (record.vertexOffset + vertexBytes > file.Size() || record.indexOffset + indexBytes > file.Size())
+                return fail();
+
+            CachedMesh &mesh = meshes[i];
+            mesh.vertices = (const Vertex*)(file.Data() + record.vertexOffset);
+            mesh.vertexCount = record.vertexCount;
+            mesh.indices = (const unsigned int*)(file.Data() + record.indexOffset);
+            mesh.indexCount = record.indexCount;
+            mesh.layout = record.layout;
+            mesh.textures.resize(record.textureCount);
+            for (unsigned int j = 0; j < record.textureCount; j++)
+            {
+                uint32_t lengths[2];
+                if (!read(cursor, lengths, sizeof(lengths)) ||
+                    !readString(cursor, lengths[0], mesh.textures[j].type) ||
+                    !readString(cursor, lengths[1], mesh.textures[j].path))
+                    return fail();
+            }
+            mesh.lods.resize(record.lodCount);
+            for (unsigned int j = 0; j < record.lodCount; j++)
+            {
+                ModelCacheLodRecord lod;
+                if (!read(cursor, &lod, sizeof(lod)) || lod.indexOffset + (uint64_t)lod.indexCount * sizeof(unsigned int) > file.Size())
+                    return fail();
+                mesh.lods[j].indices = (const unsigned int*)(file.Data() + lod.indexOffset);
+                mesh.lods[j].indexCount = lod.indexCount;
+                mesh.lods[j].error = lod.error;
+            }
+        }
+        return true;
+    }
+    const vector<CachedMesh> &Meshes() const { return meshes; }
+    // 다 쓰고나면 매핑 해제
+    void Close()
+    {
+        meshes.clear();
+        file.Close();
+    }
+
+    // mesh들을 캐시 파일로 기록
+    static bool Write(const string &cachePath, const string &sourcePath, unsigned int importFlags, const ModelCacheOptions &options, const vector<MeshData> &meshes)
+    {
+        long long sourceTime = FileModifiedTime(sourcePath);
+        if (sourceTime < 0)
+            return false;
+
+        // 1. 디렉터리(header, record, texture 참조, LOD) 크기 계산
+        size_t directorySize = sizeof(ModelCacheHeader) + sourcePath.size();
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            directorySize += sizeof(ModelCacheMeshRecord) + meshes[i].lods.size() * sizeof(ModelCacheLodRecord);
+            for (unsigned int j = 0; j < meshes[i].textures.size(); j++)
+                directorySize += 2 * sizeof(uint32_t) + meshes[i].textures[j].type.size() + meshes[i].textures[j].path.size();
+        }
+
+        // 2. 디렉터리 작성, blob 위치는 16byte 정렬
+        std::ofstream out(cachePath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        ModelCacheHeader header;
+        memcpy(header.magic, MODEL_CACHE_MAGIC, 4);
+        header.version = MODEL_CACHE_VERSION;
+        header.importFlags = importFlags;
+        header.options = options;
+        header.vertexStride = sizeof(Vertex);
+        header.sourceTime = sourceTime;
+        header.meshCount = (uint32_t)meshes.size();
+        header.pathLength = (uint32_t)sourcePath.size();
+        out.write((const char*)&header, sizeof(header));
+        out.write(sourcePath.data(), sourcePath.size());
+
+        uint64_t offset = align(directorySize);
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            const MeshData &mesh = meshes[i];
+            ModelCacheMeshRecord record;
+            record.vertexCount = (uint32_t)mesh.vertices.size();
+            record.indexCount = (uint32_t)mesh.indices.size();
+            record.textureCount = (uint32_t)mesh.textures.size();
+            record.layout = mesh.layout;
+            record.lodCount = (uint32_t)mesh.lods.size();
+            record.padding = 0;
+            record.vertexOffset = offset;
+            offset = align(offset + mesh.vertices.size() * sizeof(Vertex));
+            record.indexOffset = offset;
+            offset = align(offset + mesh.indices.size() * sizeof(unsigned int));
+            out.write((const char*)&record, sizeof(record));
+            for (unsigned int j = 0; j < mesh.textures.size(); j++)
+            {
+                uint32_t lengths[2] = { (uint32_t)mesh.textures[j].type.size(), (uint32_t)mesh.textures[j].path.size() };
+                out.write((const char*)lengths, sizeof(lengths));
+                out.write(mesh.textures[j].type.data(), lengths[0]);
+                out.write(mesh.textures[j].path.data(), lengths[1]);
+            }
+            for (unsigned int j = 0; j < mesh.lods.size(); j++)
+            {
+                ModelCacheLodRecord lod;
+                lod.indexOffset = offset;
+                lod.indexCount = (uint32_t)mesh.lods[j].indices.size();
+                lod.error = mesh.lods[j].error;
+                offset = align(offset + mesh.lods[j].indices.size() * sizeof(unsigned int));
+                out.write((const char*)&lod, sizeof(lod));
+            }
+        }
+
+        // 3. vertex/index blob
+        uint64_t written = directorySize;
+        for (unsigned int i = 0; i < meshes.size(); i++)
+        {
+            const MeshData &mesh = meshes[i];
+            pad(out, written);
+            out.write((const char*)mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+            written += mesh.vertices.size() * sizeof(Vertex);
+            pad(out, written);
+            out.write((const char*)mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+            written += mesh.indices.size() * sizeof(unsigned int);
+            for (unsigned int j = 0; j < mesh.lods.size(); j++)
+            {
+                pad(out, written);
+                out.write((const char*)mesh.lods[j].indices.data(), mesh.lods[j].indices.size() * sizeof(unsigned int));
+                written += mesh.lods[j].indices.size() * sizeof(unsigned int);
+            }
+        }
+        return (bool)out;
+    }
+
+private:
+    MappedFile file;
+    vector<CachedMesh> meshes;
+
+    bool fail()
+    {
+        Close();
+        return false;
+    }
+    bool read(size_t &cursor, void *dst, size_t bytes)
+    {
+        if (cursor + bytes > file.Size())
+            return false;
+        memcpy(dst, file.Data() + cursor, bytes);
+        cursor += bytes;
+        return true;
+    }
+    bool readString(size_t &cursor, size_t length, string &dst)
+    {
+        if (cursor + length > file.Size())
+            return false;
+        dst.assign((const char*)file.Data() + cursor, length);
+        cursor += length;
+        return true;
+    }
+    static uint64_t align(uint64_t offset)
+    {
+        return (offset + 15) & ~(uint64_t)15;
+    }
+    static void pad(std::ofstream &out, uint64_t &written)
+    {
+        static const char zeros[16] = { 0 };
+        uint64_t aligned = align(written);
+        out.write(zeros, aligned - written);
+        written = aligned;
+    }
+};
+
+#endif
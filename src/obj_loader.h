@@ -0,0 +1,639 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Wavefront OBJ/MTL을 assimp 없이 직접 읽음 (Model::loadModel에서 .obj일 때)
+// 파일을 메모리 매핑하고 줄 경계로 자른 chunk를 thread마다 파싱, (v, vt, vn) 조합은 hash로 합쳐서 index buffer를 만듦
+// 결과는 MODEL_IMPORT_FLAGS로 assimp를 거친 것과 같은 규칙을 따름
+//   다각형은 fan 삼각형, normal이 없으면 smooth normal, UV의 V 뒤집기, UV가 있으면 tangent/bitangent 계산
+// mesh는 usemtl(material) 단위로 나눔, 처음 나온 순서
+
+// chunk 하나의 크기 (이보다 작은 파일은 나누지 않음)
+const size_t OBJ_CHUNK_BYTES = 1 << 20;
+// 이보다 corner가 많은 mesh는 dedup도 thread별로 나눠서
+const size_t OBJ_PARALLEL_DEDUP_CORNERS = 1 << 18;
+
+struct ObjLoadReport
+{
+    unsigned int chunks = 0;
+    unsigned int positions = 0;
+    unsigned int triangles = 0;
+    unsigned int vertices = 0;  // dedup 후
+    double parseMs = 0.0;
+    double buildMs = 0.0;
+
+    void Print(const string &path) const
+    {
+        cout << "MODEL::OBJ:: " << path << " " << triangles << " triangles, " << positions << " positions -> " << vertices
+             << " vertices | parse " << parseMs << " ms (" << chunks << " chunks) | build " << buildMs << " ms" << endl;
+    }
+};
+
+// strtof 대신 쓰는 float 파싱 (locale 없음, 부호/소수점/지수), 끝난 위치 반환
+inline const char *ParseObjFloat(const char *p, const char *end, float &value)
+{
+    static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    // 유효숫자 18자리까지 정수로 모으고 나머지는 지수로
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    while (p < end && (unsigned int)(*p - '0') < 10)
+    {
+        if (mantissa < 100000000000000000ULL)
+            mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+        else
+            exponent++;
+        p++;
+    }
+    if (p < end && *p == '.')
+    {
+        p++;
+        while (p < end && (unsigned int)(*p - '0') < 10)
+        {
+            if (mantissa < 100000000000000000ULL)
+            {
+                mantissa = mantissa * 10 + (unsigned int)(*p - '0');
+                exponent--;
+            }
+            p++;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negativeExponent = *p++ == '-';
+        int e = 0;
+        while (p < end && (unsigned int)(*p - '0') < 10)
+        {
+            if (e < 10000)
+                e = e * 10 + (*p - '0');
+            p++;
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    // 10^22까지는 double로 정확하므로 곱/나눗셈 한 번
+    double result = (double)mantissa;
+    if (mantissa == 0)
+        result = 0.0;
+    else if (exponent >= 0 && exponent <= 22)
+        result *= powers[exponent];
+    else if (exponent < 0 && exponent >= -22)
+        result /= powers[-exponent];
+    else
+        result *= pow(10.0, (double)exponent);
+    value = (float)(negative ? -result : result);
+    return p;
+}
+
+inline const char *ParseObjInt(const char *p, const char *end, int &value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    int result = 0;
+    while (p < end && (unsigned int)(*p - '0') < 10)
+        result = result * 10 + (*p++ - '0');
+    value = negative ? -result : result;
+    return p;
+}
+
+class ObjLoader
+{
+public:
+    // path를 읽어서 material별 MeshData로, names는 mesh 이름(material 이름)
+    // 실패하면 false (호출하는 쪽에서 assimp로)
+    static bool Load(const string &path, ThreadPool &pool, vector<MeshData> &meshes, vector<string> &names, ObjLoadReport &report)
+    {
+        auto start = chrono::steady_clock::now();
+        MappedFile file;
+        if (!file.Open(path))
+            return false;
+        const char *data = (const char*)file.Data();
+        size_t size = file.Size();
+
+        // 1. 줄 경계로 chunk를 나누고 병렬 파싱
+        size_t chunkCount = max<size_t>(1, min<size_t>(size / OBJ_CHUNK_BYTES, (size_t)pool.Size() * 4));
+        vector<size_t> bounds(chunkCount + 1);
+        bounds[0] = 0;
+        bounds[chunkCount] = size;
+        for (size_t c = 1; c < chunkCount; c++)
+        {
+            const char *p = data + size * c / chunkCount;
+            const char *newline = (const char*)memchr(p, '\n', data + size - p);
+            bounds[c] = max(bounds[c - 1], newline ? (size_t)(newline + 1 - data) : size); // 줄이 chunk보다 길면 빈 chunk
+        }
+        vector<Chunk> chunks(chunkCount);
+        pool.ParallelFor((unsigned int)chunkCount, [&](unsigned int c) {
+            parseChunk(data + bounds[c], data + bounds[c + 1], chunks[c]);
+        });
+        report.chunks = (unsigned int)chunkCount;
+        report.parseMs = elapsedMs(start);
+        start = chrono::steady_clock::now();
+
+        // 2. chunk별 개수로 전역 index 확정 (음수 index는 chunk 시작 기준으로 저장돼 있음)
+        vector<float> positions, texcoords, normals;
+        size_t base[3] = { 0, 0, 0 };
+        for (size_t c = 0; c < chunkCount; c++)
+        {
+            Chunk &chunk = chunks[c];
+            for (size_t i = 0; i < chunk.relative.size(); i++)
+            {
+                size_t k = chunk.relative[i];
+                chunk.corners[k] += (int)base[k % 3];
+            }
+            base[0] += chunk.positions.size() / 3;
+            base[1] += chunk.texcoords.size() / 2;
+            base[2] += chunk.normals.size() / 3;
+        }
+        positions.reserve(base[0] * 3);
+        texcoords.reserve(base[1] * 2);
+        normals.reserve(base[2] * 3);
+        for (size_t c = 0; c < chunkCount; c++)
+        {
+            positions.insert(positions.end(), chunks[c].positions.begin(), chunks[c].positions.end());
+            texcoords.insert(texcoords.end(), chunks[c].texcoords.begin(), chunks[c].texcoords.end());
+            normals.insert(normals.end(), chunks[c].normals.begin(), chunks[c].normals.end());
+            vector<float>().swap(chunks[c].positions);
+            vector<float>().swap(chunks[c].texcoords);
+            vector<float>().swap(chunks[c].normals);
+        }
+        if (positions.empty())
+        {
+            cout << "ERROR::OBJ:: " << path << " has no vertex positions" << endl;
+            return false;
+        }
+
+        // 3. usemtl 구간을 material별로 모음 (chunk 첫 구간의 material은 앞 chunk에서 이어짐)
+        string directory = path.substr(0, path.find_last_of('/'));
+        unordered_map<string, ObjMaterial> materials;
+        for (size_t c = 0; c < chunkCount; c++)
+            for (size_t i = 0; i < chunks[c].libraries.size(); i++)
+                loadMaterialLibrary(directory + '/' + chunks[c].libraries[i], materials);
+
+        vector<vector<Range>> meshRanges;
+        unordered_map<string, unsigned int> meshIndex;
+        string current;
+        for (size_t c = 0; c < chunkCount; c++)
+        {
+            const Chunk &chunk = chunks[c];
+            size_t triangleCount = chunk.corners.size() / 9;
+            for (size_t r = 0; r < chunk.runs.size(); r++)
+            {
+                if (chunk.runs[r].hasMaterial)
+                    current = chunk.runs[r].material;
+                size_t end = r + 1 < chunk.runs.size() ? chunk.runs[r + 1].firstTriangle : triangleCount;
+                if (end == chunk.runs[r].firstTriangle)
+                    continue;
+                auto it = meshIndex.find(current);
+                if (it == meshIndex.end())
+                {
+                    it = meshIndex.insert(make_pair(current, (unsigned int)meshRanges.size())).first;
+                    meshRanges.push_back(vector<Range>());
+                    names.push_back(current.empty() ? "default" : current);
+                }
+                Range range = { &chunk, chunk.runs[r].firstTriangle, end };
+                meshRanges[it->second].push_back(range);
+            }
+        }
+
+        // 4. mesh별 vertex dedup + normal/tangent (큰 mesh는 dedup 자체를 병렬로)
+        meshes.resize(meshRanges.size());
+        Attributes attributes = { &positions, &texcoords, &normals };
+        for (size_t m = 0; m < meshes.size(); m++)
+        {
+            buildMesh(meshRanges[m], attributes, pool, meshes[m]);
+            auto material = materials.find(names[m]);
+            if (material != materials.end())
+                meshes[m].textures = material->second.textures;
+            report.triangles += (unsigned int)(meshes[m].indices.size() / 3);
+            report.vertices += (unsigned int)meshes[m].vertices.size();
+        }
+        report.positions = (unsigned int)(positions.size() / 3);
+        report.buildMs = elapsedMs(start);
+        return !meshes.empty();
+    }
+
+    static bool IsObjPath(const string &path)
+    {
+        size_t dot = path.find_last_of('.');
+        if (dot == string::npos || path.size() - dot != 4)
+            return false;
+        return tolower(path[dot + 1]) == 'o' && tolower(path[dot + 2]) == 'b' && tolower(path[dot + 3]) == 'j';
+    }
+
+private:
+    // corner의 vt/vn이 없을 때
+    static const int MISSING = INT_MIN;
+
+    struct Run
+    {
+        size_t firstTriangle;
+        bool hasMaterial;  // false면 앞 chunk의 material을 이어서 씀
+        string material;
+    };
+    struct Chunk
+    {
+        vector<float> positions, texcoords, normals;
+        vector<int> corners;       // 삼각형마다 (v, vt, vn) x 3, 0부터 시작
+        vector<size_t> relative;   // 음수 index로 들어온 corners 위치 (chunk 시작 기준)
+        vector<Run> runs;
+        vector<string> libraries;  // mtllib
+    };
+    struct Range
+    {
+        const Chunk *chunk;
+        size_t firstTriangle, endTriangle;
+    };
+    struct Attributes
+    {
+        const vector<float> *positions, *texcoords, *normals;
+    };
+    struct ObjMaterial
+    {
+        vector<TextureRef> textures;
+    };
+
+    static double elapsedMs(chrono::steady_clock::time_point start)
+    {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    static const char *skipSpaces(const char *p, const char *end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            p++;
+        return p;
+    }
+    static const char *lineEnd(const char *p, const char *end)
+    {
+        const char *newline = (const char*)memchr(p, '\n', end - p);
+        return newline ? newline : end;
+    }
+    static string restOfLine(const char *p, const char *end)
+    {
+        p = skipSpaces(p, end);
+        while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+            end--;
+        return string(p, end);
+    }
+    static bool startsWith(const char *p, const char *end, const char *word)
+    {
+        size_t length = strlen(word);
+        return (size_t)(end - p) > length && memcmp(p, word, length) == 0 && (p[length] == ' ' || p[length] == '\t');
+    }
+
+    static void parseChunk(const char *p, const char *end, Chunk &chunk)
+    {
+        Run first = { 0, false, string() };
+        chunk.runs.push_back(first);
+        vector<int> face;               // 한 면의 (v, vt, vn)
+        vector<unsigned char> relative; // face와 같은 순서, 음수 index였는지
+        while (p < end)
+        {
+            p = skipSpaces(p, end);
+            const char *eol = lineEnd(p, end);
+            if (p + 1 < eol)
+            {
+                if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+                {
+                    float v[3] = { 0.0f, 0.0f, 0.0f };
+                    const char *q = p + 1;
+                    for (int k = 0; k < 3; k++)
+                        q = ParseObjFloat(skipSpaces(q, eol), eol, v[k]);
+                    chunk.positions.insert(chunk.positions.end(), v, v + 3);
+                }
+                else if (p[0] == 'v' && p[1] == 't')
+                {
+                    float v[2] = { 0.0f, 0.0f };
+                    const char *q = p + 2;
+                    for (int k = 0; k < 2; k++)
+                        q = ParseObjFloat(skipSpaces(q, eol), eol, v[k]);
+                    chunk.texcoords.insert(chunk.texcoords.end(), v, v + 2);
+                }
+                else if (p[0] == 'v' && p[1] == 'n')
+                {
+                    float v[3] = { 0.0f, 0.0f, 0.0f };
+                    const char *q = p + 2;
+                    for (int k = 0; k < 3; k++)
+                        q = ParseObjFloat(skipSpaces(q, eol), eol, v[k]);
+                    chunk.normals.insert(chunk.normals.end(), v, v + 3);
+                }
+                else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+                    parseFace(p + 1, eol, chunk, face, relative);
+                else if (startsWith(p, eol, "usemtl"))
+                {
+                    Run run = { chunk.corners.size() / 9, true, restOfLine(p + 6, eol) };
+                    if (chunk.runs.back().firstTriangle == run.firstTriangle)
+                        chunk.runs.back() = run;
+                    else
+                        chunk.runs.push_back(run);
+                }
+                else if (startsWith(p, eol, "mtllib"))
+                    chunk.libraries.push_back(restOfLine(p + 6, eol));
+            }
+            p = eol + 1;
+        }
+    }
+
+    // "f v/vt/vn ..." -> fan 삼각형
+    static void parseFace(const char *p, const char *eol, Chunk &chunk, vector<int> &face, vector<unsigned char> &relative)
+    {
+        int counts[3] = { (int)(chunk.positions.size() / 3), (int)(chunk.texcoords.size() / 2), (int)(chunk.normals.size() / 3) };
+        face.clear();
+        relative.clear();
+        unsigned int corners = 0;
+        while (true)
+        {
+            p = skipSpaces(p, eol);
+            if (p >= eol || ((unsigned int)(*p - '0') >= 10 && *p != '-' && *p != '+'))
+                break;
+            for (int k = 0; k < 3; k++)
+            {
+                int index = MISSING;
+                if (k == 0 || (p < eol && *p == '/'))
+                {
+                    if (k > 0)
+                        p++;
+                    if (p < eol && *p != '/' && *p != ' ' && *p != '\t' && *p != '\r')
+                        p = ParseObjInt(p, eol, index);
+                }
+                // 1부터 시작, 음수는 지금까지 나온 개수 기준
+                relative.push_back(index != MISSING && index < 0 ? 1 : 0);
+                if (index != MISSING)
+                    index = index < 0 ? counts[k] + index : index - 1;
+                face.push_back(index);
+            }
+            corners++;
+        }
+        if (corners < 3)
+            return;
+        for (unsigned int i = 1; i + 1 < corners; i++)
+        {
+            unsigned int triangle[3] = { 0, i, i + 1 };
+            for (int t = 0; t < 3; t++)
+                for (int k = 0; k < 3; k++)
+                {
+                    unsigned int corner = triangle[t];
+                    if (relative[corner * 3 + k])
+                        chunk.relative.push_back(chunk.corners.size());
+                    chunk.corners.push_back(face[corner * 3 + k]);
+                }
+        }
+    }
+
+    // map_Kd 등 -> TextureRef (type 이름은 Model::processMesh의 assimp 대응과 같음)
+    static void loadMaterialLibrary(const string &path, unordered_map<string, ObjMaterial> &materials)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            cout << "ERROR::OBJ:: failed to open material library " << path << endl;
+            return;
+        }
+        const char *p = (const char*)file.Data(), *end = p + file.Size();
+        ObjMaterial *current = nullptr;
+        while (p < end)
+        {
+            p = skipSpaces(p, end);
+            const char *eol = lineEnd(p, end);
+            const char *type = nullptr;
+            size_t keyword = 0;
+            if (startsWith(p, eol, "newmtl"))
+                current = &materials[restOfLine(p + 6, eol)];
+            else if (startsWith(p, eol, "map_Kd"))
+                type = "texture_diffuse", keyword = 6;
+            else if (startsWith(p, eol, "map_Ks"))
+                type = "texture_specular", keyword = 6;
+            else if (startsWith(p, eol, "map_Bump") || startsWith(p, eol, "map_bump"))
+                type = "texture_normal", keyword = 8;
+            else if (startsWith(p, eol, "bump"))
+                type = "texture_normal", keyword = 4;
+            else if (startsWith(p, eol, "map_Ka"))
+                type = "texture_height", keyword = 6;
+            if (type && current)
+            {
+                // "-bm 1.0 file.png" 같은 옵션은 건너뛰고 마지막 단어를 파일명으로
+                string value = restOfLine(p + keyword, eol);
+                size_t space = value.find_last_of(" \t");
+                TextureRef ref;
+                ref.type = type;
+                ref.path = space == string::npos ? value : value.substr(space + 1);
+                current->textures.push_back(ref);
+            }
+            p = eol + 1;
+        }
+        // Model과 같은 순서 (diffuse, specular, normal, height)
+        static const char *order[] = { "texture_diffuse", "texture_specular", "texture_normal", "texture_height" };
+        for (auto &material : materials)
+            stable_sort(material.second.textures.begin(), material.second.textures.end(), [](const TextureRef &a, const TextureRef &b) {
+                int ia = 0, ib = 0;
+                for (int i = 0; i < 4; i++)
+                {
+                    if (a.type == order[i]) ia = i;
+                    if (b.type == order[i]) ib = i;
+                }
+                return ia < ib;
+            });
+    }
+
+    // (v, vt, vn) open addressing hash
+    static unsigned int hashCorner(const int *corner)
+    {
+        unsigned int h = (unsigned int)corner[0] * 0x9E3779B1u;
+        h ^= (unsigned int)corner[1] * 0x85EBCA77u + (h << 6) + (h >> 2);
+        h ^= (unsigned int)corner[2] * 0xC2B2AE3Du + (h << 6) + (h >> 2);
+        return h ^ (h >> 15);
+    }
+
+    static void buildMesh(const vector<Range> &ranges, const Attributes &attributes, ThreadPool &pool, MeshData &data)
+    {
+        // corner 배열을 하나로 (구간들이 여러 chunk에 걸쳐 있을 수 있음)
+        size_t cornerCount = 0;
+        for (size_t r = 0; r < ranges.size(); r++)
+            cornerCount += (ranges[r].endTriangle - ranges[r].firstTriangle) * 3;
+        vector<int> corners;
+        corners.reserve(cornerCount * 3);
+        for (size_t r = 0; r < ranges.size(); r++)
+        {
+            const vector<int> &source = ranges[r].chunk->corners;
+            corners.insert(corners.end(), source.begin() + ranges[r].firstTriangle * 9, source.begin() + ranges[r].endTriangle * 9);
+        }
+
+        // 범위 밖 index는 없는 것으로
+        const size_t limits[3] = { attributes.positions->size() / 3, attributes.texcoords->size() / 2, attributes.normals->size() / 3 };
+        bool hasTexCoords = false, hasNormals = false;
+        for (size_t c = 0; c < cornerCount; c++)
+        {
+            int *corner = &corners[c * 3];
+            for (int k = 0; k < 3; k++)
+                if (corner[k] != MISSING && (corner[k] < 0 || (size_t)corner[k] >= limits[k]))
+                    corner[k] = k == 0 ? 0 : MISSING;
+            hasTexCoords |= corner[1] != MISSING;
+            hasNormals |= corner[2] != MISSING;
+        }
+
+        // 1. hash로 같은 corner 합치기, 큰 mesh는 hash 값으로 나눈 partition마다 thread 하나
+        unsigned int partitions = cornerCount >= OBJ_PARALLEL_DEDUP_CORNERS ? min(max(pool.Size(), 1u), 255u) : 1;
+        vector<unsigned int> local(cornerCount);
+        vector<unsigned char> owner(partitions > 1 ? cornerCount : 0);
+        vector<vector<unsigned int>> unique(partitions); // partition별 대표 corner
+        auto dedup = [&](unsigned int part) {
+            // 보통 corner 6개당 vertex 하나 정도라서 작게 시작하고 절반 차면 키움
+            size_t capacity = 16;
+            while (capacity < cornerCount / partitions / 2)
+                capacity <<= 1;
+            // key를 같이 저장해서 비교할 때 corners를 다시 읽지 않음
+            struct Entry
+            {
+                int key[3];
+                unsigned int id;
+            };
+            Entry empty = { { 0, 0, 0 }, ~0u };
+            vector<Entry> table(capacity, empty);
+            vector<unsigned int> &representatives = unique[part];
+            for (size_t c = 0; c < cornerCount; c++)
+            {
+                const int *corner = &corners[c * 3];
+                unsigned int h = hashCorner(corner);
+                if (partitions > 1)
+                {
+                    if (h % partitions != part)
+                        continue;
+                    owner[c] = (unsigned char)part;
+                }
+                if ((representatives.size() + 1) * 2 > capacity)
+                {
+                    capacity <<= 1;
+                    table.assign(capacity, empty);
+                    for (unsigned int u = 0; u < representatives.size(); u++)
+                    {
+                        const int *key = &corners[representatives[u] * 3];
+                        size_t s = (hashCorner(key) / partitions) & (capacity - 1);
+                        while (table[s].id != ~0u)
+                            s = (s + 1) & (capacity - 1);
+                        Entry entry = { { key[0], key[1], key[2] }, u };
+                        table[s] = entry;
+                    }
+                }
+                size_t slot = (h / partitions) & (capacity - 1);
+                while (table[slot].id != ~0u &&
+                       (table[slot].key[0] != corner[0] || table[slot].key[1] != corner[1] || table[slot].key[2] != corner[2]))
+                    slot = (slot + 1) & (capacity - 1);
+                if (table[slot].id == ~0u)
+                {
+                    Entry entry = { { corner[0], corner[1], corner[2] }, (unsigned int)representatives.size() };
+                    table[slot] = entry;
+                    representatives.push_back((unsigned int)c);
+                }
+                local[c] = table[slot].id;
+            }
+        };
+        if (partitions > 1)
+            pool.ParallelFor(partitions, dedup);
+        else
+            dedup(0);
+
+        vector<unsigned int> offsets(partitions + 1, 0);
+        for (unsigned int part = 0; part < partitions; part++)
+            offsets[part + 1] = offsets[part] + (unsigned int)unique[part].size();
+        unsigned int vertexCount = offsets[partitions];
+
+        data.indices.resize(cornerCount);
+        for (size_t c = 0; c < cornerCount; c++)
+            data.indices[c] = offsets[partitions > 1 ? owner[c] : 0] + local[c];
+
+        // 2. vertex 채우기 (V 뒤집기 = aiProcess_FlipUVs)
+        data.vertices.assign(vertexCount, Vertex());
+        const float *positions = attributes.positions->data();
+        const float *texcoords = attributes.texcoords->data();
+        const float *normals = attributes.normals->data();
+        vector<unsigned int> positionOf(vertexCount);
+        for (unsigned int part = 0; part < partitions; part++)
+            for (unsigned int u = 0; u < unique[part].size(); u++)
+            {
+                const int *corner = &corners[unique[part][u] * 3];
+                unsigned int v = offsets[part] + u;
+                Vertex &vertex = data.vertices[v];
+                positionOf[v] = (unsigned int)corner[0];
+                vertex.Position = glm::vec3(positions[corner[0] * 3], positions[corner[0] * 3 + 1], positions[corner[0] * 3 + 2]);
+                if (corner[1] != MISSING)
+                    vertex.TexCoords = glm::vec2(texcoords[corner[1] * 2], 1.0f - texcoords[corner[1] * 2 + 1]);
+                if (corner[2] != MISSING)
+                    vertex.Normal = glm::vec3(normals[corner[2] * 3], normals[corner[2] * 3 + 1], normals[corner[2] * 3 + 2]);
+            }
+
+        // 3. normal이 하나도 없으면 같은 위치의 면 normal 평균 (aiProcess_GenSmoothNormals)
+        if (!hasNormals)
+        {
+            vector<glm::vec3> accumulated(limits[0], glm::vec3(0.0f));
+            for (size_t i = 0; i < cornerCount; i += 3)
+            {
+                const glm::vec3 &p0 = data.vertices[data.indices[i]].Position;
+                glm::vec3 n = glm::cross(data.vertices[data.indices[i + 1]].Position - p0, data.vertices[data.indices[i + 2]].Position - p0);
+                for (int k = 0; k < 3; k++)
+                    accumulated[positionOf[data.indices[i + k]]] += n;
+            }
+            for (unsigned int v = 0; v < vertexCount; v++)
+            {
+                glm::vec3 n = accumulated[positionOf[v]];
+                float length = glm::length(n);
+                data.vertices[v].Normal = length > 0.0f ? n / length : glm::vec3(0.0f);
+            }
+        }
+
+        // 4. tangent/bitangent (aiProcess_CalcTangentSpace), 삼각형 값을 vertex에 모은 뒤 normal에 직교화
+        data.layout = VERTEX_POSITION | VERTEX_NORMAL;
+        if (hasTexCoords)
+        {
+            data.layout |= VERTEX_TEXCOORDS | VERTEX_TANGENT | VERTEX_BITANGENT;
+            for (size_t i = 0; i < cornerCount; i += 3)
+            {
+                Vertex &a = data.vertices[data.indices[i]];
+                Vertex &b = data.vertices[data.indices[i + 1]];
+                Vertex &c = data.vertices[data.indices[i + 2]];
+                glm::vec3 edge1 = b.Position - a.Position, edge2 = c.Position - a.Position;
+                glm::vec2 uv1 = b.TexCoords - a.TexCoords, uv2 = c.TexCoords - a.TexCoords;
+                float det = uv1.x * uv2.y - uv2.x * uv1.y;
+                if (fabs(det) < 1e-12f)
+                    continue;
+                float r = 1.0f / det;
+                glm::vec3 tangent = (edge1 * uv2.y - edge2 * uv1.y) * r;
+                glm::vec3 bitangent = (edge2 * uv1.x - edge1 * uv2.x) * r;
+                a.Tangent += tangent; b.Tangent += tangent; c.Tangent += tangent;
+                a.Bitangent += bitangent; b.Bitangent += bitangent; c.Bitangent += bitangent;
+            }
+            for (unsigned int v = 0; v < vertexCount; v++)
+            {
+                Vertex &vertex = data.vertices[v];
+                glm::vec3 t = vertex.Tangent - vertex.Normal * glm::dot(vertex.Normal, vertex.Tangent);
+                glm::vec3 b = vertex.Bitangent - vertex.Normal * glm::dot(vertex.Normal, vertex.Bitangent);
+                float tl = glm::length(t), bl = glm::length(b);
+                vertex.Tangent = tl > 0.0f ? t / tl : glm::vec3(0.0f);
+                vertex.Bitangent = bl > 0.0f ? b / bl : glm::vec3(0.0f);
+            }
+        }
+    }
+};
+
+#endif
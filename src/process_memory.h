@@ -0,0 +1,57 @@
+#ifndef PROCESS_MEMORY_H
+#define PROCESS_MEMORY_H
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#undef APIENTRY
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <cstdio>
+#include <cstring>
+#endif
+
+#include <cstddef>
+
+// 프로세스 메모리 사용량 (resident set, byte), 알 수 없으면 0
+// Windows는 GetProcessMemoryInfo(working set), Linux는 /proc/self/status
+struct ProcessMemory
+{
+    size_t current = 0; // 현재 RSS
+    size_t peak = 0;    // 지금까지 최대 RSS
+};
+
+inline ProcessMemory QueryProcessMemory()
+{
+    ProcessMemory memory;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        memory.current = counters.WorkingSetSize;
+        memory.peak = counters.PeakWorkingSetSize;
+    }
+#else
+    FILE *file = fopen("/proc/self/status", "r");
+    if (!file)
+        return memory;
+    char line[256];
+    while (fgets(line, sizeof(line), file))
+    {
+        unsigned long kb = 0;
+        if (strncmp(line, "VmRSS:", 6) == 0 && sscanf(line + 6, "%lu", &kb) == 1)
+            memory.current = (size_t)kb * 1024;
+        else if (strncmp(line, "VmHWM:", 6) == 0 && sscanf(line + 6, "%lu", &kb) == 1)
+            memory.peak = (size_t)kb * 1024;
+    }
+    fclose(file);
+#endif
+    return memory;
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl_state.h"
+#include "material.h"
+#include "uniform_table.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// draw 호출을 바로 하지 않고 모아뒀다가 64bit 정렬 키 순서로 한 번에 실행
+// 같은 program/VAO/텍스처가 연속되면 다시 바인딩하지 않음
+//
+// 키 구성 (상위 bit부터)
+//   불투명:  pass 4 | 0 | program 11 | material 16 | depth 24 (가까운 것부터) | 8 비움
+//   반투명:  pass 4 | 1 | depth 24 (먼 것부터) | program 11 | material 16 | 8 비움
+// 정렬은 stable이라 키가 같으면 제출한 순서를 유지함 (2D sprite의 그리는 순서)
+const unsigned int RENDER_QUEUE_MAX_UNITS = 16;
+const unsigned int RENDER_QUEUE_DEPTH_BITS = 24;
+
+struct RenderCommand;
+// draw 직전에 command별 uniform 설정 (program은 이미 use 상태)
+typedef void (*RenderUniformFn)(const RenderCommand &command);
+
+struct RenderCommand
+{
+    uint64_t key;
+    GLuint program;
+    GLuint vao;
+    // 텍스처: material이 있으면 slot i -> 유닛 i, 없으면 texture를 0번 유닛에
+    const Material *material;
+    GLuint texture;
+    // draw 인자, indexType이 0이면 glDrawArrays(first, count)
+    GLenum mode;
+    GLenum indexType;
+    GLsizei count;
+    GLint first;
+    const void *indexOffset;
+    GLsizei instanceCount;
+    // per-draw uniform, modelLocation이 0 이상이면 queue가 model을 설정
+    GLint modelLocation;
+    glm::mat4 model;
+    glm::vec4 color;
+    RenderUniformFn uniforms; // 나머지 uniform (없으면 nullptr)
+    const void *object;       // uniforms에서 쓰는 원본 객체
+};
+
+// 한 번 Flush할 때의 상태 변경 횟수 (여러 프레임 누적)
+struct RenderQueueStats
+{
+    unsigned int commands = 0;
+    unsigned int programSwitches = 0;
+    unsigned int vaoSwitches = 0;
+    unsigned int textureBinds = 0;
+    // 정렬하지 않고 제출 순서대로 그렸을 때의 횟수 (비교용)
+    unsigned int unsortedProgramSwitches = 0;
+    unsigned int unsortedVaoSwitches = 0;
+    unsigned int unsortedTextureBinds = 0;
+    double sortMs = 0.0;
+    double submitMs = 0.0;
+
+    void Reset() { *this = RenderQueueStats(); }
+    void Print(const string &name, unsigned int frames = 1) const
+    {
+        frames = max(frames, 1u);
+        cout << "RENDER::QUEUE:: " << name << " " << commands / frames << " draws/frame | switches program " << programSwitches / frames
+             << " vao " << vaoSwitches / frames << " texture " << textureBinds / frames << " (unsorted " << unsortedProgramSwitches / frames
+             << " / " << unsortedVaoSwitches / frames << " / " << unsortedTextureBinds / frames << ") | sort " << sortMs / frames
+             << " ms, submit " << submitMs / frames << " ms/frame" << endl;
+    }
+};
+
+class RenderQueue
+{
+public:
+    RenderQueue() : eye(0.0f), farPlane(100.0f) { }
+
+    static uint64_t MakeKey(unsigned int pass, bool translucent, GLuint program, unsigned int material, unsigned int depth)
+    {
+        uint64_t key = (uint64_t)(pass & 0xF) << 60 | (uint64_t)(translucent ? 1 : 0) << 59;
+        if (translucent)
+            return key | (uint64_t)(~depth & 0xFFFFFF) << 35 | (uint64_t)(program & 0x7FF) << 24 | (uint64_t)(material & 0xFFFF) << 8;
+        return key | (uint64_t)(program & 0x7FF) << 48 | (uint64_t)(material & 0xFFFF) << 32 | (uint64_t)(depth & 0xFFFFFF) << 8;
+    }
+
+    // depth 키 기준 (보통 프레임마다 카메라 위치)
+    void SetView(const glm::vec3 &eye, float farPlane)
+    {
+        this->eye = eye;
+        this->farPlane = farPlane;
+    }
+    // world 위치 -> 24bit depth (카메라 거리 / farPlane)
+    unsigned int Depth(const glm::vec3 &position) const
+    {
+        float t = glm::length(position - eye) / farPlane;
+        t = min(max(t, 0.0f), 1.0f);
+        return (unsigned int)(t * (float)((1u << RENDER_QUEUE_DEPTH_BITS) - 1));
+    }
+
+    // 기본값으로 채운 command (key/program/vao/draw 인자는 호출하는 쪽에서)
+    static RenderCommand Command()
+    {
+        RenderCommand command = RenderCommand(); // 0으로 초기화
+        command.mode = GL_TRIANGLES;
+        command.instanceCount = 1;
+        command.modelLocation = -1;
+        command.model = glm::mat4(1.0f);
+        command.color = glm::vec4(1.0f);
+        return command;
+    }
+    void Submit(const RenderCommand &command)
+    {
+        commands.push_back(command);
+    }
+    size_t Size() const { return commands.size(); }
+    void Clear() { commands.clear(); }
+
+    // 정렬 후 실행하고 비움
+    void Flush(RenderQueueStats &stats)
+    {
+        if (commands.empty())
+            return;
+        countUnsorted(stats);
+        auto start = chrono::steady_clock::now();
+        radixSort();
+        auto sorted = chrono::steady_clock::now();
+
+        // switch 횟수는 이 flush 안에서만 셈 (flush 사이의 중복은 GLState가 생략)
+        GLuint currentProgram = ~0u, currentVao = ~0u;
+        const Material *currentMaterial = nullptr;
+        GLuint bound[RENDER_QUEUE_MAX_UNITS];
+        for (unsigned int u = 0; u < RENDER_QUEUE_MAX_UNITS; u++)
+            bound[u] = ~0u;
+        GLuint activeUnit = ~0u;
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            const RenderCommand &command = commands[order[i]];
+            bool programChanged = command.program != currentProgram;
+            if (programChanged)
+            {
+                GLState::UseProgram(command.program);
+                currentProgram = command.program;
+                stats.programSwitches++;
+            }
+            if (command.vao != currentVao)
+            {
+                GLState::BindVertexArray(command.vao);
+                currentVao = command.vao;
+                stats.vaoSwitches++;
+            }
+            if (command.material)
+            {
+                // sampler -> 유닛 연결은 program마다 따로라서 program이 바뀌어도 다시 설정
+                const vector<Material::Slot> &slots = command.material->Slots();
+                const vector<GLint> *samplers = nullptr;
+                if (programChanged || command.material != currentMaterial)
+                    samplers = &command.material->Resolve(command.program).samplers;
+                for (unsigned int u = 0; u < slots.size() && u < RENDER_QUEUE_MAX_UNITS; u++)
+                {
+                    if (samplers && (*samplers)[u] >= 0)
+                    {
+                        glUniform1i((*samplers)[u], (GLint)u);
+                        UniformTable::Forget(command.program, (*samplers)[u]);
+                    }
+                    if (bound[u] != slots[u].texture)
+                    {
+                        if (activeUnit != u)
+                        {
+                            GLState::ActiveTexture(GL_TEXTURE0 + u);
+                            activeUnit = u;
+                        }
+                        GLState::BindTexture(GL_TEXTURE_2D, slots[u].texture);
+                        bound[u] = slots[u].texture;
+                        stats.textureBinds++;
+                    }
+                }
+                currentMaterial = command.material;
+            }
+            else if (command.texture != 0 && bound[0] != command.texture)
+            {
+                if (activeUnit != 0)
+                {
+                    GLState::ActiveTexture(GL_TEXTURE0);
+                    activeUnit = 0;
+                }
+                GLState::BindTexture(GL_TEXTURE_2D, command.texture);
+                bound[0] = command.texture;
+                stats.textureBinds++;
+            }
+
+            // Shader의 uniform 표가 기억한 값은 버림 (다음 setMat4("model")이 생략되지 않게)
+            if (command.modelLocation >= 0)
+            {
+                glUniformMatrix4fv(command.modelLocation, 1, GL_FALSE, &command.model[0][0]);
+                UniformTable::Forget(command.program, command.modelLocation);
+            }
+            if (command.uniforms)
+                command.uniforms(command);
+
+            if (command.indexType == 0)
+            {
+                if (command.instanceCount > 1)
+                    glDrawArraysInstanced(command.mode, command.first, command.count, command.instanceCount);
+                else
+                    glDrawArrays(command.mode, command.first, command.count);
+            }
+            else
+            {
+                if (command.instanceCount > 1)
+                    glDrawElementsInstanced(command.mode, command.count, command.indexType, command.indexOffset, command.instanceCount);
+                else
+                    glDrawElements(command.mode, command.count, command.indexType, command.indexOffset);
+            }
+        }
+        GLState::BindVertexArray(0);
+        GLState::ActiveTexture(GL_TEXTURE0);
+
+        stats.commands += (unsigned int)commands.size();
+        stats.sortMs += chrono::duration<double, milli>(sorted - start).count();
+        stats.submitMs += chrono::duration<double, milli>(chrono::steady_clock::now() - sorted).count();
+        commands.clear();
+    }
+
+private:
+    vector<RenderCommand> commands;
+    vector<unsigned int> order, orderTemp;
+    vector<uint64_t> keys, keysTemp;
+    glm::vec3 eye;
+    float farPlane;
+
+    // 제출 순서 그대로 실행했다면 바뀌었을 상태 수
+    void countUnsorted(RenderQueueStats &stats) const
+    {
+        GLuint program = ~0u, vao = ~0u;
+        GLuint bound[RENDER_QUEUE_MAX_UNITS];
+        for (unsigned int u = 0; u < RENDER_QUEUE_MAX_UNITS; u++)
+            bound[u] = ~0u;
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            const RenderCommand &command = commands[i];
+            stats.unsortedProgramSwitches += command.program != program ? 1 : 0;
+            stats.unsortedVaoSwitches += command.vao != vao ? 1 : 0;
+            program = command.program;
+            vao = command.vao;
+            if (command.material)
+            {
+                const vector<Material::Slot> &slots = command.material->Slots();
+                for (unsigned int u = 0; u < slots.size() && u < RENDER_QUEUE_MAX_UNITS; u++)
+                    if (bound[u] != slots[u].texture)
+                    {
+                        bound[u] = slots[u].texture;
+                        stats.unsortedTextureBinds++;
+                    }
+            }
+            else if (command.texture != 0 && bound[0] != command.texture)
+            {
+                bound[0] = command.texture;
+                stats.unsortedTextureBinds++;
+            }
+        }
+    }
+    // 8bit LSD radix sort (stable), 모든 키에서 같은 byte는 건너뜀
+    void radixSort()
+    {
+        size_t count = commands.size();
+        keys.resize(count);
+        order.resize(count);
+        keysTemp.resize(count);
+        orderTemp.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = commands[i].key;
+            order[i] = (unsigned int)i;
+        }
+        for (unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            unsigned int histogram[256] = { 0 };
+            for (size_t i = 0; i < count; i++)
+                histogram[(keys[i] >> shift) & 0xFF]++;
+            if (histogram[(keys[0] >> shift) & 0xFF] == count)
+                continue;
+            unsigned int offset = 0;
+            for (unsigned int b = 0; b < 256; b++)
+            {
+                unsigned int n = histogram[b];
+                histogram[b] = offset;
+                offset += n;
+            }
+            for (size_t i = 0; i < count; i++)
+            {
+                unsigned int slot = histogram[(keys[i] >> shift) & 0xFF]++;
+                keysTemp[slot] = keys[i];
+                orderTemp[slot] = order[i];
+            }
+            keys.swap(keysTemp);
+            order.swap(orderTemp);
+        }
+    }
+};
+
+#endif
@@ -5,9 +5,13 @@
 #include <glm/glm.hpp>
 
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <memory>
+
+#include "gl_state.h"
+#include "shader_build.h"
+#include "shader_source.h"
+#include "uniform_table.h"
 
 class Shader
 {
@@ -16,148 +20,162 @@ public:
     unsigned int ID;
 
     // 생성자는 shader를 읽고 생성
-    Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath = nullptr)
+    // defines는 #version 바로 뒤에 들어가고 #include "file"은 읽을 때 펼쳐짐 (shader_source.h)
+    Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath = nullptr,
+           const ShaderDefines &defines = ShaderDefines())
+        : Shader(start(vertexPath, fragmentPath, geometryPath, defines))
     {
-        //파일경로를 통해 vertex/fragment shader 소스코드를 검색함
-        std::string vertexCode;
-        std::string fragmentCode;
-        std::string geometryCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        std::ifstream gShaderFile;
-        //ifstream 객체들이 예외를 던질 수 있게 처리
-        vShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        fShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        gShaderFile.exceptions (std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            //파일 열기
-            vShaderFile.open(vertexPath);
-            fShaderFile.open(fragmentPath);
-            std::stringstream vShaderStream, fShaderStream;
-            //stream에 파일의 버퍼 내용 읽기
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            //파일 핸들러 닫기
-            vShaderFile.close();
-            fShaderFile.close();
-            //stream을 string으로 변환
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-            //geometry shader가 있는경우만 열고 읽기
-            if(geometryPath != nullptr)
-            {
-                gShaderFile.open(geometryPath);
-                std::stringstream gShaderStream;
-                gShaderStream << gShaderFile.rdbuf();
-                gShaderFile.close();
-                geometryCode = gShaderStream.str();
-            }
-        }
-        catch(std::ifstream::failure e)
-        {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << e.what() << std::endl;
-        }
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
-        
-        //shader 컴파일
-        unsigned int vertex, fragment;
-        //vertex       
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
-        //fragment
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
-        //geometry
-        unsigned int geometry;
-        if(geometryPath != nullptr)
-        {
-            const char * gShaderCode = geometryCode.c_str();
-            geometry = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(geometry, 1, &gShaderCode, NULL);
-            glCompileShader(geometry);
-            checkCompileErrors(geometry, "GEOMETRY");
-        }
-        
-        //Shader Program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        if(geometryPath != nullptr)
-            glAttachShader(ID, geometry);
-        glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
-        
-        //필요없는 shader 삭제
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
-        if(geometryPath != nullptr)
-            glDeleteShader(geometry);
+        wait();
+    }
+    // compile/link를 요청만 하고 바로 돌아옴, 결과 확인은 처음 쓸 때 (use, uniform 설정)
+    // 여러 program을 먼저 Async로 만들고 모델/텍스처를 읽으면 그동안 드라이버가 compile함
+    static Shader Async(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath = nullptr,
+                        const ShaderDefines &defines = ShaderDefines())
+    {
+        return Shader(start(vertexPath, fragmentPath, geometryPath, defines));
+    }
+    // 기다리지 않고 link가 끝났는지 (KHR_parallel_shader_compile가 없으면 항상 true)
+    bool ready() const
+    {
+        return build->Ready();
+    }
+    // compile/link 결과 확인 (아직이면 기다림), use나 uniform 설정 때 자동으로 불림
+    void wait() const
+    {
+        if(!build->Finished())
+            build->Finish([](GLuint object, const char* type) { checkCompileErrors(object, type); });
     }
     // shader를 활성화하고 사용
     void use()
     {
-        glUseProgram(ID);
+        wait();
+        GLState::UseProgram(ID);
     }
     // Uniform 유틸리티 함수들
+    // 이름은 link 때 만든 표에서 찾고 (glGetUniformLocation 없음), 마지막 값과 같으면 올리지 않음
     void setBool(const std::string &name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        setInt(getUniform(name), (int)value);
     }
     void setInt(const std::string &name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        setInt(getUniform(name), value);
     } 
     void setFloat(const std::string &name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        setFloat(getUniform(name), value);
     }
     void setVec2(const std::string &name, const glm::vec2 &value) const
     { 
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setVec2(getUniform(name), value);
     }
     void setVec2(const std::string &name, float x, float y) const
     { 
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y); 
+        setVec2(getUniform(name), glm::vec2(x, y));
     }
      void setVec3(const std::string &name, const glm::vec3 &value) const
     { 
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setVec3(getUniform(name), value);
     }
     void setVec3(const std::string &name, float x, float y, float z) const
     { 
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z); 
+        setVec3(getUniform(name), glm::vec3(x, y, z));
     }
      void setVec4(const std::string &name, const glm::vec4 &value) const
     { 
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        setVec4(getUniform(name), value);
     }
     void setVec4(const std::string &name, float x, float y, float z, float w) 
     { 
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w); 
+        setVec4(getUniform(name), glm::vec4(x, y, z, w));
     }
     void setMat2(const std::string &name, const glm::mat2 &mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat2(getUniform(name), mat);
     }
     void setMat3(const std::string &name, const glm::mat3 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat3(getUniform(name), mat);
     }
     void setMat4(const std::string &name, const glm::mat4 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        setMat4(getUniform(name), mat);
+    }
+
+    // 매 프레임 여러 번 쓰는 uniform은 미리 handle을 받아두면 이름 hash도 생략
+    UniformHandle getUniform(const std::string &name) const
+    {
+        return table().Find(name.c_str());
+    }
+    void setInt(UniformHandle uniform, int value) const
+    {
+        if (table().Changed(uniform, &value, sizeof(value)))
+            glUniform1i(table().Location(uniform), value);
+    }
+    void setFloat(UniformHandle uniform, float value) const
+    {
+        if (table().Changed(uniform, &value, sizeof(value)))
+            glUniform1f(table().Location(uniform), value);
+    }
+    void setVec2(UniformHandle uniform, const glm::vec2 &value) const
+    {
+        if (table().Changed(uniform, &value[0], sizeof(value)))
+            glUniform2fv(table().Location(uniform), 1, &value[0]);
+    }
+    void setVec3(UniformHandle uniform, const glm::vec3 &value) const
+    {
+        if (table().Changed(uniform, &value[0], sizeof(value)))
+            glUniform3fv(table().Location(uniform), 1, &value[0]);
+    }
+    void setVec4(UniformHandle uniform, const glm::vec4 &value) const
+    {
+        if (table().Changed(uniform, &value[0], sizeof(value)))
+            glUniform4fv(table().Location(uniform), 1, &value[0]);
+    }
+    void setMat2(UniformHandle uniform, const glm::mat2 &mat) const
+    {
+        if (table().Changed(uniform, &mat[0][0], sizeof(mat)))
+            glUniformMatrix2fv(table().Location(uniform), 1, GL_FALSE, &mat[0][0]);
+    }
+    void setMat3(UniformHandle uniform, const glm::mat3 &mat) const
+    {
+        if (table().Changed(uniform, &mat[0][0], sizeof(mat)))
+            glUniformMatrix3fv(table().Location(uniform), 1, GL_FALSE, &mat[0][0]);
+    }
+    void setMat4(UniformHandle uniform, const glm::mat4 &mat) const
+    {
+        if (table().Changed(uniform, &mat[0][0], sizeof(mat)))
+            glUniformMatrix4fv(table().Location(uniform), 1, GL_FALSE, &mat[0][0]);
     }
 
 private:
+    std::shared_ptr<ShaderBuild> build;   // 복사본끼리 공유 (uniform 표 포함)
+
+    explicit Shader(std::shared_ptr<ShaderBuild> build) : ID(build->program), build(build) { }
+
+    static std::shared_ptr<ShaderBuild> start(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath,
+                                              const ShaderDefines &defines)
+    {
+        //파일경로를 통해 vertex/fragment shader 소스코드를 검색함
+        std::string vertexCode = ShaderSource::Load(vertexPath, defines);
+        std::string fragmentCode = ShaderSource::Load(fragmentPath, defines);
+        std::string geometryCode;
+        //geometry shader가 있는경우만 열고 읽기
+        if(geometryPath != nullptr)
+            geometryCode = ShaderSource::Load(geometryPath, defines);
+        //같은 source + 같은 드라이버로 전에 link한 binary가 있으면 compile 없이 복원 (shader_cache.h)
+        const char* sources[3] = { vertexCode.c_str(), fragmentCode.c_str(), geometryPath != nullptr ? geometryCode.c_str() : nullptr };
+        return ShaderBuild::Start(sources, defines.Str());
+    }
+    UniformTable &table() const
+    {
+        wait();
+        return *build->uniforms;
+    }
+
     // 에러확인 함수
     // ------------------------------------------------------------------------
-    void checkCompileErrors(GLuint shader, std::string type)
+    static void checkCompileErrors(GLuint shader, std::string type)
     {
         GLint success;
         GLchar infoLog[1024];
@@ -0,0 +1,138 @@
+#ifndef SHADER_BUILD_H
+#define SHADER_BUILD_H
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "shader_cache.h"
+#include "uniform_table.h"
+
+// KHR_parallel_shader_compile (ARB 버전도 같은 값), GLAD에는 extension이 없어서 직접 정의
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+// compile/link를 요청만 하고 결과는 아직 확인하지 않은 program
+// GL_COMPILE_STATUS/GL_LINK_STATUS를 물으면 드라이버가 그 program이 끝날 때까지 기다리므로
+// 모든 program을 먼저 요청하고 처음 쓸 때(Finish) 한꺼번에 확인함 -> 그동안 드라이버는 뒤에서 compile
+// Shader 복사본끼리 공유 (uniform 표도 여기 있음)
+class ShaderBuild
+{
+public:
+    GLuint program;
+    std::shared_ptr<UniformTable> uniforms;   // Finish 후에 생김
+
+    // stage 순서는 vertex, fragment, geometry (없는 stage는 nullptr)
+    // defines는 cache key용 (source에는 이미 들어가 있음)
+    static std::shared_ptr<ShaderBuild> Start(const char *const sources[3], const std::string &defines)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<ShaderBuild> build = std::make_shared<ShaderBuild>();
+        build->key = ShaderCache::Key(sources, 3, defines);
+        build->program = glCreateProgram();
+        SharedShaderCacheStats().programs++;
+        build->fromCache = ShaderCache::Load(build->program, build->key);
+        if (!build->fromCache)
+        {
+            const GLenum types[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                if (sources[i] == nullptr)
+                    continue;
+                build->shaders[i] = glCreateShader(types[i]);
+                glShaderSource(build->shaders[i], 1, &sources[i], NULL);
+                glCompileShader(build->shaders[i]);
+                glAttachShader(build->program, build->shaders[i]);
+            }
+            ShaderCache::PrepareLink(build->program);
+            glLinkProgram(build->program);
+        }
+        build->blockingMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return build;
+    }
+
+    // KHR_parallel_shader_compile가 있으면 기다리지 않고 끝났는지 확인, 없으면 알 수 없으니 true (Finish가 기다림)
+    bool Ready() const
+    {
+        if (uniforms || fromCache || !Parallel())
+            return true;
+        GLint done = 0;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+        return done != 0;
+    }
+    bool Finished() const { return (bool)uniforms; }
+
+    // 결과 확인 (에러 로그, binary 저장, shader 삭제, uniform 표), check는 Shader마다 다른 에러 출력
+    template <typename CheckErrors>
+    void Finish(CheckErrors check)
+    {
+        if (uniforms)
+            return;
+        auto start = std::chrono::steady_clock::now();
+        ShaderCacheStats &stats = SharedShaderCacheStats();
+        if (Parallel() && !fromCache && Ready())
+            stats.readyAtUse++;
+        if (!fromCache)
+        {
+            const char *names[3] = { "VERTEX", "FRAGMENT", "GEOMETRY" };
+            for (unsigned int i = 0; i < 3; i++)
+                if (shaders[i])
+                    check(shaders[i], names[i]);
+            check(program, "PROGRAM");
+            ShaderCache::Save(program, key);
+            for (unsigned int i = 0; i < 3; i++)
+                if (shaders[i])
+                    glDeleteShader(shaders[i]);
+        }
+        // binary로 복원한 경우에도 block binding은 다시 연결해야 함
+        uniforms = std::make_shared<UniformTable>(program);
+        blockingMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (fromCache)
+        {
+            stats.hits++;
+            stats.hitMs += blockingMs;
+        }
+        else
+        {
+            stats.compiled++;
+            stats.compileMs += blockingMs;
+        }
+    }
+
+    // 한 번만 확인
+    static bool Parallel()
+    {
+        static int parallel = -1;
+        if (parallel < 0)
+        {
+            parallel = 0;
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count && !parallel; i++)
+            {
+                const char *name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+                if (name && (strcmp(name, "GL_KHR_parallel_shader_compile") == 0 || strcmp(name, "GL_ARB_parallel_shader_compile") == 0))
+                    parallel = 1;
+            }
+        }
+        return parallel == 1;
+    }
+
+    ShaderBuild() : program(0), key(0), fromCache(false), blockingMs(0.0)
+    {
+        shaders[0] = shaders[1] = shaders[2] = 0;
+    }
+
+private:
+    GLuint shaders[3];
+    uint64_t key;
+    bool fromCache;
+    double blockingMs;   // Start + Finish에서 실제로 멈춰 있던 시간
+};
+
+#endif
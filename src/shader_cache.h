@@ -0,0 +1,197 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <glad/glad.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// link된 program을 glGetProgramBinary로 저장해 두고 다음 실행에서 glProgramBinary로 바로 복원
+// 파일은 SHADER_CACHE_DIR/<key>.progbin, key는 source 전체 + define + driver 문자열의 hash
+// 드라이버가 바뀌었거나 binary를 거부하면 source compile로 돌아가고 다시 저장
+const char SHADER_CACHE_DIR[] = "shader_cache";
+const char SHADER_CACHE_MAGIC[4] = { 'P', 'R', 'O', 'G' };
+const uint32_t SHADER_CACHE_VERSION = 1;
+
+struct ShaderCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;   // glGetProgramBinary가 알려준 binary format
+    uint32_t length;
+};
+
+// 실행 전체 누적, 시간은 program을 만들면서 CPU가 실제로 멈춰 있던 시간 (shader_build.h)
+struct ShaderCacheStats
+{
+    unsigned int programs = 0;
+    unsigned int hits = 0;       // binary로 복원
+    unsigned int compiled = 0;   // source compile (캐시 없음, 오래됨, 거부됨)
+    unsigned int rejected = 0;   // 파일은 있었지만 드라이버가 거부
+    unsigned int readyAtUse = 0; // 처음 쓸 때 이미 link가 끝나 있던 program (parallel compile)
+    double hitMs = 0.0;
+    double compileMs = 0.0;
+
+    void Print() const
+    {
+        std::cout << "SHADER::CACHE:: " << programs << " programs, " << hits << " from binary (" << hitMs << " ms), " << compiled
+                  << " compiled (" << compileMs << " ms" << (rejected ? ", " + std::to_string(rejected) + " rejected" : std::string())
+                  << (readyAtUse ? ", " + std::to_string(readyAtUse) + " already linked at first use" : std::string())
+                  << ") | total " << hitMs + compileMs << " ms" << std::endl;
+    }
+};
+inline ShaderCacheStats &SharedShaderCacheStats()
+{
+    static ShaderCacheStats stats;
+    return stats;
+}
+
+class ShaderCache
+{
+public:
+    // GL 4.1 이상이고 binary format이 하나라도 있어야 사용
+    static bool Supported()
+    {
+        static int supported = -1;
+        if (supported < 0)
+        {
+            GLint formats = 0;
+            if (GLAD_GL_VERSION_4_1)
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            supported = formats > 0 ? 1 : 0;
+        }
+        return supported == 1;
+    }
+
+    // sources는 stage 순서대로 (없는 stage는 nullptr)
+    static uint64_t Key(const char *const *sources, unsigned int count, const std::string &defines)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            hash = hashBytes(hash, sources[i] ? sources[i] : "", sources[i] ? strlen(sources[i]) : 0);
+            hash = hashBytes(hash, "\0", 1); // stage 경계
+        }
+        hash = hashBytes(hash, defines.data(), defines.size());
+        const std::string &driver = driverString();
+        return hashBytes(hash, driver.data(), driver.size());
+    }
+
+    // link 전에 호출 (binary를 꺼낼 수 있게)
+    static void PrepareLink(GLuint program)
+    {
+        if (Supported())
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    // 성공하면 program은 link된 상태
+    static bool Load(GLuint program, uint64_t key)
+    {
+        if (!Supported())
+            return false;
+        std::ifstream in(path(key).c_str(), std::ios::binary);
+        if (!in)
+            return false;
+        ShaderCacheHeader header;
+        if (!in.read((char*)&header, sizeof(header)) || memcmp(header.magic, SHADER_CACHE_MAGIC, 4) != 0 ||
+            header.version != SHADER_CACHE_VERSION || header.key != key || header.length == 0)
+            return false;
+        std::vector<char> binary(header.length);
+        if (!in.read(binary.data(), binary.size()))
+            return false;
+        glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            SharedShaderCacheStats().rejected++;
+            std::cout << "SHADER::CACHE:: driver rejected " << path(key) << ", compiling from source" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    static bool Save(GLuint program, uint64_t key)
+    {
+        if (!Supported())
+            return false;
+        GLint linked = 0, length = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (!linked || length <= 0)
+            return false;
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+            return false;
+        makeDirectory();
+        std::ofstream out(path(key).c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        ShaderCacheHeader header;
+        memcpy(header.magic, SHADER_CACHE_MAGIC, 4);
+        header.version = SHADER_CACHE_VERSION;
+        header.key = key;
+        header.format = format;
+        header.length = (uint32_t)written;
+        out.write((const char*)&header, sizeof(header));
+        out.write(binary.data(), written);
+        return (bool)out;
+    }
+
+    static std::string path(uint64_t key)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+        return std::string(SHADER_CACHE_DIR) + "/" + name + ".progbin";
+    }
+
+private:
+    static uint64_t hashBytes(uint64_t hash, const char *data, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ (unsigned char)data[i]) * 1099511628211ull;
+        return hash;
+    }
+    // 같은 source라도 드라이버가 다르면 binary는 호환되지 않음
+    static const std::string &driverString()
+    {
+        static std::string driver;
+        if (driver.empty())
+        {
+            const GLenum names[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                const GLubyte *value = glGetString(names[i]);
+                driver += value ? (const char*)value : "?";
+                driver += '|';
+            }
+        }
+        return driver;
+    }
+    static void makeDirectory()
+    {
+#ifdef _WIN32
+        _mkdir(SHADER_CACHE_DIR);
+#else
+        mkdir(SHADER_CACHE_DIR, 0755);
+#endif
+    }
+};
+
+#endif
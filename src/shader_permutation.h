@@ -0,0 +1,69 @@
+#ifndef SHADER_PERMUTATION_H
+#define SHADER_PERMUTATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shader_source.h"
+
+// 기능 조합(bitmask)마다 따로 compile한 shader
+// 런타임 uniform bool 분기 대신 켜진 기능만 #define으로 넣어서 분기 없는 variant를 만듦
+// variant는 처음 Get할 때 compile (실제로 쓰는 조합만), program binary cache가 있으면 두 번째 실행부터는 복원만 함
+// ShaderType은 shader.h / 19_shader.h의 Shader 어느 쪽이든 (둘은 같이 include할 수 없어서 template)
+template <typename ShaderType>
+class ShaderPermutations
+{
+public:
+    typedef std::function<ShaderType(const ShaderDefines &)> Builder;
+
+    // features[i]가 mask의 i번째 bit, base는 모든 variant에 공통으로 들어가는 define
+    ShaderPermutations(const std::string &name, const std::vector<std::string> &features, Builder build,
+                       const ShaderDefines &base = ShaderDefines())
+        : name(name), features(features), build(build), base(base), totalMs(0.0)
+    {
+    }
+
+    ShaderType &Get(uint32_t mask)
+    {
+        typename std::unordered_map<uint32_t, ShaderType>::iterator it = variants.find(mask);
+        if (it != variants.end())
+            return it->second;
+        ShaderDefines defines = Defines(mask);
+        auto start = std::chrono::steady_clock::now();
+        ShaderType shader = build(defines);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        totalMs += ms;
+        std::cout << "SHADER::VARIANT:: " << name << " [" << defines.Label() << "] built in " << ms << " ms ("
+                  << variants.size() + 1 << " of " << (1u << features.size()) << " variants)" << std::endl;
+        return variants.emplace(mask, shader).first->second;
+    }
+    ShaderDefines Defines(uint32_t mask) const
+    {
+        ShaderDefines defines = base;
+        for (size_t i = 0; i < features.size(); i++)
+            if (mask & (1u << i))
+                defines.Enable(features[i]);
+        return defines;
+    }
+
+    unsigned int Variants() const { return (unsigned int)variants.size(); }
+    void Print() const
+    {
+        std::cout << "SHADER::VARIANT:: " << name << " " << variants.size() << " variants built, " << totalMs << " ms total" << std::endl;
+    }
+
+private:
+    std::string name;
+    std::vector<std::string> features;
+    Builder build;
+    ShaderDefines base;
+    std::unordered_map<uint32_t, ShaderType> variants;
+    double totalMs;
+};
+
+#endif
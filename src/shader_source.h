@@ -0,0 +1,152 @@
+#ifndef SHADER_SOURCE_H
+#define SHADER_SOURCE_H
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+// shader에 넣을 #define 목록 (이름 순으로 정렬돼서 같은 조합이면 같은 문자열 -> 같은 binary cache key)
+// shader 쪽은 기본값을 #ifndef로 두면 define 없이 읽어도 그대로 동작함
+//   #ifndef KERNEL_SIZE
+//   #define KERNEL_SIZE 64
+//   #endif
+class ShaderDefines
+{
+public:
+    ShaderDefines &Set(const std::string &name, const std::string &value)
+    {
+        values[name] = value;
+        return *this;
+    }
+    ShaderDefines &Set(const std::string &name, int value)
+    {
+        return Set(name, std::to_string(value));
+    }
+    // GLSL에서 float로 읽히도록 항상 소수점을 붙임
+    ShaderDefines &Set(const std::string &name, float value)
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "%.9g", value);
+        std::string literal(text);
+        if (literal.find_first_of(".en") == std::string::npos)
+            literal += ".0";
+        return Set(name, literal);
+    }
+    ShaderDefines &Enable(const std::string &name) { return Set(name, std::string("1")); }
+    ShaderDefines &Merge(const ShaderDefines &other)
+    {
+        for (std::map<std::string, std::string>::const_iterator it = other.values.begin(); it != other.values.end(); ++it)
+            values[it->first] = it->second;
+        return *this;
+    }
+
+    bool Empty() const { return values.empty(); }
+    std::string Str() const
+    {
+        std::string text;
+        for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it)
+            text += "#define " + it->first + " " + it->second + "\n";
+        return text;
+    }
+    // 로그용 "A B=2"
+    std::string Label() const
+    {
+        std::string text;
+        for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it)
+            text += (text.empty() ? "" : " ") + it->first + (it->second == "1" ? std::string() : "=" + it->second);
+        return text.empty() ? "-" : text;
+    }
+
+private:
+    std::map<std::string, std::string> values;
+};
+
+// shader 파일 읽기 + #include "file" 펼치기 + #version 바로 뒤에 define 삽입
+// include 경로는 include한 파일 기준, 같은 파일은 한 번만 들어감 (include guard 불필요)
+// 펼친 파일 앞뒤에 #line을 넣어서 에러 로그가 "파일 번호(줄)"로 나옴 (번호는 처음 읽은 순서, Load한 파일이 0)
+class ShaderSource
+{
+public:
+    static std::string Load(const std::string &path, const ShaderDefines &defines = ShaderDefines())
+    {
+        std::set<std::string> included;
+        std::string source;
+        if (!append(path, included, source, 0))
+            return std::string();
+        return inject(source, defines);
+    }
+
+private:
+    static bool append(const std::string &path, std::set<std::string> &included, std::string &out, int depth)
+    {
+        if (depth > 16)
+        {
+            std::cout << "ERROR::SHADER::INCLUDE too deep at " << path << std::endl;
+            return false;
+        }
+        if (!included.insert(path).second)
+            return true;
+        std::string index = std::to_string(included.size() - 1);
+        std::ifstream file(path.c_str());
+        if (!file)
+        {
+            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ " << path << std::endl;
+            return false;
+        }
+        std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+        std::string line;
+        int number = 0;
+        if (depth > 0)
+            out += "#line 1 " + index + "\n";
+        while (std::getline(file, line))
+        {
+            number++;
+            std::string name;
+            if (includeName(line, name))
+            {
+                if (!append(directory + name, included, out, depth + 1))
+                    return false;
+                out += "#line " + std::to_string(number + 1) + " " + index + "\n";
+                continue;
+            }
+            out += line;
+            out += '\n';
+        }
+        return true;
+    }
+    // `#include "name"` 이면 name을 돌려줌
+    static bool includeName(const std::string &line, std::string &name)
+    {
+        size_t i = line.find_first_not_of(" \t");
+        if (i == std::string::npos || line[i] != '#')
+            return false;
+        i = line.find_first_not_of(" \t", i + 1);
+        if (i == std::string::npos || line.compare(i, 7, "include") != 0)
+            return false;
+        size_t open = line.find('"', i + 7);
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos)
+            return false;
+        name = line.substr(open + 1, close - open - 1);
+        return true;
+    }
+    // #version은 항상 첫 줄이어야 하므로 그 뒤에 넣고, 원래 줄 번호로 되돌림 (에러 로그 줄 번호 유지)
+    static std::string inject(const std::string &source, const ShaderDefines &defines)
+    {
+        if (defines.Empty())
+            return source;
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return defines.Str() + "#line 1\n" + source;
+        size_t end = source.find('\n', version);
+        if (end == std::string::npos)
+            return source + "\n" + defines.Str();
+        return source.substr(0, end + 1) + defines.Str() + "#line 2\n" + source.substr(end + 1);
+    }
+};
+
+#endif
@@ -0,0 +1,18 @@
+#version 460 core
+layout (location = 0) in vec4 aPos;       // unorm16, mesh AABB 기준
+layout (location = 2) in vec2 aTexCoords; // half float
+
+out vec2 TexCoords;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+void main()
+{
+    TexCoords = aTexCoords;    
+    gl_Position = projection * view * model * vec4(positionOffset + aPos.xyz * positionScale, 1.0);
+}
\ No newline at end of file
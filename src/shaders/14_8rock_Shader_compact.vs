@@ -0,0 +1,18 @@
+#version 460 core
+layout (location = 0) in vec4 aPos;       // unorm16, mesh AABB 기준
+layout (location = 2) in vec2 aTexCoords; // half float
+layout (location = 3) in mat4 instanceMatrix;
+
+out vec2 TexCoords;
+
+uniform mat4 projection;
+uniform mat4 view;
+
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+void main()
+{
+    gl_Position = projection * view * instanceMatrix * vec4(positionOffset + aPos.xyz * positionScale, 1.0); 
+    TexCoords = aTexCoords;
+}
\ No newline at end of file
@@ -7,19 +7,27 @@ uniform sampler2D gPosition;
 uniform sampler2D gNormal;
 uniform sampler2D texNoise;
 
-uniform vec3 samples[64];
+// kernel 크기와 noise 배율은 C++에서 define으로 넣어줌 (상수라 loop가 펼쳐짐)
+#ifndef KERNEL_SIZE
+#define KERNEL_SIZE 64
+#endif
+#ifndef NOISE_SCALE
+#define NOISE_SCALE vec2(800.0/4.0, 600.0/4.0)
+#endif
+
+uniform vec3 samples[KERNEL_SIZE];
 
 uniform float power;
 
 // parameters (you'd probably want to use them as uniforms to more easily tweak the effect)
-int kernelSize = 64;
-float radius = 0.5;
-float bias = 0.025;
+const int kernelSize = KERNEL_SIZE;
+const float radius = 0.5;
+const float bias = 0.025;
 
 // tile noise texture over screen based on screen dimensions divided by noise size
-const vec2 noiseScale = vec2(800.0/4.0, 600.0/4.0); 
+const vec2 noiseScale = NOISE_SCALE; 
 
-uniform mat4 projection;
+#include "frame_camera.glsl"
 
 void main()
 {
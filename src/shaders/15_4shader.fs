@@ -14,7 +14,11 @@ uniform vec3 lightPos;
 uniform vec3 viewPos;
 
 uniform float far_plane;
-uniform bool shadows;
+
+// 그림자 on/off는 variant로 compile (15_4_Point_Shadows.cpp의 ShaderPermutations)
+#ifndef SHADOWS
+#define SHADOWS 0
+#endif
 
 vec3 gridSamplingDisk[20] = vec3[]
 (
@@ -59,7 +63,7 @@ float ShadowCalculation(vec3 fragPos)
     // shadow /= (samples * samples * samples);
     float shadow = 0.0;
     float bias = 0.15;
-    int samples = 20;
+    const int samples = 20;
     float viewDistance = length(viewPos - fragPos);
     float diskRadius = (1.0 + (viewDistance / far_plane)) / 25.0;
     for(int i = 0; i < samples; ++i)
@@ -97,7 +101,11 @@ void main()
     spec = pow(max(dot(normal, halfwayDir), 0.0), 64.0);
     vec3 specular = spec * lightColor;    
     // calculate shadow
-    float shadow = shadows ? ShadowCalculation(fs_in.FragPos) : 0.0;                      
+#if SHADOWS
+    float shadow = ShadowCalculation(fs_in.FragPos);
+#else
+    float shadow = 0.0;
+#endif
     vec3 lighting = (ambient + (1.0 - shadow) * (diffuse + specular)) * color;    
     
     FragColor = vec4(lighting, 1.0);
@@ -4,27 +4,28 @@ out vec4 FragColor;
 in vec2 TexCoords;
 
 uniform sampler2D hdrBuffer;
-uniform bool hdr;
 uniform float exposure;
 
+// tone mapping on/off는 variant로 compile (15_7_HDR.cpp의 ShaderPermutations)
+#ifndef HDR
+#define HDR 0
+#endif
+
 void main()
 {             
     const float gamma = 2.2;
     vec3 hdrColor = texture(hdrBuffer, TexCoords).rgb;
-    if(hdr)
-    {
-        // reinhard
-        //vec3 result = hdrColor / (hdrColor + vec3(1.0));
-        // exposure
-        vec3 result = vec3(1.0) - exp(-hdrColor * exposure);
-        // also gamma correct while we're at it       
-        result = pow(result, vec3(1.0 / gamma));
-        FragColor = vec4(result, 1.0);
-    }
-    else
-    {
-        vec3 result = pow(hdrColor, vec3(1.0 / gamma));
-        //vec3 result = texture(hdrBuffer, TexCoords).rgb;
-        FragColor = vec4(result, 1.0);
-    }
+#if HDR
+    // reinhard
+    //vec3 result = hdrColor / (hdrColor + vec3(1.0));
+    // exposure
+    vec3 result = vec3(1.0) - exp(-hdrColor * exposure);
+    // also gamma correct while we're at it       
+    result = pow(result, vec3(1.0 / gamma));
+    FragColor = vec4(result, 1.0);
+#else
+    vec3 result = pow(hdrColor, vec3(1.0 / gamma));
+    //vec3 result = texture(hdrBuffer, TexCoords).rgb;
+    FragColor = vec4(result, 1.0);
+#endif
 }  
\ No newline at end of file
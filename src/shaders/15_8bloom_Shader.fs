@@ -5,16 +5,21 @@ in vec2 TexCoords;
 
 uniform sampler2D scene;
 uniform sampler2D bloomBlur;
-uniform bool bloom;
 uniform float exposure;
 
+// bloom on/off는 variant로 compile (15_8_Blur.cpp의 ShaderPermutations)
+#ifndef BLOOM
+#define BLOOM 0
+#endif
+
 void main()
 {             
     const float gamma = 2.2;
     vec3 hdrColor = texture(scene, TexCoords).rgb;      
+#if BLOOM
     vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
-    if(bloom)
-        hdrColor += bloomColor; // additive blending
+    hdrColor += bloomColor; // additive blending
+#endif
     // tone mapping
     vec3 result = vec3(1.0) - exp(-hdrColor * exposure);
     // also gamma correct while we're at it       
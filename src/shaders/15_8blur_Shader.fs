@@ -5,28 +5,32 @@ in vec2 TexCoords;
 
 uniform sampler2D image;
 
-uniform bool horizontal;
-uniform float weight[5] = float[] (0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162);
+// 방향과 tap 수, weight는 compile 때 정해짐 (15_8_Blur.cpp의 ShaderPermutations)
+#ifndef HORIZONTAL
+#define HORIZONTAL 0
+#endif
+#ifndef BLUR_TAPS
+#define BLUR_TAPS 5
+#define BLUR_WEIGHTS 0.2270270270, 0.1945945946, 0.1216216216, 0.0540540541, 0.0162162162
+#endif
+const float weight[BLUR_TAPS] = float[] (BLUR_WEIGHTS);
 
 void main()
 {             
     vec2 tex_offset = 1.0 / textureSize(image, 0); // gets size of single texel
     vec3 result = texture(image, TexCoords).rgb * weight[0];
-    if(horizontal)
+#if HORIZONTAL
+    for(int i = 1; i < BLUR_TAPS; ++i)
     {
-        for(int i = 1; i < 5; ++i)
-        {
         result += texture(image, TexCoords + vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
         result += texture(image, TexCoords - vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-        }
     }
-    else
+#else
+    for(int i = 1; i < BLUR_TAPS; ++i)
     {
-        for(int i = 1; i < 5; ++i)
-        {
-            result += texture(image, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-            result += texture(image, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-        }
+        result += texture(image, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
+        result += texture(image, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
     }
+#endif
     FragColor = vec4(result, 1.0);
 }
\ No newline at end of file
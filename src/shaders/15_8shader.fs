@@ -8,12 +8,8 @@ in VS_OUT {
     vec2 TexCoords;
 } fs_in;
 
-struct Light {
-    vec3 Position;
-    vec3 Color;
-};
-
-uniform Light lights[4];
+// lights (개수는 실행 중에 정해짐, light_manager.h)
+#include "light_list.glsl"
 uniform sampler2D diffuseTexture;
 uniform vec3 viewPos;
 
@@ -26,14 +22,14 @@ void main()
     // lighting
     vec3 lighting = vec3(0.0);
     vec3 viewDir = normalize(viewPos - fs_in.FragPos);
-    for(int i = 0; i < 4; i++)
+    for(uint i = 0u; i < lightCount; i++)
     {
         // diffuse
-        vec3 lightDir = normalize(lights[i].Position - fs_in.FragPos);
+        vec3 lightDir = normalize(lightPositions[i].xyz - fs_in.FragPos);
         float diff = max(dot(lightDir, normal), 0.0);
-        vec3 result = lights[i].Color * diff * color;      
+        vec3 result = lightColors[i].rgb * diff * color;      
         // attenuation (use quadratic as we have gamma correction)
-        float distance = length(fs_in.FragPos - lights[i].Position);
+        float distance = length(fs_in.FragPos - lightPositions[i].xyz);
         result *= 1.0 / (distance * distance);
         lighting += result;
                 
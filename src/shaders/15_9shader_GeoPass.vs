@@ -8,8 +8,7 @@ out vec2 TexCoords;
 out vec3 Normal;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#include "frame_camera.glsl"
 
 void main()
 {
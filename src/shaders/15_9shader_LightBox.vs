@@ -3,8 +3,7 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+#include "frame_camera.glsl"
 uniform mat4 model;
 
 void main()
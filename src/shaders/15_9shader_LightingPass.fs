@@ -7,17 +7,8 @@ uniform sampler2D gPosition;
 uniform sampler2D gNormal;
 uniform sampler2D gAlbedoSpec;
 
-struct Light {
-    vec3 Position;
-    vec3 Color;
-    
-    float Linear;
-    float Quadratic;
-    float Radius;
-};
-const int NR_LIGHTS = 32;
-uniform Light lights[NR_LIGHTS];
-uniform vec3 viewPos;
+#include "light_list.glsl"
+#include "frame_camera.glsl"
 
 void main()
 {             
@@ -29,22 +20,24 @@ void main()
     
     // then calculate lighting as usual
     vec3 lighting  = Diffuse * 0.1; // hard-coded ambient component
-    vec3 viewDir  = normalize(viewPos - FragPos);
-    for(int i = 0; i < NR_LIGHTS; ++i)
+    vec3 viewDir  = normalize(viewPos.xyz - FragPos);
+    for(uint i = 0u; i < lightCount; ++i)
     {
         // calculate distance between light source and current fragment
-        float distance = length(lights[i].Position - FragPos);
-        if(distance < lights[i].Radius)
+        vec3 lightPos = lightPositions[i].xyz;
+        vec4 attenuationParams = lightAttenuations[i]; // linear, quadratic, radius
+        float distance = length(lightPos - FragPos);
+        if(distance < attenuationParams.z)
         {
             // diffuse
-            vec3 lightDir = normalize(lights[i].Position - FragPos);
-            vec3 diffuse = max(dot(Normal, lightDir), 0.0) * Diffuse * lights[i].Color;
+            vec3 lightDir = normalize(lightPos - FragPos);
+            vec3 diffuse = max(dot(Normal, lightDir), 0.0) * Diffuse * lightColors[i].rgb;
             // specular
             vec3 halfwayDir = normalize(lightDir + viewDir);  
             float spec = pow(max(dot(Normal, halfwayDir), 0.0), 16.0);
-            vec3 specular = lights[i].Color * spec * Specular;
+            vec3 specular = lightColors[i].rgb * spec * Specular;
             // attenuation
-            float attenuation = 1.0 / (1.0 + lights[i].Linear * distance + lights[i].Quadratic * distance * distance);
+            float attenuation = 1.0 / (1.0 + attenuationParams.x * distance + attenuationParams.y * distance * distance);
             diffuse *= attenuation;
             specular *= attenuation;
             lighting += diffuse + specular;
@@ -7,39 +7,39 @@ uniform vec2 offsets[9];
 uniform int edge_kernel[9];
 uniform float blur_kernel[9];
 
-uniform bool chaos;
-uniform bool confuse;
-uniform bool shake;
+#ifndef CHAOS
+#define CHAOS 0
+#endif
+#ifndef CONFUSE
+#define CONFUSE 0
+#endif
+#ifndef SHAKE
+#define SHAKE 0
+#endif
 
 
 void main()
 {
     color = vec4(0.0f);
-    vec3 sample1[9];
     // sample from texture offsets if using convolution matrix
-    if(chaos || shake)
-        for(int i = 0; i < 9; i++)
-            sample1[i] = vec3(texture(scene, TexCoords.st + offsets[i]));
+#if CHAOS || SHAKE
+    vec3 sample1[9];
+    for(int i = 0; i < 9; i++)
+        sample1[i] = vec3(texture(scene, TexCoords.st + offsets[i]));
+#endif
 
     // process effects
-    if (chaos)
-    {           
-        for(int i = 0; i < 9; i++)
-            color += vec4(sample1[i] * edge_kernel[i], 0.0f);
-        color.a = 1.0f;
-    }
-    else if (confuse)
-    {
-        color = vec4(1.0 - texture(scene, TexCoords).rgb, 1.0);
-    }
-    else if (shake)
-    {
-        for(int i = 0; i < 9; i++)
-            color += vec4(sample1[i] * blur_kernel[i], 0.0f);
-        color.a = 1.0f;
-    }
-    else
-    {
-        color =  texture(scene, TexCoords);
-    }
-}
+#if CHAOS
+    for(int i = 0; i < 9; i++)
+        color += vec4(sample1[i] * edge_kernel[i], 0.0f);
+    color.a = 1.0f;
+#elif CONFUSE
+    color = vec4(1.0 - texture(scene, TexCoords).rgb, 1.0);
+#elif SHAKE
+    for(int i = 0; i < 9; i++)
+        color += vec4(sample1[i] * blur_kernel[i], 0.0f);
+    color.a = 1.0f;
+#else
+    color =  texture(scene, TexCoords);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 5) in ivec4 aBoneIDs;
+layout (location = 6) in vec4 aWeights;
+
+out vec2 TexCoords;
+
+// animation.h의 ANIMATION_MAX_BONES를 define으로 넣어줌, 캐릭터마다 glBindBufferRange로 범위를 바꿈
+#ifndef MAX_BONES
+#define MAX_BONES 100
+#endif
+layout (std140) uniform Bones
+{
+    mat4 bones[MAX_BONES];
+};
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+    // bone이 없는 vertex(weight 합 0)는 bind pose 그대로
+    mat4 skin = mat4(1.0);
+    if (aWeights.x + aWeights.y + aWeights.z + aWeights.w > 0.0)
+        skin = bones[aBoneIDs.x] * aWeights.x + bones[aBoneIDs.y] * aWeights.y
+             + bones[aBoneIDs.z] * aWeights.z + bones[aBoneIDs.w] * aWeights.w;
+    TexCoords = aTexCoords;
+    gl_Position = projection * view * model * skin * vec4(aPos, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+// frame_uniforms.h의 CameraBlock (binding은 UniformTable이 이름으로 연결)
+layout (std140) uniform Camera
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
\ No newline at end of file
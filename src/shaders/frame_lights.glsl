@@ -0,0 +1,16 @@
+// frame_uniforms.h의 LightsBlock, NR_LIGHTS는 C++에서 FRAME_MAX_LIGHTS로 넣어줌
+#ifndef NR_LIGHTS
+#define NR_LIGHTS 32
+#endif
+struct Light {
+    vec3 Position;
+    float Linear;
+    vec3 Color;
+    float Quadratic;
+    float Radius;
+};
+layout (std140) uniform Lights
+{
+    Light lights[NR_LIGHTS];
+    int lightCount;
+};
\ No newline at end of file
@@ -0,0 +1,39 @@
+// light_manager.h의 LightManager, SoA라 shader는 필요한 배열만 읽음
+// LIGHTS_SSBO와 MAX_LIGHTS는 C++에서 LightManager::Defines()로 넣어줌
+#ifndef LIGHTS_SSBO
+#define LIGHTS_SSBO 0
+#endif
+#ifndef MAX_LIGHTS
+#define MAX_LIGHTS 32
+#endif
+// positions xyz 위치, colors rgb 색, attenuations x linear / y quadratic / z radius
+// binding 번호는 uniform_table.h의 UNIFORM_BLOCK_LIGHT_* (uniform block은 이름으로 연결됨)
+#if LIGHTS_SSBO
+layout (std430, binding = 3) readonly buffer LightPositions
+{
+    uint lightCount;
+    vec4 lightPositions[];
+};
+layout (std430, binding = 4) readonly buffer LightColors
+{
+    vec4 lightColors[];
+};
+layout (std430, binding = 5) readonly buffer LightAttenuations
+{
+    vec4 lightAttenuations[];
+};
+#else
+layout (std140) uniform LightPositions
+{
+    uint lightCount;
+    vec4 lightPositions[MAX_LIGHTS];
+};
+layout (std140) uniform LightColors
+{
+    vec4 lightColors[MAX_LIGHTS];
+};
+layout (std140) uniform LightAttenuations
+{
+    vec4 lightAttenuations[MAX_LIGHTS];
+};
+#endif
\ No newline at end of file
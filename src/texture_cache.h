@@ -0,0 +1,334 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <glad/glad.h>
+
+#ifndef STBI_INCLUDE_STB_IMAGE_H
+#include "stb_image.h"
+#endif
+#include "mipmap.h"
+#include "texture_compress.h"
+#include "texture_loader.h"
+#include "gl_state.h"
+
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// TextureCache::Acquire 옵션, ASYNC를 제외한 값은 캐시 키에 포함됨
+// mipmap은 CPU에서 만듦 (MipmapBuilder, SRGB는 linear 공간에서 filter, NORMAL_MAP은 재정규화)
+enum TextureCacheFlags {
+    TEXTURE_SRGB        = 1 << 0, // gamma 보정용 sRGB internal format
+    TEXTURE_NO_MIPMAP   = 1 << 1, // mipmap 없이 GL_LINEAR 필터
+    TEXTURE_FORCE_RGB   = 1 << 2, // 채널 수와 관계없이 RGB로 디코딩
+    TEXTURE_FORCE_RGBA  = 1 << 3, // 채널 수와 관계없이 RGBA로 디코딩
+    TEXTURE_NORMAL_MAP  = 1 << 4, // normal map (mipmap 재정규화, 비동기 로드시 flat normal placeholder, 압축시 BC7)
+    TEXTURE_ASYNC       = 1 << 5, // SharedTextureLoader()로 비동기 로드 (mipmap 있는 기본 포맷만)
+    TEXTURE_COMPRESS    = 1 << 6, // BCn으로 압축해서 업로드, 결과는 원본 옆 .dds 캐시에 저장 (동기 로드)
+    TEXTURE_COMPRESS_HQ = 1 << 7, // COMPRESS에서 RGB/RGBA도 BC7 사용 (기본은 BC1/BC3)
+    TEXTURE_NORMAL_RG   = 1 << 8, // COMPRESS + NORMAL_MAP을 BC5(RG)로, shader에서 z = sqrt(1 - x^2 - y^2) 복원 필요
+    TEXTURE_MIP_KAISER  = 1 << 9  // mipmap을 box 대신 Kaiser filter로 (mipmap.h)
+};
+
+struct TextureInfo
+{
+    unsigned int ID;
+    int Width, Height, Components;
+};
+
+// 프로세스 전체에서 공유하는 텍스처 캐시
+// 키는 정규화된 경로 + flag, 같은 파일은 한 번만 디코딩/업로드되고 참조 카운트로 관리
+class TextureCache
+{
+public:
+    // 텍스처를 가져오고 참조 카운트 증가, 없으면 불러옴
+    static TextureInfo Acquire(const std::string &path, unsigned int flags = 0)
+    {
+        State &s = state();
+        unsigned int keyFlags = flags & ~TEXTURE_ASYNC;
+        std::string key = CanonicalPath(path) + '|' + std::to_string(keyFlags);
+        std::unordered_map<std::string, Entry>::iterator it = s.entries.find(key);
+        if (it != s.entries.end())
+        {
+            s.hits++;
+            it->second.refCount++;
+            return it->second.info;
+        }
+        s.misses++;
+        Entry entry;
+        entry.refCount = 1;
+        entry.bytes = 0;
+        if (flags & TEXTURE_COMPRESS)
+            entry.info = loadCompressed(path, flags, entry.bytes);
+        else if ((flags & TEXTURE_ASYNC) && !(flags & (TEXTURE_NO_MIPMAP | TEXTURE_FORCE_RGB | TEXTURE_FORCE_RGBA)))
+            entry.info = loadAsync(path, flags);
+        else
+            entry.info = load(path, flags);
+        if (entry.bytes == 0)
+            entry.bytes = residentBytes(entry.info, flags);
+        s.residentBytes += entry.bytes;
+        s.keys[entry.info.ID] = key;
+        s.entries[key] = entry;
+        return entry.info;
+    }
+    // 참조 카운트 감소, 0이 되면 GL 텍스처 삭제
+    static void Release(unsigned int textureID)
+    {
+        State &s = state();
+        std::unordered_map<unsigned int, std::string>::iterator key = s.keys.find(textureID);
+        if (key == s.keys.end())
+            return;
+        std::unordered_map<std::string, Entry>::iterator it = s.entries.find(key->second);
+        if (--it->second.refCount > 0)
+            return;
+        s.residentBytes -= it->second.bytes;
+        // 비동기 로드 중이면 Update()가 지운 ID에 올리지 않도록
+        SharedTextureLoader().Cancel(textureID);
+        GLState::DeleteTextures(1, &textureID);
+        s.entries.erase(it);
+        s.keys.erase(key);
+    }
+
+    static unsigned int Hits() { return state().hits; }
+    static unsigned int Misses() { return state().misses; }
+    static size_t ResidentBytes() { return state().residentBytes; }
+    static size_t Count() { return state().entries.size(); }
+    static const TextureCompressStats &CompressStats() { return state().compress; }
+    static void PrintStats()
+    {
+        std::cout << "TEXTURE::CACHE:: " << Count() << " textures, " << ResidentBytes() / (1024.0 * 1024.0)
+                  << " MB resident, hits " << Hits() << " / misses " << Misses() << std::endl;
+        if (MipmapBuilder::Stats().chains > 0)
+            MipmapBuilder::Stats().Print();
+        if (CompressStats().textures > 0)
+            CompressStats().Print();
+    }
+
+    // 구분자 통일, '.', '..', 중복 '/' 정리 (Windows는 대소문자 무시)
+    static std::string CanonicalPath(const std::string &path)
+    {
+        std::vector<std::string> parts;
+        std::string part;
+        bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+        for (size_t i = 0; i <= path.size(); i++)
+        {
+            char c = i < path.size() ? path[i] : '/';
+            if (c != '/' && c != '\\')
+            {
+#ifdef _WIN32
+                c = (char)tolower((unsigned char)c);
+#endif
+                part += c;
+                continue;
+            }
+            if (part == "..")
+            {
+                if (!parts.empty() && parts.back() != "..")
+                    parts.pop_back();
+                else if (!absolute)
+                    parts.push_back(part);
+            }
+            else if (!part.empty() && part != ".")
+                parts.push_back(part);
+            part.clear();
+        }
+        std::string result = absolute ? "/" : "";
+        for (size_t i = 0; i < parts.size(); i++)
+            result += (i > 0 ? "/" : "") + parts[i];
+        return result;
+    }
+
+private:
+    struct Entry
+    {
+        TextureInfo info;
+        unsigned int refCount;
+        size_t bytes;
+    };
+    struct State
+    {
+        std::unordered_map<std::string, Entry> entries;
+        std::unordered_map<unsigned int, std::string> keys;
+        unsigned int hits = 0, misses = 0;
+        size_t residentBytes = 0;
+        TextureCompressStats compress;
+    };
+    static State &state()
+    {
+        static State s;
+        return s;
+    }
+
+    static TextureInfo load(const std::string &path, unsigned int flags)
+    {
+        TextureInfo info;
+        glGenTextures(1, &info.ID);
+
+        // mipmap이 있으면 MipmapBuilder용으로 RGBA로 디코딩 (internal format은 원래 채널 수 기준)
+        int desired = (flags & TEXTURE_FORCE_RGBA) ? 4 : (flags & TEXTURE_FORCE_RGB) ? 3 : 0;
+        bool mipmaps = !(flags & TEXTURE_NO_MIPMAP);
+        unsigned char *data = stbi_load(path.c_str(), &info.Width, &info.Height, &info.Components, mipmaps ? 4 : desired);
+        if (desired != 0)
+            info.Components = desired;
+        if (data)
+        {
+            GLenum internalFormat = GL_RGBA, dataFormat = GL_RGBA;
+            if (info.Components == 1)
+                internalFormat = dataFormat = GL_RED;
+            else if (info.Components == 3)
+            {
+                internalFormat = (flags & TEXTURE_SRGB) ? GL_SRGB : GL_RGB;
+                dataFormat = GL_RGB;
+            }
+            else if (info.Components == 4)
+                internalFormat = (flags & TEXTURE_SRGB) ? GL_SRGB_ALPHA : GL_RGBA;
+
+            GLState::BindTexture(GL_TEXTURE_2D, info.ID);
+            if (mipmaps)
+            {
+                MipChain chain;
+                MipmapBuilder::Build(data, info.Width, info.Height, mipmapFlags(flags), chain);
+                MipmapBuilder::Upload(chain, internalFormat);
+            }
+            else
+                glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, info.Width, info.Height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (flags & TEXTURE_NO_MIPMAP) ? GL_LINEAR : GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+            stbi_image_free(data);
+        }
+        else
+        {
+            std::cout << "Texture failed to load at path: " << path << std::endl;
+            info.Width = info.Height = info.Components = 0;
+        }
+        return info;
+    }
+    // 원본 hash가 같은 .dds 캐시가 있으면 그대로 올리고, 없으면 디코딩 -> mip 생성 -> 압축 -> 캐시 기록
+    // 지원하지 않는 포맷이거나 파일을 못 읽으면 load()로 대신함, bytes는 실제 압축된 크기
+    static TextureInfo loadCompressed(const std::string &path, unsigned int flags, size_t &bytes)
+    {
+        unsigned int fallbackFlags = flags & ~(TEXTURE_COMPRESS | TEXTURE_ASYNC);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        MappedFile source;
+        TextureInfo info;
+        if (!source.Open(path) || !stbi_info_from_memory(source.Data(), (int)source.Size(), &info.Width, &info.Height, &info.Components))
+            return load(path, fallbackFlags);
+        if (flags & (TEXTURE_FORCE_RGB | TEXTURE_FORCE_RGBA))
+            info.Components = (flags & TEXTURE_FORCE_RGBA) ? 4 : 3;
+
+        bool srgb = (flags & TEXTURE_SRGB) != 0, mipmaps = !(flags & TEXTURE_NO_MIPMAP);
+        TextureBlockFormat format;
+        if (!chooseBlockFormat(info.Components, flags, srgb, format))
+            return load(path, fallbackFlags);
+
+        // 캐시 키: 원본 내용 hash + 결과에 영향을 주는 옵션 (stbi 상하 반전 여부 포함)
+        State &s = state();
+        uint64_t hash = TextureCompressor::Hash(source.Data(), source.Size());
+        uint32_t options = (mipmaps ? 1u : 0u) | (stbiFlipsOnLoad() ? 2u : 0u) | (uint32_t)info.Components << 2 | mipmapFlags(flags) << 8;
+        std::string cachePath = path + '.' + BlockFormatInfo(format).name + ".dds";
+        CompressedTexture texture;
+        if (TextureCompressor::ReadCache(cachePath, hash, options, format, srgb, texture))
+            s.compress.cacheHits++;
+        else
+        {
+            int width, height, components;
+            unsigned char *data = stbi_load_from_memory(source.Data(), (int)source.Size(), &width, &height, &components, 4);
+            if (!data)
+                return load(path, fallbackFlags);
+            MipChain chain;
+            if (mipmaps)
+                MipmapBuilder::Build(data, width, height, mipmapFlags(flags), chain);
+            else
+            {
+                chain.levels.assign(1, MipLevel());
+                chain.levels[0].width = width;
+                chain.levels[0].height = height;
+                chain.levels[0].pixels.assign(data, data + (size_t)width * height * 4);
+            }
+            stbi_image_free(data);
+            TextureCompressor::Compress(chain, format, srgb, texture);
+            if (!TextureCompressor::WriteCache(cachePath, texture, hash, options))
+                std::cout << "TEXTURE::COMPRESS:: failed to write cache " << cachePath << std::endl;
+            s.compress.encoded++;
+            s.compress.encodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        glGenTextures(1, &info.ID);
+        GLState::BindTexture(GL_TEXTURE_2D, info.ID);
+        TextureCompressor::Upload(texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        bytes = texture.Bytes();
+        s.compress.textures++;
+        s.compress.compressedBytes += bytes;
+        s.compress.uncompressedBytes += residentBytes(info, flags);
+        s.compress.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return info;
+    }
+    static unsigned int mipmapFlags(unsigned int flags)
+    {
+        return ((flags & TEXTURE_SRGB) ? MIPMAP_SRGB : 0) | ((flags & TEXTURE_NORMAL_MAP) ? MIPMAP_NORMAL_MAP : 0) |
+               ((flags & TEXTURE_MIP_KAISER) ? MIPMAP_KAISER : 0);
+    }
+    // 채널 수/용도별 포맷, 이 context에서 못 쓰면 다른 포맷으로, 다 안되면 false
+    static bool chooseBlockFormat(int components, unsigned int flags, bool srgb, TextureBlockFormat &format)
+    {
+        TextureBlockFormat candidates[2];
+        if ((flags & TEXTURE_NORMAL_MAP) && (flags & TEXTURE_NORMAL_RG))
+            candidates[0] = candidates[1] = TEXTURE_BLOCK_BC5;
+        else if (components == 1 && !srgb)
+            candidates[0] = candidates[1] = TEXTURE_BLOCK_BC4;
+        else
+        {
+            // 알파가 있으면(grey + alpha 포함) BC3, 없으면 BC1
+            TextureBlockFormat basic = (components == 2 || components == 4) ? TEXTURE_BLOCK_BC3 : TEXTURE_BLOCK_BC1;
+            bool high = (flags & (TEXTURE_COMPRESS_HQ | TEXTURE_NORMAL_MAP)) != 0;
+            candidates[0] = high ? TEXTURE_BLOCK_BC7 : basic;
+            candidates[1] = high ? basic : TEXTURE_BLOCK_BC7;
+        }
+        for (int i = 0; i < 2; i++)
+            if (TextureCompressor::Supported(candidates[i], srgb))
+            {
+                format = candidates[i];
+                return true;
+            }
+        return false;
+    }
+    // stbi_set_flip_vertically_on_load 상태 (getter가 없어서 1x2 PGM을 디코딩해 확인)
+    static bool stbiFlipsOnLoad()
+    {
+        static const unsigned char pgm[] = { 'P', '5', ' ', '1', ' ', '2', ' ', '2', '5', '5', '\n', 0, 255 };
+        int width, height, components;
+        unsigned char *data = stbi_load_from_memory(pgm, (int)sizeof(pgm), &width, &height, &components, 1);
+        bool flipped = data && data[0] == 255;
+        stbi_image_free(data);
+        return flipped;
+    }
+    static TextureInfo loadAsync(const std::string &path, unsigned int flags)
+    {
+        TextureInfo info;
+        // 크기는 헤더만 읽어서 미리 계산
+        if (!stbi_info(path.c_str(), &info.Width, &info.Height, &info.Components))
+            info.Width = info.Height = info.Components = 0;
+        info.ID = SharedTextureLoader().Load(path, (flags & TEXTURE_SRGB) != 0, (flags & TEXTURE_NORMAL_MAP) ? 0x8080FFFF : 0x808080FF, mipmapFlags(flags));
+        return info;
+    }
+    // mipmap 포함 대략적인 GPU 메모리 크기
+    static size_t residentBytes(const TextureInfo &info, unsigned int flags)
+    {
+        size_t bytes = (size_t)info.Width * info.Height * info.Components;
+        return (flags & TEXTURE_NO_MIPMAP) ? bytes : bytes * 4 / 3;
+    }
+};
+
+#endif
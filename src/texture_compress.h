@@ -0,0 +1,699 @@
+#ifndef TEXTURE_COMPRESS_H
+#define TEXTURE_COMPRESS_H
+
+#include <glad/glad.h>
+
+#include "mapped_file.h"
+#include "mipmap.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// index 선택 SIMD (SSE2면 4픽셀씩, 그 외 1개씩)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_COMPRESS_SIMD 1
+#else
+#define TEXTURE_COMPRESS_SIMD 0
+#endif
+
+// S3TC는 GLAD에 없는 extension이라 직접 정의
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// 4x4 block 압축 포맷
+// BC1: RGB 4bpp, BC3: RGBA 8bpp (알파는 BC4와 같은 방식), BC4: R 4bpp, BC5: RG 8bpp, BC7: RGBA 8bpp (mode 6만 사용)
+enum TextureBlockFormat
+{
+    TEXTURE_BLOCK_BC1,
+    TEXTURE_BLOCK_BC3,
+    TEXTURE_BLOCK_BC4,
+    TEXTURE_BLOCK_BC5,
+    TEXTURE_BLOCK_BC7,
+    TEXTURE_BLOCK_COUNT
+};
+
+struct TextureBlockFormatInfo
+{
+    const char *name;
+    unsigned int blockBytes;
+    uint32_t dxgi, dxgiSrgb;      // DDS DX10 header (sRGB가 없으면 0)
+    GLenum glFormat, glFormatSrgb;
+};
+
+inline const TextureBlockFormatInfo &BlockFormatInfo(TextureBlockFormat format)
+{
+    static const TextureBlockFormatInfo infos[TEXTURE_BLOCK_COUNT] = {
+        { "bc1", 8,  71, 72, GL_COMPRESSED_RGB_S3TC_DXT1_EXT,  GL_COMPRESSED_SRGB_S3TC_DXT1_EXT },
+        { "bc3", 16, 77, 78, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT },
+        { "bc4", 8,  80, 0,  GL_COMPRESSED_RED_RGTC1,          0 },
+        { "bc5", 16, 83, 0,  GL_COMPRESSED_RG_RGTC2,           0 },
+        { "bc7", 16, 98, 99, GL_COMPRESSED_RGBA_BPTC_UNORM,    GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM },
+    };
+    return infos[format];
+}
+
+// mip 하나, data는 storage 또는 매핑된 캐시 파일을 가리킴
+struct CompressedMip
+{
+    int width, height;
+    const unsigned char *data;
+    size_t size;
+};
+
+// 압축된 mip chain (캐시에서 읽었으면 파일 매핑을 그대로 유지)
+struct CompressedTexture
+{
+    TextureBlockFormat format;
+    bool srgb;
+    int width, height;
+    vector<CompressedMip> mips;
+    vector<unsigned char> storage;
+    MappedFile file;
+
+    size_t Bytes() const
+    {
+        size_t bytes = 0;
+        for (unsigned int i = 0; i < mips.size(); i++)
+            bytes += mips[i].size;
+        return bytes;
+    }
+};
+
+// 압축 통계 (프로세스 누적), bytes는 mip 포함 GPU 크기
+struct TextureCompressStats
+{
+    unsigned int textures = 0;
+    unsigned int cacheHits = 0;
+    unsigned int encoded = 0;
+    size_t uncompressedBytes = 0; // 압축하지 않고 올렸을 때
+    size_t compressedBytes = 0;
+    double encodeMs = 0.0;        // 디코딩 + mip 생성 + 압축 + 캐시 기록
+    double loadMs = 0.0;          // 캐시 읽기/인코딩 포함 업로드까지 전체
+
+    void Print() const
+    {
+        const double mb = 1024.0 * 1024.0;
+        cout << "TEXTURE::COMPRESS:: " << textures << " textures (cache " << cacheHits << ", encoded " << encoded << ") | "
+             << uncompressedBytes / mb << " MB -> " << compressedBytes / mb << " MB, saved " << (uncompressedBytes - compressedBytes) / mb
+             << " MB | encode " << encodeMs << " ms, load " << loadMs << " ms" << endl;
+    }
+};
+
+// CPU BCn 인코더 + DDS 캐시
+// mip은 MipmapBuilder로 만들고, 압축은 block row 단위로 SharedThreadPool()에서 병렬 처리, GL 호출은 Upload()만
+class TextureCompressor
+{
+public:
+    // mip chain (mipmap.h) -> 같은 level 수의 압축 mip chain
+    static void Compress(const MipChain &chain, TextureBlockFormat format, bool srgb, CompressedTexture &out)
+    {
+        out.format = format;
+        out.srgb = srgb;
+        out.width = chain.levels[0].width;
+        out.height = chain.levels[0].height;
+        vector<int> widths, heights;
+        for (unsigned int i = 0; i < chain.levels.size(); i++)
+        {
+            widths.push_back(chain.levels[i].width);
+            heights.push_back(chain.levels[i].height);
+        }
+
+        // 출력 위치 계산, 모든 mip의 block row를 하나의 작업 목록으로
+        unsigned int blockBytes = BlockFormatInfo(format).blockBytes;
+        vector<size_t> offsets;
+        vector<unsigned int> firstRow;
+        size_t total = 0;
+        unsigned int rows = 0;
+        for (unsigned int i = 0; i < widths.size(); i++)
+        {
+            offsets.push_back(total);
+            firstRow.push_back(rows);
+            total += (size_t)blocksOf(widths[i]) * blocksOf(heights[i]) * blockBytes;
+            rows += blocksOf(heights[i]);
+        }
+        out.storage.assign(total, 0);
+        firstRow.push_back(rows);
+
+        unsigned char *storage = out.storage.data();
+        SharedThreadPool().ParallelFor(rows, [&](unsigned int row) {
+            unsigned int level = (unsigned int)(upper_bound(firstRow.begin(), firstRow.end(), row) - firstRow.begin()) - 1;
+            const unsigned char *image = chain.levels[level].pixels.data();
+            int w = widths[level], h = heights[level];
+            int by = (int)(row - firstRow[level]);
+            unsigned char *dst = storage + offsets[level] + (size_t)by * blocksOf(w) * blockBytes;
+            unsigned char pixels[64];
+            for (int bx = 0; bx < blocksOf(w); bx++, dst += blockBytes)
+            {
+                fetchBlock(image, w, h, bx, by, pixels);
+                EncodeBlock(format, pixels, dst);
+            }
+        });
+
+        out.mips.clear();
+        for (unsigned int i = 0; i < widths.size(); i++)
+        {
+            CompressedMip mip;
+            mip.width = widths[i];
+            mip.height = heights[i];
+            mip.data = storage + offsets[i];
+            mip.size = (size_t)blocksOf(widths[i]) * blocksOf(heights[i]) * blockBytes;
+            out.mips.push_back(mip);
+        }
+    }
+
+    // 4x4 RGBA8 (64byte) -> block 하나
+    static void EncodeBlock(TextureBlockFormat format, const unsigned char *pixels, unsigned char *dst)
+    {
+        Block block;
+        for (int i = 0; i < 16; i++)
+            for (int c = 0; c < 4; c++)
+                block.c[c][i] = pixels[i * 4 + c];
+        switch (format)
+        {
+        case TEXTURE_BLOCK_BC1: encodeBC1(block, dst); break;
+        case TEXTURE_BLOCK_BC3: encodeBC4(block, 3, dst); encodeBC1(block, dst + 8); break;
+        case TEXTURE_BLOCK_BC4: encodeBC4(block, 0, dst); break;
+        case TEXTURE_BLOCK_BC5: encodeBC4(block, 0, dst); encodeBC4(block, 1, dst + 8); break;
+        case TEXTURE_BLOCK_BC7: encodeBC7(block, dst); break;
+        default: break;
+        }
+    }
+
+    // 현재 context에서 쓸 수 있는 포맷인지 (BC4/5는 3.0 core, BC7은 4.2 core 또는 extension)
+    static bool Supported(TextureBlockFormat format, bool srgb)
+    {
+        switch (format)
+        {
+        case TEXTURE_BLOCK_BC1:
+        case TEXTURE_BLOCK_BC3:
+            return hasExtension("GL_EXT_texture_compression_s3tc") &&
+                   (!srgb || hasExtension("GL_EXT_texture_sRGB") || hasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+        case TEXTURE_BLOCK_BC4:
+        case TEXTURE_BLOCK_BC5:
+            return !srgb;
+        case TEXTURE_BLOCK_BC7:
+            return GLAD_GL_VERSION_4_2 || hasExtension("GL_ARB_texture_compression_bptc");
+        default:
+            return false;
+        }
+    }
+
+    // 바인딩된 GL_TEXTURE_2D에 모든 mip 업로드
+    static void Upload(const CompressedTexture &texture)
+    {
+        const TextureBlockFormatInfo &info = BlockFormatInfo(texture.format);
+        GLenum internalFormat = texture.srgb && info.glFormatSrgb ? info.glFormatSrgb : info.glFormat;
+        for (unsigned int i = 0; i < texture.mips.size(); i++)
+        {
+            const CompressedMip &mip = texture.mips[i];
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, internalFormat, mip.width, mip.height, 0, (GLsizei)mip.size, mip.data);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)texture.mips.size() - 1);
+    }
+
+    // 캐시 키로 쓰는 원본 파일 hash (FNV-1a 64bit)
+    static uint64_t Hash(const unsigned char *data, size_t size)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        return hash;
+    }
+
+    // DDS (DX10 header) 캐시
+    // 표준 DDS라 다른 도구로도 열 수 있고, 키(원본 hash, 옵션)는 header의 reserved 영역에 기록
+    static bool WriteCache(const string &cachePath, const CompressedTexture &texture, uint64_t sourceHash, uint32_t options)
+    {
+        std::ofstream out(cachePath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        DDSHeader header;
+        fillHeader(header, texture, sourceHash, options);
+        out.write((const char*)&header, sizeof(header));
+        for (unsigned int i = 0; i < texture.mips.size(); i++)
+            out.write((const char*)texture.mips[i].data, texture.mips[i].size);
+        return (bool)out;
+    }
+    // 캐시 파일을 매핑하고 검증, 원본이 바뀌었거나 옵션/포맷이 다르면 false
+    static bool ReadCache(const string &cachePath, uint64_t sourceHash, uint32_t options, TextureBlockFormat format, bool srgb, CompressedTexture &out)
+    {
+        if (!out.file.Open(cachePath) || out.file.Size() < sizeof(DDSHeader))
+            return failCache(out);
+        DDSHeader header;
+        memcpy(&header, out.file.Data(), sizeof(header));
+        const TextureBlockFormatInfo &info = BlockFormatInfo(format);
+        uint64_t hash = (uint64_t)header.reserved1[3] << 32 | header.reserved1[2];
+        if (memcmp(header.magic, "DDS ", 4) != 0 || header.reserved1[0] != DDS_CACHE_TAG || header.reserved1[1] != DDS_CACHE_VERSION ||
+            hash != sourceHash || header.reserved1[4] != options || header.dxgiFormat != (srgb && info.dxgiSrgb ? info.dxgiSrgb : info.dxgi) ||
+            header.mipMapCount == 0)
+            return failCache(out);
+
+        out.format = format;
+        out.srgb = srgb;
+        out.width = (int)header.width;
+        out.height = (int)header.height;
+        out.mips.clear();
+        size_t offset = sizeof(DDSHeader);
+        int w = out.width, h = out.height;
+        for (unsigned int i = 0; i < header.mipMapCount; i++)
+        {
+            CompressedMip mip;
+            mip.width = w;
+            mip.height = h;
+            mip.size = (size_t)blocksOf(w) * blocksOf(h) * info.blockBytes;
+            if (offset + mip.size > out.file.Size())
+                return failCache(out);
+            mip.data = out.file.Data() + offset;
+            offset += mip.size;
+            out.mips.push_back(mip);
+            w = max(w / 2, 1);
+            h = max(h / 2, 1);
+        }
+        return true;
+    }
+
+private:
+    // 16픽셀 채널별 (SoA, SIMD로 4픽셀씩 읽음)
+    struct Block
+    {
+        alignas(16) float c[4][16];
+    };
+
+    static const uint32_t DDS_CACHE_TAG = 0x58544342; // "BCTX"
+    static const uint32_t DDS_CACHE_VERSION = 2;
+
+    // magic + DDS_HEADER + DDS_HEADER_DXT10
+    struct DDSHeader
+    {
+        char     magic[4];
+        uint32_t size, flags, height, width, pitchOrLinearSize, depth, mipMapCount;
+        uint32_t reserved1[11]; // [0] tag, [1] version, [2..3] 원본 hash, [4] 옵션
+        uint32_t pfSize, pfFlags, pfFourCC, pfRGBBitCount, pfRMask, pfGMask, pfBMask, pfAMask;
+        uint32_t caps, caps2, caps3, caps4, reserved2;
+        uint32_t dxgiFormat, resourceDimension, miscFlag, arraySize, miscFlags2;
+    };
+
+    static int blocksOf(int size) { return (size + 3) / 4; }
+
+    static bool failCache(CompressedTexture &out)
+    {
+        out.file.Close();
+        out.mips.clear();
+        return false;
+    }
+    static void fillHeader(DDSHeader &header, const CompressedTexture &texture, uint64_t sourceHash, uint32_t options)
+    {
+        memset(&header, 0, sizeof(header));
+        const TextureBlockFormatInfo &info = BlockFormatInfo(texture.format);
+        memcpy(header.magic, "DDS ", 4);
+        header.size = 124;
+        header.flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // CAPS|HEIGHT|WIDTH|PIXELFORMAT|MIPMAPCOUNT|LINEARSIZE
+        header.height = (uint32_t)texture.height;
+        header.width = (uint32_t)texture.width;
+        header.pitchOrLinearSize = texture.mips.empty() ? 0 : (uint32_t)texture.mips[0].size;
+        header.mipMapCount = (uint32_t)texture.mips.size();
+        header.reserved1[0] = DDS_CACHE_TAG;
+        header.reserved1[1] = DDS_CACHE_VERSION;
+        header.reserved1[2] = (uint32_t)sourceHash;
+        header.reserved1[3] = (uint32_t)(sourceHash >> 32);
+        header.reserved1[4] = options;
+        header.pfSize = 32;
+        header.pfFlags = 0x4; // DDPF_FOURCC
+        memcpy(&header.pfFourCC, "DX10", 4);
+        header.caps = 0x1000 | (texture.mips.size() > 1 ? 0x8 | 0x400000 : 0); // TEXTURE (| COMPLEX | MIPMAP)
+        header.dxgiFormat = texture.srgb && info.dxgiSrgb ? info.dxgiSrgb : info.dxgi;
+        header.resourceDimension = 3; // TEXTURE2D
+        header.arraySize = 1;
+    }
+
+    static bool hasExtension(const char *name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++)
+        {
+            const char *extension = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (extension && strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    // 이미지 밖은 가장자리 픽셀로 채움 (4보다 작은 mip)
+    static void fetchBlock(const unsigned char *image, int width, int height, int bx, int by, unsigned char *pixels)
+    {
+        for (int y = 0; y < 4; y++)
+        {
+            const unsigned char *row = image + (size_t)min(by * 4 + y, height - 1) * width * 4;
+            for (int x = 0; x < 4; x++)
+                memcpy(pixels + (y * 4 + x) * 4, row + min(bx * 4 + x, width - 1) * 4, 4);
+        }
+    }
+
+    // origin에서 direction 방향으로 projection해서 0..steps 중 가장 가까운 칸 (direction은 steps / |d|^2 로 미리 scale)
+    static void selectSteps(const Block &block, const float origin[4], const float direction[4], int steps, int out[16])
+    {
+#if TEXTURE_COMPRESS_SIMD
+        __m128 zero = _mm_setzero_ps(), limit = _mm_set1_ps((float)steps);
+        for (int i = 0; i < 16; i += 4)
+        {
+            __m128 t = zero;
+            for (int c = 0; c < 4; c++)
+            {
+                __m128 offset = _mm_sub_ps(_mm_load_ps(&block.c[c][i]), _mm_set1_ps(origin[c]));
+                t = _mm_add_ps(t, _mm_mul_ps(offset, _mm_set1_ps(direction[c])));
+            }
+            t = _mm_min_ps(_mm_max_ps(t, zero), limit);
+            _mm_storeu_si128((__m128i*)(out + i), _mm_cvtps_epi32(t)); // 반올림
+        }
+#else
+        for (int i = 0; i < 16; i++)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < 4; c++)
+                t += (block.c[c][i] - origin[c]) * direction[c];
+            out[i] = (int)floorf(min(max(t, 0.0f), (float)steps) + 0.5f);
+        }
+#endif
+    }
+    static void stepDirection(const float from[4], const float to[4], int channels, int steps, float direction[4])
+    {
+        float length = 0.0f;
+        for (int c = 0; c < 4; c++)
+        {
+            direction[c] = c < channels ? to[c] - from[c] : 0.0f;
+            length += direction[c] * direction[c];
+        }
+        for (int c = 0; c < 4; c++)
+            direction[c] = length > 0.0f ? direction[c] * steps / length : 0.0f;
+    }
+
+    // 주성분 축 방향의 양 끝 (power iteration)
+    static void principalEndpoints(const Block &block, int channels, float start[4], float end[4])
+    {
+        float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float lo[4] = { 255.0f, 255.0f, 255.0f, 255.0f }, hi[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int c = 0; c < channels; c++)
+            for (int i = 0; i < 16; i++)
+            {
+                mean[c] += block.c[c][i] / 16.0f;
+                lo[c] = min(lo[c], block.c[c][i]);
+                hi[c] = max(hi[c], block.c[c][i]);
+            }
+        float covariance[4][4] = { { 0.0f } };
+        for (int i = 0; i < 16; i++)
+            for (int a = 0; a < channels; a++)
+                for (int b = a; b < channels; b++)
+                    covariance[a][b] += (block.c[a][i] - mean[a]) * (block.c[b][i] - mean[b]);
+        for (int a = 0; a < channels; a++)
+            for (int b = 0; b < a; b++)
+                covariance[a][b] = covariance[b][a];
+
+        float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int c = 0; c < channels; c++)
+            axis[c] = hi[c] - lo[c];
+        for (int iteration = 0; iteration < 4; iteration++)
+        {
+            float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, length = 0.0f;
+            for (int a = 0; a < channels; a++)
+            {
+                for (int b = 0; b < channels; b++)
+                    next[a] += covariance[a][b] * axis[b];
+                length = max(length, fabsf(next[a]));
+            }
+            if (length == 0.0f)
+                break;
+            for (int c = 0; c < channels; c++)
+                axis[c] = next[c] / length;
+        }
+
+        float minT = 0.0f, maxT = 0.0f;
+        for (int i = 0; i < 16; i++)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++)
+                t += (block.c[c][i] - mean[c]) * axis[c];
+            minT = min(minT, t);
+            maxT = max(maxT, t);
+        }
+        float length = 0.0f;
+        for (int c = 0; c < channels; c++)
+            length += axis[c] * axis[c];
+        if (length > 0.0f)
+        {
+            minT /= length;
+            maxT /= length;
+        }
+        for (int c = 0; c < 4; c++)
+        {
+            start[c] = c < channels ? min(max(mean[c] + axis[c] * minT, 0.0f), 255.0f) : 255.0f;
+            end[c] = c < channels ? min(max(mean[c] + axis[c] * maxT, 0.0f), 255.0f) : 255.0f;
+        }
+    }
+    // index가 정해졌을 때 오차 제곱합이 최소인 두 끝점 (weights는 end쪽 비율)
+    static bool leastSquaresEndpoints(const Block &block, int channels, const float weights[16], float start[4], float end[4])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f, xa[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, xb[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int i = 0; i < 16; i++)
+        {
+            float b = weights[i], a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < channels; c++)
+            {
+                xa[c] += a * block.c[c][i];
+                xb[c] += b * block.c[c][i];
+            }
+        }
+        float determinant = aa * bb - ab * ab;
+        if (fabsf(determinant) < 1e-6f)
+            return false;
+        for (int c = 0; c < channels; c++)
+        {
+            start[c] = min(max((bb * xa[c] - ab * xb[c]) / determinant, 0.0f), 255.0f);
+            end[c] = min(max((aa * xb[c] - ab * xa[c]) / determinant, 0.0f), 255.0f);
+        }
+        return true;
+    }
+
+    // BC1 color (4색 모드), BC3의 color 부분도 같음
+    static uint16_t pack565(const float color[4])
+    {
+        int r = (int)(color[0] * 31.0f / 255.0f + 0.5f), g = (int)(color[1] * 63.0f / 255.0f + 0.5f), b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+        return (uint16_t)(r << 11 | g << 5 | b);
+    }
+    static void unpack565(uint16_t packed, float color[4])
+    {
+        int r = packed >> 11 & 31, g = packed >> 5 & 63, b = packed & 31;
+        color[0] = (float)(r << 3 | r >> 2);
+        color[1] = (float)(g << 2 | g >> 4);
+        color[2] = (float)(b << 3 | b >> 2);
+        color[3] = 255.0f;
+    }
+    // 끝점을 565로 양자화하고 index 선택, 오차 제곱합 반환
+    static float fitBC1(const Block &block, const float start[4], const float end[4], uint16_t &c0, uint16_t &c1, int steps[16])
+    {
+        c0 = pack565(start);
+        c1 = pack565(end);
+        float p0[4], p1[4], direction[4];
+        unpack565(c0, p0);
+        unpack565(c1, p1);
+        stepDirection(p0, p1, 3, 3, direction);
+        selectSteps(block, p0, direction, 3, steps);
+        float error = 0.0f;
+        for (int i = 0; i < 16; i++)
+            for (int c = 0; c < 3; c++)
+            {
+                float value = (p0[c] * (3 - steps[i]) + p1[c] * steps[i]) / 3.0f - block.c[c][i];
+                error += value * value;
+            }
+        return error;
+    }
+    static void encodeBC1(const Block &block, unsigned char *dst)
+    {
+        float start[4], end[4];
+        principalEndpoints(block, 3, start, end);
+        uint16_t c0, c1;
+        int steps[16];
+        float error = fitBC1(block, start, end, c0, c1, steps);
+
+        // index 기준으로 끝점 다시 맞춰보고 더 나으면 사용
+        float weights[16];
+        for (int i = 0; i < 16; i++)
+            weights[i] = steps[i] / 3.0f;
+        if (error > 0.0f && leastSquaresEndpoints(block, 3, weights, start, end))
+        {
+            uint16_t r0, r1;
+            int refined[16];
+            if (fitBC1(block, start, end, r0, r1, refined) < error)
+            {
+                c0 = r0;
+                c1 = r1;
+                memcpy(steps, refined, sizeof(refined));
+            }
+        }
+
+        // 4색 모드는 c0 > c1, step 0..3 -> index 0, 2, 3, 1
+        static const unsigned int order[4] = { 0, 2, 3, 1 };
+        uint32_t indices = 0;
+        bool swap = c0 < c1;
+        if (c0 == c1)
+            memset(steps, 0, sizeof(steps));
+        for (int i = 0; i < 16; i++)
+            indices |= (order[swap ? 3 - steps[i] : steps[i]]) << (i * 2);
+        if (swap)
+            std::swap(c0, c1);
+        memcpy(dst, &c0, 2);
+        memcpy(dst + 2, &c1, 2);
+        memcpy(dst + 4, &indices, 4);
+    }
+
+    // BC4 (8단계 모드), channel 하나를 8byte로, BC3 알파/BC5 RG에도 사용
+    static void encodeBC4(const Block &block, int channel, unsigned char *dst)
+    {
+        float lo = 255.0f, hi = 0.0f;
+        for (int i = 0; i < 16; i++)
+        {
+            lo = min(lo, block.c[channel][i]);
+            hi = max(hi, block.c[channel][i]);
+        }
+        int a0 = (int)hi, a1 = (int)lo;
+        int steps[16] = { 0 };
+        if (a0 > a1)
+        {
+            Block single;
+            memcpy(single.c[0], block.c[channel], sizeof(single.c[0]));
+            memset(single.c[1], 0, sizeof(single.c[1]) * 3);
+            float origin[4] = { (float)a0, 0.0f, 0.0f, 0.0f }, target[4] = { (float)a1, 0.0f, 0.0f, 0.0f }, direction[4];
+            stepDirection(origin, target, 1, 7, direction);
+            selectSteps(single, origin, direction, 7, steps);
+        }
+        // step 0..7 (a0 -> a1) -> index 0, 2, 3, 4, 5, 6, 7, 1
+        static const uint64_t order[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+        uint64_t indices = 0;
+        for (int i = 0; i < 16; i++)
+            indices |= order[steps[i]] << (i * 3);
+        dst[0] = (unsigned char)a0;
+        dst[1] = (unsigned char)a1;
+        for (int i = 0; i < 6; i++)
+            dst[2 + i] = (unsigned char)(indices >> (i * 8));
+    }
+
+    // BC7 mode 6: subset 1개, RGBA 7bit 끝점 + 끝점별 p bit, 4bit index
+    static void quantizeBC7(const float value[4], int endpoint[4], int &pbit)
+    {
+        float best = -1.0f;
+        for (int p = 0; p < 2; p++)
+        {
+            int quantized[4];
+            float error = 0.0f;
+            for (int c = 0; c < 4; c++)
+            {
+                quantized[c] = min(max((int)((value[c] - p) / 2.0f + 0.5f), 0), 127);
+                float difference = (float)(quantized[c] << 1 | p) - value[c];
+                error += difference * difference;
+            }
+            if (best < 0.0f || error < best)
+            {
+                best = error;
+                pbit = p;
+                memcpy(endpoint, quantized, sizeof(quantized));
+            }
+        }
+    }
+    static float fitBC7(const Block &block, const float start[4], const float end[4], int e0[4], int e1[4], int p[2], int steps[16])
+    {
+        static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+        quantizeBC7(start, e0, p[0]);
+        quantizeBC7(end, e1, p[1]);
+        float p0[4], p1[4], direction[4];
+        for (int c = 0; c < 4; c++)
+        {
+            p0[c] = (float)(e0[c] << 1 | p[0]);
+            p1[c] = (float)(e1[c] << 1 | p[1]);
+        }
+        stepDirection(p0, p1, 4, 15, direction);
+        selectSteps(block, p0, direction, 15, steps);
+        float error = 0.0f;
+        for (int i = 0; i < 16; i++)
+            for (int c = 0; c < 4; c++)
+            {
+                int w = weights[steps[i]];
+                float value = (float)(((64 - w) * (int)p0[c] + w * (int)p1[c] + 32) >> 6) - block.c[c][i];
+                error += value * value;
+            }
+        return error;
+    }
+    static void encodeBC7(const Block &block, unsigned char *dst)
+    {
+        float start[4], end[4];
+        principalEndpoints(block, 4, start, end);
+        int e0[4], e1[4], p[2], steps[16];
+        float error = fitBC7(block, start, end, e0, e1, p, steps);
+
+        float weights[16];
+        for (int i = 0; i < 16; i++)
+            weights[i] = steps[i] / 15.0f;
+        if (error > 0.0f && leastSquaresEndpoints(block, 4, weights, start, end))
+        {
+            int r0[4], r1[4], rp[2], refined[16];
+            if (fitBC7(block, start, end, r0, r1, rp, refined) < error)
+            {
+                memcpy(e0, r0, sizeof(r0));
+                memcpy(e1, r1, sizeof(r1));
+                memcpy(p, rp, sizeof(rp));
+                memcpy(steps, refined, sizeof(refined));
+            }
+        }
+
+        // 0번 픽셀 index의 최상위 bit는 0으로 고정이라 필요하면 끝점을 바꿈
+        if (steps[0] >= 8)
+        {
+            for (int c = 0; c < 4; c++)
+                std::swap(e0[c], e1[c]);
+            std::swap(p[0], p[1]);
+            for (int i = 0; i < 16; i++)
+                steps[i] = 15 - steps[i];
+        }
+
+        uint64_t bits[2] = { 0, 0 };
+        unsigned int position = 0;
+        auto put = [&](uint64_t value, unsigned int count) {
+            for (unsigned int i = 0; i < count; i++, position++)
+                bits[position >> 6] |= ((value >> i) & 1) << (position & 63);
+        };
+        put(1 << 6, 7); // mode 6
+        for (int c = 0; c < 4; c++)
+        {
+            put((uint64_t)e0[c], 7);
+            put((uint64_t)e1[c], 7);
+        }
+        put((uint64_t)p[0], 1);
+        put((uint64_t)p[1], 1);
+        for (int i = 0; i < 16; i++)
+            put((uint64_t)steps[i], i == 0 ? 3 : 4);
+        memcpy(dst, bits, 16);
+    }
+};
+
+#endif
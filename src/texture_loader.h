@@ -0,0 +1,226 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+
+#ifndef STBI_INCLUDE_STB_IMAGE_H
+#include "stb_image.h"
+#endif
+#include "gl_state.h"
+#include "mipmap.h"
+#include "thread_pool.h"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// 비동기 텍스처 로더
+// Load()는 1x1 placeholder를 가진 텍스처 ID를 바로 돌려주고, 디코딩(stbi_load)과 mip chain 생성은 worker thread에서 진행
+// GL thread가 매 프레임 Update()를 호출하면 시간 예산 안에서 PBO를 통해 실제 이미지로 교체
+// 텍스처 ID는 바뀌지 않으므로 placeholder 상태로 바인딩해 둬도 됨
+class AsyncTextureLoader
+{
+public:
+    AsyncTextureLoader() : pending(0), nextPBO(0)
+    {
+        pbo[0] = pbo[1] = 0;
+    }
+    ~AsyncTextureLoader()
+    {
+        // worker가 아직 디코딩 중이면 끝날 때까지 기다림
+        for (unsigned int i = 0; i < decoding.size(); i++)
+            decoding[i].wait();
+    }
+    AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+    AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+
+    // 텍스처 ID를 만들고 디코딩 요청, placeholderRGBA는 0xRRGGBBAA, mipmapFlags는 MipmapFlags (gamma면 MIPMAP_SRGB 추가)
+    unsigned int Load(const std::string &path, bool gamma = false, unsigned int placeholderRGBA = 0x808080FF, unsigned int mipmapFlags = 0)
+    {
+        unsigned int textureID;
+        glGenTextures(1, &textureID);
+        unsigned char pixel[4] = {
+            (unsigned char)(placeholderRGBA >> 24), (unsigned char)(placeholderRGBA >> 16),
+            (unsigned char)(placeholderRGBA >> 8), (unsigned char)placeholderRGBA
+        };
+        GLState::BindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        std::shared_ptr<Request> request = std::make_shared<Request>();
+        request->texture = textureID;
+        request->path = path;
+        request->gamma = gamma;
+        request->mipmapFlags = mipmapFlags | (gamma ? MIPMAP_SRGB : 0);
+        inFlight[textureID] = request;
+        pending++;
+        decoding.push_back(SharedThreadPool().Enqueue([this, request]() {
+            // 이미 pool의 worker 안이라 mip chain은 이 thread에서만 만듦
+            int width, height, components;
+            unsigned char *pixels = stbi_load(request->path.c_str(), &width, &height, &components, 4);
+            if (pixels)
+            {
+                request->components = components;
+                MipmapBuilder::Build(pixels, width, height, request->mipmapFlags, request->chain, nullptr);
+                stbi_image_free(pixels);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(request);
+        }));
+        return textureID;
+    }
+
+    // GL thread에서 매 프레임 호출, budgetMs 만큼만 업로드 (최소 1개는 처리)
+    unsigned int Update(double budgetMs = 2.0)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        unsigned int uploaded = 0;
+        while (true)
+        {
+            std::shared_ptr<Request> request;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (ready.empty())
+                    break;
+                request = ready.front();
+                ready.pop_front();
+            }
+            pending--;
+            if (request->cancelled)
+                continue;
+            inFlight.erase(request->texture);
+            upload(*request);
+            uploaded++;
+            if (std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() >= budgetMs)
+                break;
+        }
+        // 끝난 future 정리
+        for (unsigned int i = 0; i < decoding.size();)
+        {
+            if (decoding[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                decoding[i] = std::move(decoding.back());
+                decoding.pop_back();
+            }
+            else
+                i++;
+        }
+        return uploaded;
+    }
+
+    // 남은 텍스처를 모두 디코딩/업로드할 때까지 대기
+    void Flush()
+    {
+        for (unsigned int i = 0; i < decoding.size(); i++)
+            decoding[i].wait();
+        while (pending > 0)
+            Update(1e9);
+    }
+
+    // 텍스처를 지우기 전에 호출 (GL thread), 아직 업로드 전이면 디코딩 결과를 버림
+    // 지운 ID를 glGenTextures가 다시 쓸 수 있으므로 ID가 아니라 요청에 표시함
+    void Cancel(unsigned int textureID)
+    {
+        std::unordered_map<unsigned int, std::shared_ptr<Request>>::iterator it = inFlight.find(textureID);
+        if (it == inFlight.end())
+            return;
+        it->second->cancelled = true;
+        inFlight.erase(it);
+    }
+
+    // 아직 실제 데이터로 교체되지 않은 텍스처 수
+    unsigned int Pending() const { return pending; }
+
+private:
+    struct Request
+    {
+        unsigned int texture;
+        std::string path;
+        bool gamma;
+        unsigned int mipmapFlags;
+        int components;  // 원본 채널 수 (chain은 항상 RGBA)
+        MipChain chain;  // 디코딩 실패시 비어 있음
+        bool cancelled;  // Cancel() 됨, GL thread에서만 읽고 씀
+        Request() : texture(0), gamma(false), mipmapFlags(0), components(0), cancelled(false) { }
+    };
+
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Request>> ready;
+    std::vector<std::future<void>> decoding;
+    std::unordered_map<unsigned int, std::shared_ptr<Request>> inFlight; // 업로드 전인 요청 (GL thread)
+    unsigned int pending;
+    unsigned int pbo[2];
+    unsigned int nextPBO;
+
+    // 모든 level을 PBO 하나에 이어서 복사 후 텍스처 재정의, PBO 두 개를 번갈아 사용
+    void upload(Request &request)
+    {
+        if (request.chain.levels.empty())
+        {
+            std::cout << "Texture failed to load at path: " << request.path << std::endl;
+            return;
+        }
+        GLenum internalFormat = GL_RGBA;
+        if (request.components == 1)
+            internalFormat = GL_RED;
+        else if (request.components == 3)
+            internalFormat = request.gamma ? GL_SRGB : GL_RGB;
+        else if (request.components == 4)
+            internalFormat = request.gamma ? GL_SRGB_ALPHA : GL_RGBA;
+
+        if (pbo[0] == 0)
+            glGenBuffers(2, pbo);
+        GLsizeiptr size = (GLsizeiptr)request.chain.Bytes();
+        GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[nextPBO]);
+        nextPBO = (nextPBO + 1) % 2;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW); // orphan
+        unsigned char *dst = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (dst)
+        {
+            size_t offset = 0;
+            for (unsigned int i = 0; i < request.chain.levels.size(); i++)
+            {
+                const std::vector<unsigned char> &pixels = request.chain.levels[i].pixels;
+                memcpy(dst + offset, pixels.data(), pixels.size());
+                offset += pixels.size();
+            }
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+
+        GLState::BindTexture(GL_TEXTURE_2D, request.texture);
+        if (dst)
+        {
+            size_t offset = 0;
+            for (unsigned int i = 0; i < request.chain.levels.size(); i++)
+            {
+                const MipLevel &level = request.chain.levels[i];
+                glTexImage2D(GL_TEXTURE_2D, (GLint)i, internalFormat, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (void*)offset);
+                offset += level.pixels.size();
+            }
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)request.chain.levels.size() - 1);
+        }
+        GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!dst) // 매핑 실패시 직접 업로드
+            MipmapBuilder::Upload(request.chain, internalFormat);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+
+        request.chain.levels.clear();
+    }
+};
+
+// 프로세스 전체에서 공유하는 로더
+AsyncTextureLoader &SharedTextureLoader()
+{
+    static AsyncTextureLoader loader;
+    return loader;
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 고정 크기 worker thread pool
+// GL 호출은 하면 안 됨 (context는 main thread에만 있음)
+class ThreadPool
+{
+public:
+    // threads가 0이면 hardware_concurrency 사용
+    explicit ThreadPool(unsigned int threads = 0) : stopping(false)
+    {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        for (unsigned int i = 0; i < threads; i++)
+            workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (unsigned int i = 0; i < workers.size(); i++)
+            workers[i].join();
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned int Size() const { return (unsigned int)workers.size(); }
+
+    // 작업 하나를 넣고 결과를 future로 받음
+    template <typename F>
+    std::future<decltype(std::declval<F&>()())> Enqueue(F task)
+    {
+        typedef decltype(std::declval<F&>()()) Result;
+        std::shared_ptr<std::packaged_task<Result()>> packaged = std::make_shared<std::packaged_task<Result()>>(task);
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push([packaged]() { (*packaged)(); });
+        }
+        condition.notify_one();
+        return result;
+    }
+
+    // [0, count) 범위를 worker들과 부른 thread가 같이 실행하고 끝날 때까지 대기
+    // 인덱스는 atomic 카운터로 하나씩 가져가므로 크기가 들쭉날쭉한 작업도 균등하게 분배됨
+    // 기다리는 동안 queue의 작업도 대신 실행하므로 worker 안에서 불러도 멈추지 않음
+    // body가 던진 예외는 모든 작업이 끝난 뒤 첫 번째 것을 다시 던짐 (body는 그때까지 살아 있어야 함)
+    void ParallelFor(unsigned int count, const std::function<void(unsigned int)> &body)
+    {
+        if (count == 0)
+            return;
+        std::atomic<unsigned int> next(0);
+        auto run = [&next, count, &body]() {
+            for (unsigned int i = next++; i < count; i = next++)
+                body(i);
+        };
+        unsigned int helpers = count - 1 < Size() ? count - 1 : Size();
+        std::vector<std::future<void>> results;
+        for (unsigned int j = 0; j < helpers; j++)
+            results.push_back(Enqueue(run));
+
+        std::exception_ptr error;
+        try
+        {
+            run();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        for (unsigned int j = 0; j < results.size(); j++)
+        {
+            while (results[j].wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                if (!runPending())
+                    std::this_thread::yield();
+            try
+            {
+                results[j].get();
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    // queue에 작업이 있으면 하나를 이 thread에서 실행 (없으면 false)
+    bool runPending()
+    {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+        return true;
+    }
+
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+};
+
+// 프로세스 전체에서 공유하는 pool
+ThreadPool &SharedThreadPool()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+#endif
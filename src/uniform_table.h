@@ -0,0 +1,267 @@
+#ifndef UNIFORM_TABLE_H
+#define UNIFORM_TABLE_H
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 모든 program의 uniform 설정 횟수 (여러 프레임 누적)
+// 전에는 set 한 번마다 glGetUniformLocation + glUniform을 한 번씩 불렀음
+struct UniformStats
+{
+    unsigned int sets = 0;      // setX 호출 수
+    unsigned int lookups = 0;   // 이름으로 찾은 수 (hash table, GL 호출 없음), handle로 설정하면 0
+    unsigned int uploads = 0;   // 실제 glUniform 호출
+    unsigned int skipped = 0;   // 마지막으로 올린 값과 같아서 생략
+    unsigned int inactive = 0;  // program에 없는 이름 (location -1이라 원래도 무시되던 것)
+
+    void Reset() { *this = UniformStats(); }
+    void Print(const std::string &name, unsigned int frames = 1) const
+    {
+        frames = frames ? frames : 1;
+        std::cout << "SHADER::UNIFORM:: " << name << " " << sets / frames << " sets/frame | glGetUniformLocation 0 (was " << sets / frames
+                  << ", " << lookups / frames << " hash lookups instead) | glUniform "
+                  << uploads / frames << " (was " << sets / frames << ", skipped " << skipped / frames << " unchanged, "
+                  << inactive / frames << " inactive)" << std::endl;
+    }
+};
+inline UniformStats &SharedUniformStats()
+{
+    static UniformStats stats;
+    return stats;
+}
+
+// 이름이 정해진 uniform block의 binding point, link 직후 UniformTable이 자동으로 연결
+// (GLSL 3.3에는 layout(binding = N)이 없어서 program마다 glUniformBlockBinding 필요)
+enum UniformBlockBinding {
+    UNIFORM_BLOCK_BONES  = 0,  // "Bones" (animation.h)
+    UNIFORM_BLOCK_CAMERA = 1,  // "Camera" (frame_uniforms.h)
+    UNIFORM_BLOCK_LIGHTS = 2,  // "Lights" (frame_uniforms.h)
+    // light_manager.h의 light list (SSBO일 때는 shader의 layout(binding)으로 같은 번호)
+    UNIFORM_BLOCK_LIGHT_POSITIONS    = 3,  // "LightPositions"
+    UNIFORM_BLOCK_LIGHT_COLORS       = 4,  // "LightColors"
+    UNIFORM_BLOCK_LIGHT_ATTENUATIONS = 5   // "LightAttenuations"
+};
+inline int UniformBlockBindingOf(const char *name)
+{
+    if (strcmp(name, "Bones") == 0)
+        return UNIFORM_BLOCK_BONES;
+    if (strcmp(name, "Camera") == 0)
+        return UNIFORM_BLOCK_CAMERA;
+    if (strcmp(name, "Lights") == 0)
+        return UNIFORM_BLOCK_LIGHTS;
+    if (strcmp(name, "LightPositions") == 0)
+        return UNIFORM_BLOCK_LIGHT_POSITIONS;
+    if (strcmp(name, "LightColors") == 0)
+        return UNIFORM_BLOCK_LIGHT_COLORS;
+    if (strcmp(name, "LightAttenuations") == 0)
+        return UNIFORM_BLOCK_LIGHT_ATTENUATIONS;
+    return -1;
+}
+
+// link 후 미리 찾아둔 uniform, 이름 대신 이걸로 설정하면 hash도 하지 않음
+struct UniformHandle
+{
+    int index;
+    UniformHandle() : index(-1) { }
+    explicit UniformHandle(int index) : index(index) { }
+    bool Valid() const { return index >= 0; }
+};
+
+// program의 active uniform 전체를 link 직후 한 번 읽어서 만든 이름 -> location 표
+// 배열은 "name", "name[0]" ... "name[size-1]"를 모두 등록 (struct 배열은 GL이 원소마다 따로 알려줌)
+// 마지막으로 올린 값도 기억해서 같은 값이면 glUniform을 생략함
+// uniform block 멤버는 표에 없음 (block은 위 binding point로 연결만 함)
+class UniformTable
+{
+public:
+    explicit UniformTable(GLuint program) : program(program)
+    {
+        reflect();
+        registry()[program] = this;
+    }
+    ~UniformTable()
+    {
+        std::unordered_map<GLuint, UniformTable*>::iterator it = registry().find(program);
+        if (it != registry().end() && it->second == this)
+            registry().erase(it);
+    }
+    UniformTable(const UniformTable &) = delete;
+    UniformTable &operator=(const UniformTable &) = delete;
+
+    unsigned int Size() const { return (unsigned int)entries.size(); }
+    UniformHandle Find(const char *name) const
+    {
+        SharedUniformStats().lookups++;
+        if (slots.empty())
+            return UniformHandle();
+        uint32_t hash = hashName(name);
+        uint32_t mask = (uint32_t)slots.size() - 1;
+        for (uint32_t i = hash & mask; slots[i].key != 0; i = (i + 1) & mask)
+            if (slots[i].hash == hash && keys[slots[i].key - 1].name == name)
+                return UniformHandle(keys[slots[i].key - 1].entry);
+        return UniformHandle();
+    }
+    GLint Location(UniformHandle handle) const { return handle.Valid() ? entries[handle.index].location : -1; }
+
+    // 새 값이면 기억하고 true (glUniform 필요), 같은 값이거나 없는 uniform이면 false
+    bool Changed(UniformHandle handle, const void *value, unsigned int bytes)
+    {
+        UniformStats &stats = SharedUniformStats();
+        stats.sets++;
+        if (!handle.Valid())
+        {
+            stats.inactive++;
+            return false;
+        }
+        Entry &entry = entries[handle.index];
+        if (entry.bytes == bytes && memcmp(entry.value, value, bytes) == 0)
+        {
+            stats.skipped++;
+            return false;
+        }
+        entry.bytes = bytes <= sizeof(entry.value) ? bytes : 0;
+        if (entry.bytes)
+            memcpy(entry.value, value, bytes);
+        stats.uploads++;
+        return true;
+    }
+    // 기억한 값을 모두 버림 (program을 다시 link했거나 밖에서 값을 바꿨을 때)
+    void Invalidate()
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+            entries[i].bytes = 0;
+    }
+
+    // Shader를 거치지 않고 glUniform을 직접 부르는 곳(RenderQueue, Material 등)에서 알려줌
+    static void Forget(GLuint program, GLint location)
+    {
+        if (location < 0 || registry().empty())
+            return;
+        std::unordered_map<GLuint, UniformTable*>::iterator it = registry().find(program);
+        if (it == registry().end())
+            return;
+        UniformTable &table = *it->second;
+        if ((size_t)location < table.byLocation.size() && table.byLocation[location] >= 0)
+            table.entries[table.byLocation[location]].bytes = 0;
+    }
+
+private:
+    struct Entry
+    {
+        GLint location;
+        unsigned int bytes;        // 기억한 값 크기, 0이면 모름
+        unsigned char value[64];   // mat4까지
+    };
+    // 이름 하나 -> entry ("name"과 "name[0]"은 같은 entry)
+    struct Key
+    {
+        std::string name;
+        int entry;
+    };
+    struct Slot
+    {
+        uint32_t hash;
+        uint32_t key;              // keys index + 1, 0이면 빈 칸
+    };
+    GLuint program;
+    std::vector<Entry> entries;
+    std::vector<Key> keys;
+    std::vector<Slot> slots;       // open addressing, 크기는 2의 거듭제곱
+    std::vector<int> byLocation;   // location -> entries index
+
+    static std::unordered_map<GLuint, UniformTable*> &registry()
+    {
+        static std::unordered_map<GLuint, UniformTable*> tables;
+        return tables;
+    }
+    static uint32_t hashName(const char *name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name; name++)
+            hash = (hash ^ (unsigned char)*name) * 16777619u;
+        return hash;
+    }
+
+    void reflect()
+    {
+        GLint count = 0, maxLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::vector<char> buffer(maxLength > 0 ? maxLength : 1);
+        for (GLint i = 0; i < count; i++)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program, (GLuint)i, (GLsizei)buffer.size(), &length, &size, &type, buffer.data());
+            std::string name(buffer.data(), length);
+            // uniform block 안의 멤버는 location이 없음
+            GLint location = glGetUniformLocation(program, name.c_str());
+            if (location < 0)
+                continue;
+            size_t bracket = name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0 ? name.size() - 3 : std::string::npos;
+            if (bracket == std::string::npos)
+            {
+                add(name, location);
+                continue;
+            }
+            std::string base = name.substr(0, bracket);
+            add(name, location);
+            keys.push_back(Key{ base, keys.back().entry });
+            for (GLint j = 1; j < size; j++)
+            {
+                std::string element = base + "[" + std::to_string(j) + "]";
+                add(element, glGetUniformLocation(program, element.c_str()));
+            }
+        }
+        // 빈 칸이 절반 이상 남게
+        size_t capacity = 16;
+        while (capacity < keys.size() * 2)
+            capacity *= 2;
+        slots.assign(capacity, Slot());
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            uint32_t hash = hashName(keys[k].name.c_str());
+            uint32_t i = hash & (uint32_t)(capacity - 1);
+            while (slots[i].key != 0)
+                i = (i + 1) & (uint32_t)(capacity - 1);
+            slots[i].hash = hash;
+            slots[i].key = (uint32_t)k + 1;
+        }
+        bindBlocks();
+    }
+    void bindBlocks()
+    {
+        GLint count = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        for (GLint i = 0; i < count; i++)
+        {
+            char name[64] = { 0 };
+            glGetActiveUniformBlockName(program, (GLuint)i, sizeof(name), nullptr, name);
+            int binding = UniformBlockBindingOf(name);
+            if (binding >= 0)
+                glUniformBlockBinding(program, (GLuint)i, (GLuint)binding);
+        }
+    }
+    void add(const std::string &name, GLint location)
+    {
+        if (location < 0)
+            return;
+        Entry entry;
+        entry.location = location;
+        entry.bytes = 0;
+        entries.push_back(entry);
+        keys.push_back(Key{ name, (int)entries.size() - 1 });
+        if ((size_t)location >= byLocation.size())
+            byLocation.resize(location + 1, -1);
+        byLocation[location] = (int)entries.size() - 1;
+    }
+};
+
+#endif
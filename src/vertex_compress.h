@@ -0,0 +1,193 @@
+#ifndef VERTEX_COMPRESS_H
+#define VERTEX_COMPRESS_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include "mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Vertex(88 byte) -> CompressedVertex(20 byte) 변환
+// position: mesh AABB 기준 unorm16, uv: half float, normal/tangent: octahedral snorm16, bitangent: 부호만 (position.w)
+// bone 데이터는 버림 (정적 mesh 전용)
+//
+// vertex shader 디코딩 (attribute 0: vec4 unorm, 1: vec2 snorm, 2: vec2 half, 3: vec2 snorm)
+//   vec3 octDecode(vec2 e) { vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y)); if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * sign(n.xy); return normalize(n); }
+//   vec3 pos = positionOffset + aPos.xyz * positionScale;
+//   vec3 N = octDecode(aNormal), T = octDecode(aTangent), B = cross(N, T) * (aPos.w * 2.0 - 1.0);
+
+// 원본 대비 최대 오차와 메모리 크기
+struct VertexCompressionReport
+{
+    unsigned int vertexCount = 0;
+    size_t rawVertexBytes = 0, compressedVertexBytes = 0;
+    size_t rawIndexBytes = 0, compressedIndexBytes = 0;
+    float maxPositionError = 0.0f;   // 원본 단위 (world가 아닌 model space)
+    float maxTexCoordError = 0.0f;
+    float maxNormalDegrees = 0.0f;
+    float maxTangentDegrees = 0.0f;
+    unsigned int flippedBitangents = 0; // 재구성한 bitangent가 원본과 반대 방향인 vertex 수
+
+    void Merge(const VertexCompressionReport &other)
+    {
+        vertexCount += other.vertexCount;
+        rawVertexBytes += other.rawVertexBytes;
+        compressedVertexBytes += other.compressedVertexBytes;
+        rawIndexBytes += other.rawIndexBytes;
+        compressedIndexBytes += other.compressedIndexBytes;
+        maxPositionError = std::max(maxPositionError, other.maxPositionError);
+        maxTexCoordError = std::max(maxTexCoordError, other.maxTexCoordError);
+        maxNormalDegrees = std::max(maxNormalDegrees, other.maxNormalDegrees);
+        maxTangentDegrees = std::max(maxTangentDegrees, other.maxTangentDegrees);
+        flippedBitangents += other.flippedBitangents;
+    }
+    void Print(const std::string &name) const
+    {
+        size_t raw = rawVertexBytes + rawIndexBytes, compressed = compressedVertexBytes + compressedIndexBytes;
+        std::cout << "MESH::COMPRESS:: " << name << " (" << vertexCount << " vertices) vertex "
+                  << rawVertexBytes / 1024 << " KB -> " << compressedVertexBytes / 1024 << " KB ("
+                  << (compressedVertexBytes ? (float)rawVertexBytes / compressedVertexBytes : 0.0f) << "x), total "
+                  << raw / 1024 << " KB -> " << compressed / 1024 << " KB ("
+                  << (compressed ? (float)raw / compressed : 0.0f) << "x)" << std::endl
+                  << "MESH::COMPRESS:: max error position " << maxPositionError << " | uv " << maxTexCoordError
+                  << " | normal " << maxNormalDegrees << " deg | tangent " << maxTangentDegrees
+                  << " deg | flipped bitangents " << flippedBitangents << std::endl;
+    }
+};
+
+// octahedral 인코딩, 단위벡터 -> [-1, 1]^2
+inline glm::vec2 OctEncode(glm::vec3 n)
+{
+    float length = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (length < 1e-20f)
+        return glm::vec2(0.0f); // 0 벡터 (tangent 없는 mesh)
+    n /= length;
+    glm::vec2 e(n.x, n.y);
+    if (n.z < 0.0f)
+    {
+        e.x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        e.y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return e;
+}
+inline glm::vec3 OctDecode(glm::vec2 e)
+{
+    glm::vec3 n(e.x, e.y, 1.0f - std::fabs(e.x) - std::fabs(e.y));
+    if (n.z < 0.0f)
+    {
+        float x = n.x;
+        n.x = (1.0f - std::fabs(n.y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        n.y = (1.0f - std::fabs(x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    float length = glm::length(n);
+    return length > 0.0f ? n / length : n;
+}
+
+inline short PackSnorm16(float v)
+{
+    return (short)std::floor(glm::clamp(v, -1.0f, 1.0f) * 32767.0f + 0.5f);
+}
+inline float UnpackSnorm16(short v)
+{
+    return std::max((float)v / 32767.0f, -1.0f);
+}
+inline unsigned short PackUnorm16(float v)
+{
+    return (unsigned short)std::floor(glm::clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+// 두 방향 사이 각도 (0 벡터는 무시)
+inline float AngleDegrees(const glm::vec3 &a, const glm::vec3 &b)
+{
+    float la = glm::length(a), lb = glm::length(b);
+    if (la < 1e-6f || lb < 1e-6f)
+        return 0.0f;
+    return glm::degrees(std::acos(glm::clamp(glm::dot(a, b) / (la * lb), -1.0f, 1.0f)));
+}
+
+// vertex 하나 디코딩 (shader와 같은 식, 오차 계산용)
+inline Vertex DecodeVertex(const CompressedVertex &c, const glm::vec3 &offset, const glm::vec3 &scale)
+{
+    Vertex v = Vertex();
+    v.Position = offset + glm::vec3(c.Position[0], c.Position[1], c.Position[2]) / 65535.0f * scale;
+    v.Normal = OctDecode(glm::vec2(UnpackSnorm16(c.Normal[0]), UnpackSnorm16(c.Normal[1])));
+    v.TexCoords = glm::vec2(glm::unpackHalf1x16(c.TexCoords[0]), glm::unpackHalf1x16(c.TexCoords[1]));
+    v.Tangent = OctDecode(glm::vec2(UnpackSnorm16(c.Tangent[0]), UnpackSnorm16(c.Tangent[1])));
+    v.Bitangent = glm::cross(v.Normal, v.Tangent) * (c.Position[3] ? 1.0f : -1.0f);
+    return v;
+}
+
+// vertex/index 압축, GL 호출 없음 (worker thread에서 실행 가능)
+inline void CompressMesh(const Vertex *vertices, unsigned int vertexCount, const unsigned int *indices, unsigned int indexCount, CompressedMeshData &out)
+{
+    // 1. AABB
+    glm::vec3 minPos(0.0f), maxPos(0.0f);
+    if (vertexCount > 0)
+        minPos = maxPos = vertices[0].Position;
+    for (unsigned int i = 1; i < vertexCount; i++)
+    {
+        minPos = glm::min(minPos, vertices[i].Position);
+        maxPos = glm::max(maxPos, vertices[i].Position);
+    }
+    out.positionOffset = minPos;
+    out.positionScale = maxPos - minPos;
+    glm::vec3 invScale;
+    for (int k = 0; k < 3; k++)
+        invScale[k] = out.positionScale[k] > 0.0f ? 1.0f / out.positionScale[k] : 0.0f;
+
+    // 2. vertex
+    out.vertices.resize(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; i++)
+    {
+        const Vertex &v = vertices[i];
+        CompressedVertex &c = out.vertices[i];
+        glm::vec3 p = (v.Position - minPos) * invScale;
+        c.Position[0] = PackUnorm16(p.x);
+        c.Position[1] = PackUnorm16(p.y);
+        c.Position[2] = PackUnorm16(p.z);
+        c.Position[3] = glm::dot(glm::cross(v.Normal, v.Tangent), v.Bitangent) < 0.0f ? 0 : 65535;
+        glm::vec2 n = OctEncode(v.Normal);
+        c.Normal[0] = PackSnorm16(n.x);
+        c.Normal[1] = PackSnorm16(n.y);
+        c.TexCoords[0] = glm::packHalf1x16(v.TexCoords.x);
+        c.TexCoords[1] = glm::packHalf1x16(v.TexCoords.y);
+        glm::vec2 t = OctEncode(v.Tangent);
+        c.Tangent[0] = PackSnorm16(t.x);
+        c.Tangent[1] = PackSnorm16(t.y);
+    }
+
+    // 3. index, vertex가 65536개 이하면 16bit
+    out.indices16.clear();
+    if (vertexCount <= 65536)
+        out.indices16.assign(indices, indices + indexCount);
+}
+
+// 원본과 비교해서 오차 측정
+inline VertexCompressionReport MeasureCompression(const Vertex *vertices, unsigned int vertexCount, unsigned int indexCount, const CompressedMeshData &compressed)
+{
+    VertexCompressionReport report;
+    report.vertexCount = vertexCount;
+    report.rawVertexBytes = (size_t)vertexCount * sizeof(Vertex);
+    report.compressedVertexBytes = compressed.vertices.size() * sizeof(CompressedVertex);
+    report.rawIndexBytes = (size_t)indexCount * sizeof(unsigned int);
+    report.compressedIndexBytes = compressed.indices16.empty() ? report.rawIndexBytes : compressed.indices16.size() * sizeof(unsigned short);
+    for (unsigned int i = 0; i < vertexCount; i++)
+    {
+        const Vertex &v = vertices[i];
+        Vertex d = DecodeVertex(compressed.vertices[i], compressed.positionOffset, compressed.positionScale);
+        report.maxPositionError = std::max(report.maxPositionError, glm::length(d.Position - v.Position));
+        glm::vec2 uv = glm::abs(d.TexCoords - v.TexCoords);
+        report.maxTexCoordError = std::max(report.maxTexCoordError, std::max(uv.x, uv.y));
+        report.maxNormalDegrees = std::max(report.maxNormalDegrees, AngleDegrees(v.Normal, d.Normal));
+        report.maxTangentDegrees = std::max(report.maxTangentDegrees, AngleDegrees(v.Tangent, d.Tangent));
+        if (glm::dot(v.Bitangent, d.Bitangent) < 0.0f)
+            report.flippedBitangents++;
+    }
+    return report;
+}
+
+#endif
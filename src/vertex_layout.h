@@ -0,0 +1,136 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#define MAX_BONE_INFLUENCE 4
+
+struct Vertex{
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec2 TexCoords;
+    glm::vec3 Tangent;
+    glm::vec3 Bitangent;
+    int m_BoneIDs[MAX_BONE_INFLUENCE];
+    float m_Weights[MAX_BONE_INFLUENCE];
+};
+
+// mesh가 실제로 가진 vertex attribute, bit 순서 = GPU buffer 안의 순서
+// attribute 위치는 기존과 같음 (0: position, 1: normal, 2: uv, 3: tangent, 4: bitangent, 5/6: bone id/weight)
+enum VertexAttributeBits {
+    VERTEX_POSITION  = 1 << 0,
+    VERTEX_NORMAL    = 1 << 1,
+    VERTEX_TEXCOORDS = 1 << 2,
+    VERTEX_TANGENT   = 1 << 3,
+    VERTEX_BITANGENT = 1 << 4,
+    VERTEX_BONES     = 1 << 5  // bone id + weight
+};
+const unsigned int VERTEX_LAYOUT_FULL = (1 << 6) - 1;
+const unsigned int VERTEX_LAYOUT_COUNT = 1 << 6;
+
+// attribute 하나의 GPU 크기 (byte)
+constexpr unsigned int VertexAttributeSize(unsigned int bit)
+{
+    return bit == VERTEX_POSITION || bit == VERTEX_NORMAL || bit == VERTEX_TANGENT || bit == VERTEX_BITANGENT ? sizeof(glm::vec3) :
+           bit == VERTEX_TEXCOORDS ? sizeof(glm::vec2) :
+           bit == VERTEX_BONES ? MAX_BONE_INFLUENCE * (sizeof(int) + sizeof(float)) : 0;
+}
+
+// layout mask 하나에 대한 컴파일 타임 descriptor
+// offset/stride가 상수라서 Pack은 필요한 필드만 복사하고, SetupAttributes는 있는 attribute만 켬
+template <unsigned int Mask>
+struct VertexLayout
+{
+    // bit 앞에 있는 attribute 크기 합
+    static constexpr unsigned int Offset(unsigned int bit)
+    {
+        unsigned int offset = 0;
+        for (unsigned int b = 1; b < bit; b <<= 1)
+            if (Mask & b)
+                offset += VertexAttributeSize(b);
+        return offset;
+    }
+    static constexpr unsigned int Stride() { return Offset(VERTEX_LAYOUT_COUNT); }
+
+    // Vertex -> 촘촘한 interleaved buffer
+    static void Pack(const Vertex *vertices, size_t count, unsigned char *dst)
+    {
+        for (size_t i = 0; i < count; i++, dst += Stride())
+        {
+            const Vertex &v = vertices[i];
+            if (Mask & VERTEX_POSITION)
+                memcpy(dst + Offset(VERTEX_POSITION), &v.Position, sizeof(glm::vec3));
+            if (Mask & VERTEX_NORMAL)
+                memcpy(dst + Offset(VERTEX_NORMAL), &v.Normal, sizeof(glm::vec3));
+            if (Mask & VERTEX_TEXCOORDS)
+                memcpy(dst + Offset(VERTEX_TEXCOORDS), &v.TexCoords, sizeof(glm::vec2));
+            if (Mask & VERTEX_TANGENT)
+                memcpy(dst + Offset(VERTEX_TANGENT), &v.Tangent, sizeof(glm::vec3));
+            if (Mask & VERTEX_BITANGENT)
+                memcpy(dst + Offset(VERTEX_BITANGENT), &v.Bitangent, sizeof(glm::vec3));
+            if (Mask & VERTEX_BONES)
+            {
+                memcpy(dst + Offset(VERTEX_BONES), v.m_BoneIDs, sizeof(v.m_BoneIDs));
+                memcpy(dst + Offset(VERTEX_BONES) + sizeof(v.m_BoneIDs), v.m_Weights, sizeof(v.m_Weights));
+            }
+        }
+    }
+
+    // 현재 바인딩된 VAO/VBO에 attribute pointer 설정
+    static void SetupAttributes()
+    {
+        if (Mask & VERTEX_POSITION)
+            floatAttribute(0, 3, Offset(VERTEX_POSITION));
+        if (Mask & VERTEX_NORMAL)
+            floatAttribute(1, 3, Offset(VERTEX_NORMAL));
+        if (Mask & VERTEX_TEXCOORDS)
+            floatAttribute(2, 2, Offset(VERTEX_TEXCOORDS));
+        if (Mask & VERTEX_TANGENT)
+            floatAttribute(3, 3, Offset(VERTEX_TANGENT));
+        if (Mask & VERTEX_BITANGENT)
+            floatAttribute(4, 3, Offset(VERTEX_BITANGENT));
+        if (Mask & VERTEX_BONES)
+        {
+            glEnableVertexAttribArray(5);
+            glVertexAttribIPointer(5, MAX_BONE_INFLUENCE, GL_INT, Stride(), (void*)(size_t)Offset(VERTEX_BONES));
+            floatAttribute(6, MAX_BONE_INFLUENCE, Offset(VERTEX_BONES) + MAX_BONE_INFLUENCE * sizeof(int));
+        }
+    }
+
+private:
+    static void floatAttribute(unsigned int location, int size, unsigned int offset)
+    {
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, Stride(), (void*)(size_t)offset);
+    }
+};
+
+static_assert(VertexLayout<VERTEX_LAYOUT_FULL>::Stride() == sizeof(Vertex), "full layout must match Vertex");
+
+// 런타임 mask -> 컴파일 타임 layout 함수
+struct VertexLayoutOps
+{
+    unsigned int stride;
+    void (*pack)(const Vertex *vertices, size_t count, unsigned char *dst);
+    void (*setupAttributes)();
+};
+
+template <size_t... Masks>
+const VertexLayoutOps *VertexLayoutTable(std::index_sequence<Masks...>)
+{
+    static const VertexLayoutOps table[] = {
+        { VertexLayout<Masks>::Stride(), &VertexLayout<Masks>::Pack, &VertexLayout<Masks>::SetupAttributes }...
+    };
+    return table;
+}
+inline const VertexLayoutOps &GetVertexLayout(unsigned int mask)
+{
+    return VertexLayoutTable(std::make_index_sequence<VERTEX_LAYOUT_COUNT>())[mask & VERTEX_LAYOUT_FULL];
+}
+
+#endif